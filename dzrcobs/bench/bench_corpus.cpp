@@ -0,0 +1,264 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_corpus.cpp
+///	@brief Synthetic corpus of typical serial link traffic
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "bench_corpus.h"
+#include <cstdio>
+#include <random>
+#include "bench_data.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_BLOCK_MESSAGE_SIZE ( 64 )
+
+typedef void ( *tBENCH_message_generator )( std::mt19937 &aRng, size_t aIndex, std::vector<uint8_t> &aData );
+
+static const char *const s_BENCH_CorpusNames[BENCH_CORPUS_N] = {
+	"sensor", "text_log", "nmea", "can", "random", "zeros",
+};
+
+static const char *const s_BENCH_LogLevels[] = { "INFO", "DEBUG", "WARN ", "ERROR" };
+
+static const uint32_t s_BENCH_CanIds[] = { 0x0C4, 0x0C8, 0x1A0, 0x1A4, 0x2F0, 0x3E8, 0x701, 0x18FEF100 };
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static void bench_put_u16( std::vector<uint8_t> &aData, uint16_t aValue )
+{
+	aData.push_back( (uint8_t)( aValue & 0xFF ) );
+	aData.push_back( (uint8_t)( aValue >> 8 ) );
+}
+
+static void bench_put_u32( std::vector<uint8_t> &aData, uint32_t aValue )
+{
+	bench_put_u16( aData, (uint16_t)( aValue & 0xFFFF ) );
+	bench_put_u16( aData, (uint16_t)( aValue >> 16 ) );
+}
+
+static void bench_put_text( std::vector<uint8_t> &aData, const char *aText, int aTextLen )
+{
+	if( aTextLen > 0 )
+	{
+		aData.insert( aData.end(), aText, aText + aTextLen );
+	}
+}
+
+// Little endian packed struct:
+// uint32 timestamp_ms, uint16 id, int16 temperature (0.01 C), uint16 humidity (0.1 %),
+// int16 accel[3] (mg), uint8 status, uint8 reserved[3], uint32 error_flags
+static void bench_sensor_message( std::mt19937 &aRng, size_t aIndex, std::vector<uint8_t> &aData )
+{
+	bench_put_u32( aData, (uint32_t)( aIndex * 10 ) );
+	bench_put_u16( aData, (uint16_t)( 1 + ( aIndex % 8 ) ) );
+	bench_put_u16( aData, (uint16_t)( 2000 + ( aRng() % 1000 ) ) );
+	bench_put_u16( aData, (uint16_t)( aRng() % 1000 ) );
+
+	for( size_t i = 0; i < 3; i++ )
+	{
+		// Around 0, and 1 g on the last axis
+		const int32_t accel = (int32_t)( aRng() % 64 ) - 32 + ( ( i == 2 ) ? 1000 : 0 );
+
+		bench_put_u16( aData, (uint16_t)accel );
+	}
+
+	aData.push_back( ( ( aRng() % 16 ) == 0 ) ? (uint8_t)( 1 << ( aRng() % 8 ) ) : 0 );
+	aData.insert( aData.end(), 3, 0 );
+	bench_put_u32( aData, ( ( aRng() % 64 ) == 0 ) ? ( 1u << ( aRng() % 32 ) ) : 0 );
+}
+
+static void bench_text_log_message( std::mt19937 &aRng, size_t aIndex, std::vector<uint8_t> &aData )
+{
+	char line[128];
+	int lineLen = snprintf( line,
+													sizeof( line ),
+													"[%010u] %s ",
+													(unsigned)( aIndex * 37 ),
+													s_BENCH_LogLevels[aRng() % ( sizeof( s_BENCH_LogLevels ) / sizeof( s_BENCH_LogLevels[0] ) )] );
+
+	bench_put_text( aData, line, lineLen );
+
+	const unsigned id		 = (unsigned)( aRng() % 16 );
+	const unsigned value = (unsigned)( aRng() % 1000 );
+
+	switch( aRng() % 4 )
+	{
+	case 0:
+		lineLen = snprintf( line, sizeof( line ), "sensor %u: temperature = %u.%u C", id, value / 10, value % 10 );
+		break;
+	case 1:
+		lineLen = snprintf( line, sizeof( line ), "connection %u: timeout, retrying", id );
+		break;
+	case 2:
+		lineLen = snprintf( line, sizeof( line ), "station %u: reading value = %u", id, value );
+		break;
+	default:
+		lineLen = snprintf( line, sizeof( line ), "the sensor %u is not responding (%u)", id, value % 8 );
+		break;
+	}
+
+	bench_put_text( aData, line, lineLen );
+	bench_put_text( aData, "\r\n", 2 );
+}
+
+static void bench_nmea_message( std::mt19937 &aRng, size_t aIndex, std::vector<uint8_t> &aData )
+{
+	char sentence[128];
+	const unsigned seconds = (unsigned)( 43200 + aIndex );
+	const unsigned hhmmss	 = ( ( seconds / 3600 ) * 10000 ) + ( ( ( seconds / 60 ) % 60 ) * 100 ) + ( seconds % 60 );
+	const unsigned latMin	 = 3856 + (unsigned)( aRng() % 8 );
+	const unsigned lonMin	 = 920 + (unsigned)( aRng() % 8 );
+	int sentenceLen;
+
+	if( ( aIndex % 2 ) == 0 )
+	{
+		sentenceLen = snprintf( sentence,
+														sizeof( sentence ),
+														"$GPGGA,%06u.00,40%02u.%05u,N,008%02u.%05u,W,1,%02u,0.%u,%u.%u,M,50.9,M,,",
+														hhmmss,
+														latMin / 100,
+														(unsigned)( aRng() % 100000 ),
+														lonMin / 100,
+														(unsigned)( aRng() % 100000 ),
+														(unsigned)( 6 + ( aRng() % 6 ) ),
+														(unsigned)( 8 + ( aRng() % 2 ) ),
+														(unsigned)( 20 + ( aRng() % 10 ) ),
+														(unsigned)( aRng() % 10 ) );
+	}
+	else
+	{
+		sentenceLen = snprintf( sentence,
+														sizeof( sentence ),
+														"$GPRMC,%06u.00,A,40%02u.%05u,N,008%02u.%05u,W,0.%03u,%u.%02u,170625,,,A",
+														hhmmss,
+														latMin / 100,
+														(unsigned)( aRng() % 100000 ),
+														lonMin / 100,
+														(unsigned)( aRng() % 100000 ),
+														(unsigned)( aRng() % 1000 ),
+														(unsigned)( aRng() % 360 ),
+														(unsigned)( aRng() % 100 ) );
+	}
+
+	// Checksum is the XOR of the chars between '$' and '*'
+	uint8_t checksum = 0;
+
+	for( int i = 1; i < sentenceLen; i++ )
+	{
+		checksum ^= (uint8_t)sentence[i];
+	}
+
+	bench_put_text( aData, sentence, sentenceLen );
+
+	sentenceLen = snprintf( sentence, sizeof( sentence ), "*%02X\r\n", checksum );
+
+	bench_put_text( aData, sentence, sentenceLen );
+}
+
+// Like struct can_frame: uint32 can_id, uint8 dlc, uint8 pad[3], uint8 data[8]
+static void bench_can_message( std::mt19937 &aRng, size_t aIndex, std::vector<uint8_t> &aData )
+{
+	const uint32_t canId = s_BENCH_CanIds[aRng() % ( sizeof( s_BENCH_CanIds ) / sizeof( s_BENCH_CanIds[0] ) )];
+	const uint8_t dlc		 = ( ( aIndex % 4 ) == 0 ) ? (uint8_t)( aRng() % 9 ) : 8;
+
+	// Extended frame flag, as on SocketCAN
+	bench_put_u32( aData, ( canId > 0x7FF ) ? ( canId | 0x80000000u ) : canId );
+	aData.push_back( dlc );
+	aData.insert( aData.end(), 3, 0 );
+
+	for( uint8_t i = 0; i < 8; i++ )
+	{
+		// Signals use only some of the bits
+		aData.push_back( ( i < dlc ) ? (uint8_t)( aRng() & ( ( i % 2 ) ? 0x0F : 0xFF ) ) : 0 );
+	}
+}
+
+static void bench_random_message( std::mt19937 &aRng, size_t aIndex, std::vector<uint8_t> &aData )
+{
+	(void)aIndex;
+
+	for( size_t i = 0; i < BENCH_BLOCK_MESSAGE_SIZE; i++ )
+	{
+		aData.push_back( (uint8_t)aRng() );
+	}
+}
+
+static void bench_zeros_message( std::mt19937 &aRng, size_t aIndex, std::vector<uint8_t> &aData )
+{
+	(void)aRng;
+	(void)aIndex;
+
+	aData.insert( aData.end(), BENCH_BLOCK_MESSAGE_SIZE, 0 );
+}
+
+static const tBENCH_message_generator s_BENCH_Generators[BENCH_CORPUS_N] = {
+	bench_sensor_message, bench_text_log_message, bench_nmea_message,
+	bench_can_message,		bench_random_message,		bench_zeros_message,
+};
+
+static sBENCH_corpus bench_generate_corpus( eBENCH_corpus aCorpus )
+{
+	std::mt19937 rng( BENCH_SEED + (uint32_t)aCorpus );
+	std::vector<size_t> messageEnds;
+	sBENCH_corpus corpus;
+
+	corpus.data.reserve( BENCH_CORPUS_SIZE + 256 );
+
+	while( corpus.data.size() < BENCH_CORPUS_SIZE )
+	{
+		s_BENCH_Generators[aCorpus]( rng, messageEnds.size(), corpus.data );
+		messageEnds.push_back( corpus.data.size() );
+	}
+
+	// Only now, as the data does not move anymore
+	size_t start = 0;
+
+	for( const size_t end : messageEnds )
+	{
+		corpus.messages.push_back( { corpus.data.data() + start, end - start, BENCH_CORPUS_USER6BITS } );
+		start = end;
+	}
+
+	return corpus;
+}
+
+const char *bench_corpus_name( eBENCH_corpus aCorpus )
+{
+	return s_BENCH_CorpusNames[aCorpus];
+}
+
+const sBENCH_corpus &bench_corpus( eBENCH_corpus aCorpus )
+{
+	static const std::vector<sBENCH_corpus> corpora = [] {
+		std::vector<sBENCH_corpus> all;
+
+		all.reserve( BENCH_CORPUS_N );
+
+		for( int i = 0; i < BENCH_CORPUS_N; i++ )
+		{
+			all.push_back( bench_generate_corpus( (eBENCH_corpus)i ) );
+		}
+
+		return all;
+	}();
+
+	return corpora[aCorpus];
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,64 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_corpus.h
+///	@brief Synthetic corpus of typical serial link traffic
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _BENCH_CORPUS_H_
+#define _BENCH_CORPUS_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <dzrcobs/dzrcobs.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Bytes of messages on each corpus (the last message may pass it)
+#define BENCH_CORPUS_SIZE ( 64 * 1024 )
+
+#define BENCH_CORPUS_USER6BITS ( 0x15 )
+
+typedef enum e_BENCH_corpus
+{
+	BENCH_CORPUS_SENSOR = 0, ///< Packed sensor structs, sparse zeros
+	BENCH_CORPUS_TEXT_LOG,	 ///< CRLF terminated text log lines
+	BENCH_CORPUS_NMEA,			 ///< NMEA 0183 GGA and RMC sentences
+	BENCH_CORPUS_CAN,				 ///< SocketCAN like CAN frames
+	BENCH_CORPUS_RANDOM,		 ///< Uniform random bytes
+	BENCH_CORPUS_ZEROS,			 ///< All bytes zero
+	BENCH_CORPUS_N
+} eBENCH_corpus;
+
+/// Messages of a corpus, each one is sent as a frame
+typedef struct s_BENCH_corpus
+{
+	std::vector<uint8_t> data;											///< All the messages, back to back
+	std::vector<sDZRCOBS_batch_entry> messages; ///< Each message, pointing to data
+} sBENCH_corpus;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Short name of the corpus, for the reports
+const char *bench_corpus_name( eBENCH_corpus aCorpus );
+
+/// Corpus data, generated on the first call with BENCH_SEED
+const sBENCH_corpus &bench_corpus( eBENCH_corpus aCorpus );
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,68 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_crc.cpp
+///	@brief CRC8 benchmarks, for the backend selected by DZRCOBS_CRC_TABLE
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <benchmark/benchmark.h>
+#include "bench_data.h"
+#include "bench_perf.h"
+#include "crc8.h"
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static void BM_crc8_block( benchmark::State &aState )
+{
+	const size_t frameSize = (size_t)aState.range( 0 );
+	const uint8_t *pSrc		 = bench_binary_data().data();
+
+	cBENCH_perf_scope perf( aState, frameSize );
+
+	for( auto _ : aState )
+	{
+		benchmark::DoNotOptimize( DZRCOBS_CRC_BLOCK( DZRCOBS_CRC_INIT_VAL, pSrc, frameSize ) );
+	}
+
+	bench_set_frame_counters( aState, frameSize );
+}
+BENCHMARK( BM_crc8_block )->Apply( bench_frame_sizes );
+
+// Byte at a time, as the encoder does while it writes
+static void BM_crc8_bytewise( benchmark::State &aState )
+{
+	const size_t frameSize = (size_t)aState.range( 0 );
+	const uint8_t *pSrc		 = bench_binary_data().data();
+
+	cBENCH_perf_scope perf( aState, frameSize );
+
+	for( auto _ : aState )
+	{
+		uint8_t crc = DZRCOBS_CRC_INIT_VAL;
+
+		for( size_t i = 0; i < frameSize; i++ )
+		{
+			crc = DZRCOBS_CRC( crc, pSrc[i] );
+		}
+
+		benchmark::DoNotOptimize( crc );
+	}
+
+	bench_set_frame_counters( aState, frameSize );
+}
+BENCHMARK( BM_crc8_bytewise )->Apply( bench_frame_sizes );
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
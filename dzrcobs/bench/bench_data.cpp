@@ -0,0 +1,151 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_data.cpp
+///	@brief Input data and dictionaries shared by the benchmarks
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "bench_data.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+/// Common words of text logs, sorted by size and then by value
+static const char s_BENCH_TextDictionary[] =
+	DICT_ADD_WORD(2, "\r\n")
+	DICT_ADD_WORD(2, ", ")
+	DICT_ADD_WORD(2, ": ")
+	DICT_ADD_WORD(2, "e ")
+	DICT_ADD_WORD(2, "s ")
+	DICT_ADD_WORD(2, "th")
+	DICT_ADD_WORD(3, " = ")
+	DICT_ADD_WORD(3, "ing")
+	DICT_ADD_WORD(3, "the")
+	DICT_ADD_WORD(4, " the")
+	DICT_ADD_WORD(4, "INFO")
+	DICT_ADD_WORD(4, "tion")
+	DICT_ADD_WORD(5, "DEBUG")
+	DICT_ADD_WORD(5, "WARN ")
+	DICT_ADD_WORD(5, "value")
+;
+// NOLINTEND
+// clang-format on
+
+static const char *const s_BENCH_TextWords[] = {
+	"INFO ", "DEBUG ", "WARN ", "the ", "value", " = ", "station", "ing ", "sensor", ", ", ": ", "temperature ",
+	"reading ", "connection ", "timeout", "\r\n",
+};
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static sDICT_ctx bench_init_dictionary( const char *aDictionary, size_t aDictionarySize )
+{
+	sDICT_ctx ctx;
+
+	if( dzrcobs_dictionary_init( &ctx, aDictionary, aDictionarySize ) != DICT_RET_SUCCESS )
+	{
+		fprintf( stderr, "Invalid benchmark dictionary\n" );
+		abort();
+	}
+
+	return ctx;
+}
+
+const std::vector<uint8_t> &bench_binary_data()
+{
+	static const std::vector<uint8_t> data = [] {
+		std::mt19937 rng( BENCH_SEED );
+		std::vector<uint8_t> binary( BENCH_MAX_FRAME_SIZE );
+
+		for( auto &byte : binary )
+		{
+			const uint32_t kind = rng() % 8;
+
+			// Half zeros, some small values, the rest random
+			byte = ( kind < 4 ) ? 0x00 : ( kind < 6 ) ? (uint8_t)( rng() % 4 ) : (uint8_t)rng();
+		}
+
+		return binary;
+	}();
+
+	return data;
+}
+
+const std::vector<uint8_t> &bench_text_data()
+{
+	static const std::vector<uint8_t> data = [] {
+		std::mt19937 rng( BENCH_SEED );
+		std::vector<uint8_t> text;
+
+		text.reserve( BENCH_MAX_FRAME_SIZE );
+
+		while( text.size() < BENCH_MAX_FRAME_SIZE )
+		{
+			const char *pWord = s_BENCH_TextWords[rng() % ( sizeof( s_BENCH_TextWords ) / sizeof( s_BENCH_TextWords[0] ) )];
+
+			for( ; ( *pWord != '\0' ) && ( text.size() < BENCH_MAX_FRAME_SIZE ); pWord++ )
+			{
+				text.push_back( (uint8_t)*pWord );
+			}
+
+			// Some numbers in between
+			if( ( rng() % 4 ) == 0 )
+			{
+				text.push_back( (uint8_t)( '0' + ( rng() % 10 ) ) );
+			}
+		}
+
+		text.resize( BENCH_MAX_FRAME_SIZE );
+
+		return text;
+	}();
+
+	return data;
+}
+
+const sDICT_ctx *bench_binary_dictionary()
+{
+	static const sDICT_ctx ctx = bench_init_dictionary( G_DZRCOBS_DefaultDictionary, G_DZRCOBS_DefaultDictionary_size );
+
+	return &ctx;
+}
+
+const sDICT_ctx *bench_text_dictionary()
+{
+	static const sDICT_ctx ctx = bench_init_dictionary( s_BENCH_TextDictionary, sizeof( s_BENCH_TextDictionary ) );
+
+	return &ctx;
+}
+
+void bench_frame_sizes( benchmark::internal::Benchmark *aBench )
+{
+	aBench->RangeMultiplier( BENCH_FRAME_SIZE_MULTIPLIER )
+	 ->Range( BENCH_MIN_FRAME_SIZE, BENCH_MAX_FRAME_SIZE )
+	 ->Unit( benchmark::kNanosecond );
+}
+
+void bench_set_frame_counters( benchmark::State &aState, size_t aFrameSize )
+{
+	aState.SetBytesProcessed( (int64_t)( aState.iterations() * aFrameSize ) );
+	aState.counters["frames_per_second"] = benchmark::Counter( (double)aState.iterations(), benchmark::Counter::kIsRate );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
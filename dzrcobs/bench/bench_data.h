@@ -0,0 +1,89 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_data.h
+///	@brief Input data and dictionaries shared by the benchmarks
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _BENCH_DATA_H_
+#define _BENCH_DATA_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <dzrcobs/dzrcobs_dictionary.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Fixed seed, so all the runs (and builds) see the same data
+#define BENCH_SEED ( 0x5EED )
+
+#define BENCH_MIN_FRAME_SIZE ( 8 )
+#define BENCH_MAX_FRAME_SIZE ( 64 * 1024 )
+#define BENCH_FRAME_SIZE_MULTIPLIER ( 8 )
+
+// The speed of the report tools is measured for at least this time, and this number of runs
+#define BENCH_SPEED_MIN_TIME_S ( 0.1 )
+#define BENCH_SPEED_MIN_RUNS ( 3 )
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Binary telemetry like data, with runs of zeros and small values (BENCH_MAX_FRAME_SIZE bytes)
+const std::vector<uint8_t> &bench_binary_data();
+
+/// Text log like data, without zeros (BENCH_MAX_FRAME_SIZE bytes)
+const std::vector<uint8_t> &bench_text_data();
+
+/// Default dictionary, for the binary data
+const sDICT_ctx *bench_binary_dictionary();
+
+/// Dictionary of common log words, for the text data
+const sDICT_ctx *bench_text_dictionary();
+
+/// Frame sizes from 8 B to 64 KiB, use with ->Apply( bench_frame_sizes ).
+/// Each iteration handles one frame, so the reported time is per frame, and
+/// bytes_per_second the throughput.
+void bench_frame_sizes( benchmark::internal::Benchmark *aBench );
+
+/// Sets the throughput of a benchmark that handles aFrameSize bytes per iteration
+void bench_set_frame_counters( benchmark::State &aState, size_t aFrameSize );
+
+/// Runs aFunction, that handles aBytes each run, at least
+/// BENCH_SPEED_MIN_TIME_S and returns its MB/s. For the report tools.
+template <typename T>
+double bench_speed_mbps( size_t aBytes, T aFunction )
+{
+	using clock = std::chrono::steady_clock;
+
+	const clock::time_point start = clock::now();
+	double elapsed								= 0.0;
+	size_t runs										= 0;
+
+	while( ( runs < BENCH_SPEED_MIN_RUNS ) || ( elapsed < BENCH_SPEED_MIN_TIME_S ) )
+	{
+		aFunction();
+		runs++;
+		elapsed = std::chrono::duration<double>( clock::now() - start ).count();
+	}
+
+	return ( (double)aBytes * (double)runs ) / ( elapsed * 1e6 );
+}
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
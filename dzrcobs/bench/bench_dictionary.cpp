@@ -0,0 +1,70 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_dictionary.cpp
+///	@brief Dictionary search benchmarks
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <dzrcobs/dzrcobs_dictionary.h>
+#include "bench_data.h"
+#include "bench_perf.h"
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+// Searches a word at every position of the frame, as the encoder worst case
+static void bench_dictionary_search( benchmark::State &aState,
+																		 const sDICT_ctx *aDict,
+																		 const std::vector<uint8_t> &aData )
+{
+	const size_t frameSize = (size_t)aState.range( 0 );
+	const uint8_t *pSrc		 = aData.data();
+
+	size_t found = 0;
+
+	cBENCH_perf_scope perf( aState, frameSize );
+
+	for( auto _ : aState )
+	{
+		for( size_t i = 0; i < frameSize; i++ )
+		{
+			size_t keySizeFound = 0;
+
+			found += dzrcobs_dictionary_search( aDict, pSrc + i, frameSize - i, &keySizeFound ) != 0;
+		}
+
+		benchmark::DoNotOptimize( found );
+	}
+
+	bench_set_frame_counters( aState, frameSize );
+	aState.counters["hit_ratio"] =
+	 benchmark::Counter( (double)found / (double)frameSize, benchmark::Counter::kAvgIterations );
+}
+
+static void BM_dzrcobs_dictionary_search_binary( benchmark::State &aState )
+{
+	bench_dictionary_search( aState, bench_binary_dictionary(), bench_binary_data() );
+}
+BENCHMARK( BM_dzrcobs_dictionary_search_binary )->Apply( bench_frame_sizes );
+
+static void BM_dzrcobs_dictionary_search_text( benchmark::State &aState )
+{
+	bench_dictionary_search( aState, bench_text_dictionary(), bench_text_data() );
+}
+BENCHMARK( BM_dzrcobs_dictionary_search_text )->Apply( bench_frame_sizes );
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,240 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_dzrcobs.cpp
+///	@brief dzrcobs encode and decode benchmarks
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_decode.h>
+#include "bench_data.h"
+#include "bench_perf.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define BENCH_USER6BITS ( 0x2A )
+
+// Frame size of the chunked encoding benchmark
+#define BENCH_CHUNKED_FRAME_SIZE ( 4096 )
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+// Plain and DICT_1 encode the binary data (DICT_1 with the default dictionary),
+// DICT_2 encodes the text data with the text dictionary
+static const std::vector<uint8_t> &bench_data_for( eDZRCOBS_encoding aEncoding )
+{
+	return ( aEncoding == DZRCOBS_USING_DICT_2 ) ? bench_text_data() : bench_binary_data();
+}
+
+static void bench_set_dictionaries( const sDICT_ctx **aDicts )
+{
+	aDicts[0] = bench_binary_dictionary();
+	aDicts[1] = bench_text_dictionary();
+}
+
+static size_t bench_dzrcobs_encode( eDZRCOBS_encoding aEncoding,
+																		const uint8_t *aSrc,
+																		size_t aSrcSize,
+																		size_t aChunkSize,
+																		std::vector<uint8_t> &aDst,
+																		eDZRCOBS_parsing aParsing = DZRCOBS_PARSING_GREEDY )
+{
+	sDZRCOBS_ctx ctx;
+	size_t encodedSize = 0;
+
+	bench_set_dictionaries( ctx.pDict );
+	ctx.user6bits = BENCH_USER6BITS;
+
+	dzrcobs_encode_inc_begin( &ctx, aEncoding, aDst.data(), aDst.size() );
+	dzrcobs_encode_set_parsing( &ctx, aParsing );
+
+	for( size_t pos = 0; pos < aSrcSize; pos += aChunkSize )
+	{
+		const size_t chunkSize = ( ( aSrcSize - pos ) < aChunkSize ) ? ( aSrcSize - pos ) : aChunkSize;
+
+		dzrcobs_encode_inc( &ctx, aSrc + pos, chunkSize );
+	}
+
+	if( dzrcobs_encode_inc_end( &ctx, &encodedSize ) != DZRCOBS_RET_SUCCESS )
+	{
+		return 0;
+	}
+
+	return encodedSize;
+}
+
+static void BM_dzrcobs_encode_inc( benchmark::State &aState,
+																	 eDZRCOBS_encoding aEncoding,
+																	 eDZRCOBS_parsing aParsing = DZRCOBS_PARSING_GREEDY )
+{
+	const size_t frameSize = (size_t)aState.range( 0 );
+	const uint8_t *pSrc		 = bench_data_for( aEncoding ).data();
+
+	std::vector<uint8_t> dst( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( frameSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+	size_t encodedSize = 0;
+
+	cBENCH_perf_scope perf( aState, frameSize );
+
+	for( auto _ : aState )
+	{
+		encodedSize = bench_dzrcobs_encode( aEncoding, pSrc, frameSize, frameSize, dst, aParsing );
+
+		if( encodedSize == 0 )
+		{
+			aState.SkipWithError( "dzrcobs_encode_inc failed" );
+			break;
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	bench_set_frame_counters( aState, frameSize );
+	aState.counters["ratio"] = (double)encodedSize / (double)frameSize;
+}
+BENCHMARK_CAPTURE( BM_dzrcobs_encode_inc, plain, DZRCOBS_PLAIN )->Apply( bench_frame_sizes );
+BENCHMARK_CAPTURE( BM_dzrcobs_encode_inc, dict_1, DZRCOBS_USING_DICT_1 )->Apply( bench_frame_sizes );
+BENCHMARK_CAPTURE( BM_dzrcobs_encode_inc, dict_2, DZRCOBS_USING_DICT_2 )->Apply( bench_frame_sizes );
+BENCHMARK_CAPTURE( BM_dzrcobs_encode_inc, dict_1_optimal, DZRCOBS_USING_DICT_1, DZRCOBS_PARSING_OPTIMAL )
+ ->Apply( bench_frame_sizes );
+BENCHMARK_CAPTURE( BM_dzrcobs_encode_inc, dict_2_optimal, DZRCOBS_USING_DICT_2, DZRCOBS_PARSING_OPTIMAL )
+ ->Apply( bench_frame_sizes );
+
+// Same frame fed on chunks of different sizes, the ratio must not change with it
+static void BM_dzrcobs_encode_inc_chunked( benchmark::State &aState, eDZRCOBS_encoding aEncoding )
+{
+	const size_t chunkSize = (size_t)aState.range( 0 );
+	const uint8_t *pSrc		 = bench_data_for( aEncoding ).data();
+
+	std::vector<uint8_t> dst( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( BENCH_CHUNKED_FRAME_SIZE ) +
+														DZRCOBS_FRAME_HEADER_SIZE );
+
+	size_t encodedSize = 0;
+
+	cBENCH_perf_scope perf( aState, BENCH_CHUNKED_FRAME_SIZE );
+
+	for( auto _ : aState )
+	{
+		encodedSize = bench_dzrcobs_encode( aEncoding, pSrc, BENCH_CHUNKED_FRAME_SIZE, chunkSize, dst );
+
+		if( encodedSize == 0 )
+		{
+			aState.SkipWithError( "dzrcobs_encode_inc failed" );
+			break;
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	bench_set_frame_counters( aState, BENCH_CHUNKED_FRAME_SIZE );
+	aState.counters["ratio"] = (double)encodedSize / (double)BENCH_CHUNKED_FRAME_SIZE;
+}
+BENCHMARK_CAPTURE( BM_dzrcobs_encode_inc_chunked, dict_1, DZRCOBS_USING_DICT_1 )
+ ->Arg( 1 )
+ ->Arg( 7 )
+ ->Arg( 64 )
+ ->Arg( 1024 )
+ ->Arg( BENCH_CHUNKED_FRAME_SIZE )
+ ->Unit( benchmark::kNanosecond );
+BENCHMARK_CAPTURE( BM_dzrcobs_encode_inc_chunked, dict_2, DZRCOBS_USING_DICT_2 )
+ ->Arg( 1 )
+ ->Arg( 7 )
+ ->Arg( 64 )
+ ->Arg( 1024 )
+ ->Arg( BENCH_CHUNKED_FRAME_SIZE )
+ ->Unit( benchmark::kNanosecond );
+
+// dzrcobs_encode_auto with both dictionaries, on the data of aDataEncoding.
+// Counts the sizes of the three encodings and writes the smallest one.
+static void BM_dzrcobs_encode_auto( benchmark::State &aState, eDZRCOBS_encoding aDataEncoding )
+{
+	const size_t frameSize = (size_t)aState.range( 0 );
+	const uint8_t *pSrc		 = bench_data_for( aDataEncoding ).data();
+
+	std::vector<uint8_t> dst( DZRCOBS_MAX_ENCODED_SIZE( frameSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+	sDZRCOBS_ctx ctx;
+	bench_set_dictionaries( ctx.pDict );
+	ctx.user6bits = BENCH_USER6BITS;
+
+	size_t encodedSize					= 0;
+	eDZRCOBS_encoding encoding = DZRCOBS_PLAIN;
+
+	cBENCH_perf_scope perf( aState, frameSize );
+
+	for( auto _ : aState )
+	{
+		if( dzrcobs_encode_auto( &ctx, pSrc, frameSize, dst.data(), dst.size(), &encodedSize, &encoding ) !=
+				DZRCOBS_RET_SUCCESS )
+		{
+			aState.SkipWithError( "dzrcobs_encode_auto failed" );
+			break;
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	bench_set_frame_counters( aState, frameSize );
+	aState.counters["ratio"]		= (double)encodedSize / (double)frameSize;
+	aState.counters["encoding"] = (double)encoding;
+}
+BENCHMARK_CAPTURE( BM_dzrcobs_encode_auto, binary, DZRCOBS_USING_DICT_1 )->Apply( bench_frame_sizes );
+BENCHMARK_CAPTURE( BM_dzrcobs_encode_auto, text, DZRCOBS_USING_DICT_2 )->Apply( bench_frame_sizes );
+
+static void BM_dzrcobs_decode( benchmark::State &aState, eDZRCOBS_encoding aEncoding )
+{
+	const size_t frameSize = (size_t)aState.range( 0 );
+
+	std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( frameSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+	std::vector<uint8_t> decoded( frameSize );
+
+	const size_t encodedSize = bench_dzrcobs_encode( aEncoding, bench_data_for( aEncoding ).data(), frameSize, frameSize, encoded );
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= encoded.data();
+	decodeCtx.srcBufEncodedLen	= encodedSize;
+	decodeCtx.dstBufDecoded			= decoded.data();
+	decodeCtx.dstBufDecodedSize = decoded.size();
+	bench_set_dictionaries( decodeCtx.pDict );
+
+	cBENCH_perf_scope perf( aState, frameSize );
+
+	for( auto _ : aState )
+	{
+		size_t decodedLen			= 0;
+		uint8_t *pDecodedStart = nullptr;
+		uint8_t user6bits			 = 0;
+
+		if( dzrcobs_decode( &decodeCtx, &decodedLen, &pDecodedStart, &user6bits ) != DZRCOBS_RET_SUCCESS )
+		{
+			aState.SkipWithError( "dzrcobs_decode failed" );
+			break;
+		}
+
+		benchmark::DoNotOptimize( pDecodedStart );
+		benchmark::ClobberMemory();
+	}
+
+	bench_set_frame_counters( aState, frameSize );
+}
+BENCHMARK_CAPTURE( BM_dzrcobs_decode, plain, DZRCOBS_PLAIN )->Apply( bench_frame_sizes );
+BENCHMARK_CAPTURE( BM_dzrcobs_decode, dict_1, DZRCOBS_USING_DICT_1 )->Apply( bench_frame_sizes );
+BENCHMARK_CAPTURE( BM_dzrcobs_decode, dict_2, DZRCOBS_USING_DICT_2 )->Apply( bench_frame_sizes );
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
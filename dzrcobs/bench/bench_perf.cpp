@@ -0,0 +1,214 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_perf.cpp
+///	@brief Hardware performance counters around the benchmark loops
+///
+///	@par  Plataform Target:	Benchmarks (Linux perf_event_open, no-op elsewhere)
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "bench_perf.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#if defined( __linux__ )
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+typedef enum e_BENCH_perf_counter
+{
+	BENCH_PERF_CYCLES = 0,
+	BENCH_PERF_INSTRUCTIONS,
+	BENCH_PERF_BRANCH_MISSES,
+	BENCH_PERF_L1D_MISSES,
+	BENCH_PERF_N
+} eBENCH_perf_counter;
+
+typedef struct s_BENCH_perf_event
+{
+	const char *pName; ///< Prefix of the reported counters
+	uint32_t type;		 ///< perf_event_attr type
+	uint64_t config;	 ///< perf_event_attr config
+	int fd;						 ///< -1 if not available
+	uint64_t id;			 ///< PERF_EVENT_IOC_ID, to find it on the group read
+	double value;			 ///< Last value read
+} sBENCH_perf_event;
+
+#if defined( __linux__ )
+static sBENCH_perf_event s_BENCH_PerfEvents[BENCH_PERF_N] = {
+	{ "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1, 0, 0.0 },
+	{ "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, -1, 0, 0.0 },
+	{ "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, -1, 0, 0.0 },
+	{ "l1d_misses",
+		PERF_TYPE_HW_CACHE,
+		PERF_COUNT_HW_CACHE_L1D | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ),
+		-1,
+		0,
+		0.0 },
+};
+#endif
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+#if defined( __linux__ )
+
+static int bench_perf_leader()
+{
+	return s_BENCH_PerfEvents[BENCH_PERF_CYCLES].fd;
+}
+
+bool bench_perf_enable()
+{
+	for( sBENCH_perf_event &event : s_BENCH_PerfEvents )
+	{
+		struct perf_event_attr attr;
+
+		memset( &attr, 0, sizeof( attr ) );
+		attr.size				 = sizeof( attr );
+		attr.type				 = event.type;
+		attr.config			 = event.config;
+		attr.disabled		 = ( &event == &s_BENCH_PerfEvents[BENCH_PERF_CYCLES] ) ? 1 : 0;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv		 = 1;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// All on the group of the cycles counter, so they count the same code
+		event.fd = (int)syscall( SYS_perf_event_open, &attr, 0, -1, bench_perf_leader(), 0 );
+
+		if( ( event.fd < 0 ) || ( ioctl( event.fd, PERF_EVENT_IOC_ID, &event.id ) != 0 ) )
+		{
+			fprintf( stderr, "%s: %s not available (%s)\n", BENCH_PERF_FLAG, event.pName, strerror( errno ) );
+
+			if( event.fd >= 0 )
+			{
+				close( event.fd );
+				event.fd = -1;
+			}
+
+			if( &event == &s_BENCH_PerfEvents[BENCH_PERF_CYCLES] )
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static void bench_perf_start()
+{
+	ioctl( bench_perf_leader(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP );
+	ioctl( bench_perf_leader(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+}
+
+static bool bench_perf_stop()
+{
+	ioctl( bench_perf_leader(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP );
+
+	// nr, time_enabled, time_running, { value, id }[nr]
+	uint64_t group[3 + ( 2 * BENCH_PERF_N )];
+
+	if( read( bench_perf_leader(), group, sizeof( group ) ) < (ssize_t)( 3 * sizeof( uint64_t ) ) )
+	{
+		return false;
+	}
+
+	// Scaled, if the group was multiplexed with other events
+	const double scale = ( group[2] > 0 ) ? ( (double)group[1] / (double)group[2] ) : 0.0;
+
+	for( uint64_t i = 0; ( i < group[0] ) && ( i < BENCH_PERF_N ); i++ )
+	{
+		for( sBENCH_perf_event &event : s_BENCH_PerfEvents )
+		{
+			if( ( event.fd >= 0 ) && ( event.id == group[3 + ( 2 * i ) + 1] ) )
+			{
+				event.value = (double)group[3 + ( 2 * i )] * scale;
+			}
+		}
+	}
+
+	return true;
+}
+
+cBENCH_perf_scope::cBENCH_perf_scope( benchmark::State &aState, size_t aBytesPerIteration )
+ : m_state( aState ), m_bytesPerIteration( aBytesPerIteration )
+{
+	if( bench_perf_leader() >= 0 )
+	{
+		bench_perf_start();
+	}
+}
+
+cBENCH_perf_scope::~cBENCH_perf_scope()
+{
+	if( ( bench_perf_leader() < 0 ) || !bench_perf_stop() || ( m_state.iterations() == 0 ) )
+	{
+		return;
+	}
+
+	const double frames = (double)m_state.iterations();
+	const double bytes	= frames * (double)m_bytesPerIteration;
+
+	for( const sBENCH_perf_event &event : s_BENCH_PerfEvents )
+	{
+		if( event.fd < 0 )
+		{
+			continue;
+		}
+
+		if( bytes > 0.0 )
+		{
+			m_state.counters[std::string( event.pName ) + "_per_byte"] = event.value / bytes;
+		}
+
+		m_state.counters[std::string( event.pName ) + "_per_frame"] = event.value / frames;
+	}
+
+	const sBENCH_perf_event &cycles				= s_BENCH_PerfEvents[BENCH_PERF_CYCLES];
+	const sBENCH_perf_event &instructions = s_BENCH_PerfEvents[BENCH_PERF_INSTRUCTIONS];
+
+	if( ( instructions.fd >= 0 ) && ( cycles.value > 0.0 ) )
+	{
+		m_state.counters["ipc"] = instructions.value / cycles.value;
+	}
+}
+
+#else
+
+bool bench_perf_enable()
+{
+	fprintf( stderr, "%s: only available on Linux\n", BENCH_PERF_FLAG );
+
+	return false;
+}
+
+cBENCH_perf_scope::cBENCH_perf_scope( benchmark::State &aState, size_t aBytesPerIteration )
+ : m_state( aState ), m_bytesPerIteration( aBytesPerIteration )
+{
+}
+
+cBENCH_perf_scope::~cBENCH_perf_scope() {}
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,68 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_perf.h
+///	@brief Hardware performance counters around the benchmark loops
+///
+///	@par  Plataform Target:	Benchmarks (Linux perf_event_open, no-op elsewhere)
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _BENCH_PERF_H_
+#define _BENCH_PERF_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Command line flag that enables the counters
+#define BENCH_PERF_FLAG "--dzrcobs_perf_counters"
+
+/**
+ * @brief Counts cycles, instructions, branch misses and L1D read misses of
+ *        the benchmark loop, from its construction to its destruction, in
+ *        user space. Create it just before the `for( auto _ : aState )`.
+ *        When done, it adds to aState the counters per input byte
+ *        (cycles_per_byte, ...), per frame (cycles_per_frame, ...) and ipc.
+ *        A frame is an iteration of the loop.
+ *        It does nothing unless bench_perf_enable succeeded.
+ */
+class cBENCH_perf_scope
+{
+public:
+	cBENCH_perf_scope( benchmark::State &aState, size_t aBytesPerIteration );
+	~cBENCH_perf_scope();
+
+	cBENCH_perf_scope( const cBENCH_perf_scope & )						= delete;
+	cBENCH_perf_scope &operator=( const cBENCH_perf_scope & ) = delete;
+
+private:
+	benchmark::State &m_state;
+	size_t m_bytesPerIteration;
+};
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Opens the counters, for the calling thread. The counters that the
+ *        CPU (or the VM, or perf_event_paranoid) does not allow are not
+ *        reported, a warning is printed for each one.
+ *
+ * @return true if at least the cycles counter is available
+ */
+bool bench_perf_enable();
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
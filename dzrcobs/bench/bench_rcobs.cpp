@@ -0,0 +1,101 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file bench_rcobs.cpp
+///	@brief rcobs encode and decode benchmarks
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <dzrcobs/rcobs.h>
+#include "bench_data.h"
+#include "bench_perf.h"
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static size_t bench_rcobs_encode( const uint8_t *aSrc, size_t aSrcSize, std::vector<uint8_t> &aDst )
+{
+	sRCOBS_ctx ctx;
+	size_t encodedSize = 0;
+
+	rcobs_encode_inc_begin( &ctx, aDst.data(), aDst.size() );
+	rcobs_encode_inc( &ctx, aSrc, aSrcSize );
+
+	if( rcobs_encode_inc_end( &ctx, &encodedSize ) != RCOBS_RET_SUCCESS )
+	{
+		return 0;
+	}
+
+	return encodedSize;
+}
+
+static void BM_rcobs_encode_inc( benchmark::State &aState )
+{
+	const size_t frameSize = (size_t)aState.range( 0 );
+	const uint8_t *pSrc		 = bench_binary_data().data();
+
+	std::vector<uint8_t> dst( RCOBS_MAX_ENCODED_SIZE( frameSize ) + 1 );
+
+	cBENCH_perf_scope perf( aState, frameSize );
+
+	for( auto _ : aState )
+	{
+		benchmark::DoNotOptimize( bench_rcobs_encode( pSrc, frameSize, dst ) );
+		benchmark::ClobberMemory();
+	}
+
+	bench_set_frame_counters( aState, frameSize );
+}
+BENCHMARK( BM_rcobs_encode_inc )->Apply( bench_frame_sizes );
+
+static void BM_rcobs_decode( benchmark::State &aState )
+{
+	const size_t frameSize = (size_t)aState.range( 0 );
+
+	std::vector<uint8_t> encoded( RCOBS_MAX_ENCODED_SIZE( frameSize ) + 1 );
+	std::vector<uint8_t> decoded( frameSize );
+
+	size_t encodedSize = bench_rcobs_encode( bench_binary_data().data(), frameSize, encoded );
+
+	// The delimiter is not part of the encoded data
+	if( ( encodedSize > 0 ) && ( encoded[encodedSize - 1] == 0x00 ) )
+	{
+		encodedSize--;
+	}
+
+	cBENCH_perf_scope perf( aState, frameSize );
+
+	for( auto _ : aState )
+	{
+		size_t decodedLen			= 0;
+		uint8_t *pDecodedStart = nullptr;
+
+		if( rcobs_decode( encoded.data(), encodedSize, decoded.data(), decoded.size(), &decodedLen, &pDecodedStart ) !=
+				RCOBS_RET_SUCCESS )
+		{
+			aState.SkipWithError( "rcobs_decode failed" );
+			break;
+		}
+
+		benchmark::DoNotOptimize( pDecodedStart );
+		benchmark::ClobberMemory();
+	}
+
+	bench_set_frame_counters( aState, frameSize );
+}
+BENCHMARK( BM_rcobs_decode )->Apply( bench_frame_sizes );
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
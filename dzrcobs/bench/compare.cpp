@@ -0,0 +1,648 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file compare.cpp
+///	@brief Compares dzrcobs with other framings and compressors on the corpus
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_decode.h>
+#include <dzrcobs/rcobs.h>
+#include <heatshrink_decoder.h>
+#include <heatshrink_encoder.h>
+#include <lz4.h>
+#include "bench_corpus.h"
+#include "bench_data.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Standard COBS (Cheshire and Baker), a code byte each 254 bytes
+#define COMPARE_COBS_MAX_ENCODED_SIZE( size ) ( ( size ) + ( ( size ) / 254 ) + 1 )
+
+// Heatshrink worst case, 9 bits for each literal byte
+#define COMPARE_HEATSHRINK_MAX_SIZE( size ) ( ( size ) + ( ( size ) / 8 ) + 1 )
+
+/**
+ * @brief A framing of a message. The frame does not include the 0x00
+ *        delimiter, that is added on the stream by the caller.
+ *        encode returns the frame size, 0 on error. decode returns the
+ *        decoded size (the data is at aOutDecoded), 0 on error.
+ *        memory is the RAM the codec needs for aMaxMessageSize messages,
+ *        besides the message and frame buffers: contexts, dictionaries
+ *        tables and intermediate buffers (stack not included).
+ */
+typedef struct s_COMPARE_codec
+{
+	const char *pName;
+	size_t ( *encode )( const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize );
+	size_t ( *decode )( const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize, const uint8_t **aOutDecoded );
+	size_t ( *encodeMemory )( size_t aMaxMessageSize );
+	size_t ( *decodeMemory )( size_t aMaxMessageSize );
+	bool hasCrc; ///< The frame checks its integrity
+} sCOMPARE_codec;
+
+typedef struct s_COMPARE_row
+{
+	size_t bytesIn;
+	size_t bytesOut;
+	double encodeMBps;
+	double decodeMBps;
+	size_t encodeMemory;
+	size_t decodeMemory;
+} sCOMPARE_row;
+
+// Intermediate buffer of the compressors, between them and COBS
+static std::vector<uint8_t> s_COMPARE_Scratch;
+
+static LZ4_stream_t s_COMPARE_Lz4State;
+static heatshrink_encoder s_COMPARE_HeatshrinkEncoder;
+static heatshrink_decoder s_COMPARE_HeatshrinkDecoder;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static size_t compare_cobs_encode( const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize )
+{
+	if( aDstSize < COMPARE_COBS_MAX_ENCODED_SIZE( aSrcLen ) )
+	{
+		return 0;
+	}
+
+	uint8_t *pCode = aDst;
+	uint8_t *pDst	 = aDst + 1;
+	uint8_t code	 = 1;
+
+	for( size_t i = 0; i < aSrcLen; i++ )
+	{
+		if( aSrc[i] != 0x00 )
+		{
+			*pDst++ = aSrc[i];
+			code++;
+		}
+
+		if( ( aSrc[i] == 0x00 ) || ( code == 0xFF ) )
+		{
+			*pCode = code;
+			pCode	 = pDst++;
+			code	 = 1;
+		}
+	}
+
+	*pCode = code;
+
+	return (size_t)( pDst - aDst );
+}
+
+static size_t compare_cobs_decode( const uint8_t *aSrc,
+																	 size_t aSrcLen,
+																	 uint8_t *aDst,
+																	 size_t aDstSize,
+																	 const uint8_t **aOutDecoded )
+{
+	size_t readPos	= 0;
+	size_t writePos = 0;
+
+	while( readPos < aSrcLen )
+	{
+		const size_t code = aSrc[readPos++];
+
+		if( ( code == 0 ) || ( ( readPos + code - 1 ) > aSrcLen ) || ( ( writePos + code - 1 ) > aDstSize ) )
+		{
+			return 0;
+		}
+
+		memcpy( aDst + writePos, aSrc + readPos, code - 1 );
+		readPos += code - 1;
+		writePos += code - 1;
+
+		// A full block has no zero after it, neither the last one
+		if( ( code != 0xFF ) && ( readPos < aSrcLen ) )
+		{
+			if( writePos >= aDstSize )
+			{
+				return 0;
+			}
+
+			aDst[writePos++] = 0x00;
+		}
+	}
+
+	*aOutDecoded = aDst;
+
+	return writePos;
+}
+
+static size_t compare_no_memory( size_t aMaxMessageSize )
+{
+	(void)aMaxMessageSize;
+
+	return 0;
+}
+
+static size_t compare_dzrcobs_encode( eDZRCOBS_encoding aEncoding, const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize )
+{
+	sDZRCOBS_ctx ctx;
+	size_t encodedSize = 0;
+
+	ctx.pDict[0]	= bench_binary_dictionary();
+	ctx.pDict[1]	= bench_text_dictionary();
+	ctx.user6bits = BENCH_CORPUS_USER6BITS;
+
+	dzrcobs_encode_inc_begin( &ctx, aEncoding, aDst, aDstSize );
+	dzrcobs_encode_inc( &ctx, aSrc, aSrcLen );
+
+	if( dzrcobs_encode_inc_end( &ctx, &encodedSize ) != DZRCOBS_RET_SUCCESS )
+	{
+		return 0;
+	}
+
+	return encodedSize;
+}
+
+static size_t compare_dzrcobs_plain_encode( const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize )
+{
+	return compare_dzrcobs_encode( DZRCOBS_PLAIN, aSrc, aSrcLen, aDst, aDstSize );
+}
+
+static size_t compare_dzrcobs_dict_1_encode( const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize )
+{
+	return compare_dzrcobs_encode( DZRCOBS_USING_DICT_1, aSrc, aSrcLen, aDst, aDstSize );
+}
+
+static size_t compare_dzrcobs_dict_2_encode( const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize )
+{
+	return compare_dzrcobs_encode( DZRCOBS_USING_DICT_2, aSrc, aSrcLen, aDst, aDstSize );
+}
+
+static size_t compare_dzrcobs_decode( const uint8_t *aSrc,
+																			size_t aSrcLen,
+																			uint8_t *aDst,
+																			size_t aDstSize,
+																			const uint8_t **aOutDecoded )
+{
+	sDZRCOBS_decodectx ctx;
+	ctx.srcBufEncoded			= aSrc;
+	ctx.srcBufEncodedLen	= aSrcLen;
+	ctx.dstBufDecoded			= aDst;
+	ctx.dstBufDecodedSize = aDstSize;
+	ctx.pDict[0]					= bench_binary_dictionary();
+	ctx.pDict[1]					= bench_text_dictionary();
+
+	size_t decodedLen			= 0;
+	uint8_t *pDecodedStart = nullptr;
+	uint8_t user6bits			 = 0;
+
+	if( dzrcobs_decode( &ctx, &decodedLen, &pDecodedStart, &user6bits ) != DZRCOBS_RET_SUCCESS )
+	{
+		return 0;
+	}
+
+	*aOutDecoded = pDecodedStart;
+
+	return decodedLen;
+}
+
+static size_t compare_dzrcobs_plain_encode_memory( size_t aMaxMessageSize )
+{
+	(void)aMaxMessageSize;
+
+	return sizeof( sDZRCOBS_ctx );
+}
+
+static size_t compare_dzrcobs_plain_decode_memory( size_t aMaxMessageSize )
+{
+	(void)aMaxMessageSize;
+
+	return sizeof( sDZRCOBS_decodectx );
+}
+
+// The dictionary words are const (flash), only its context is on RAM
+static size_t compare_dzrcobs_dict_encode_memory( size_t aMaxMessageSize )
+{
+	return compare_dzrcobs_plain_encode_memory( aMaxMessageSize ) + sizeof( sDICT_ctx );
+}
+
+static size_t compare_dzrcobs_dict_decode_memory( size_t aMaxMessageSize )
+{
+	return compare_dzrcobs_plain_decode_memory( aMaxMessageSize ) + sizeof( sDICT_ctx );
+}
+
+static size_t compare_rcobs_encode( const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize )
+{
+	sRCOBS_ctx ctx;
+	size_t encodedSize = 0;
+
+	rcobs_encode_inc_begin( &ctx, aDst, aDstSize );
+	rcobs_encode_inc( &ctx, aSrc, aSrcLen );
+
+	if( rcobs_encode_inc_end( &ctx, &encodedSize ) != RCOBS_RET_SUCCESS )
+	{
+		return 0;
+	}
+
+	return encodedSize;
+}
+
+static size_t compare_rcobs_decode( const uint8_t *aSrc,
+																		size_t aSrcLen,
+																		uint8_t *aDst,
+																		size_t aDstSize,
+																		const uint8_t **aOutDecoded )
+{
+	size_t decodedLen			= 0;
+	uint8_t *pDecodedStart = nullptr;
+
+	if( rcobs_decode( aSrc, aSrcLen, aDst, aDstSize, &decodedLen, &pDecodedStart ) != RCOBS_RET_SUCCESS )
+	{
+		return 0;
+	}
+
+	*aOutDecoded = pDecodedStart;
+
+	return decodedLen;
+}
+
+static size_t compare_rcobs_encode_memory( size_t aMaxMessageSize )
+{
+	(void)aMaxMessageSize;
+
+	return sizeof( sRCOBS_ctx );
+}
+
+static size_t compare_lz4_cobs_encode( const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize )
+{
+	const int compressedLen = LZ4_compress_fast_extState( &s_COMPARE_Lz4State,
+																												(const char *)aSrc,
+																												(char *)s_COMPARE_Scratch.data(),
+																												(int)aSrcLen,
+																												(int)s_COMPARE_Scratch.size(),
+																												1 );
+
+	if( compressedLen <= 0 )
+	{
+		return 0;
+	}
+
+	return compare_cobs_encode( s_COMPARE_Scratch.data(), (size_t)compressedLen, aDst, aDstSize );
+}
+
+static size_t compare_lz4_cobs_decode( const uint8_t *aSrc,
+																			 size_t aSrcLen,
+																			 uint8_t *aDst,
+																			 size_t aDstSize,
+																			 const uint8_t **aOutDecoded )
+{
+	const uint8_t *pCompressed = nullptr;
+	const size_t compressedLen =
+	 compare_cobs_decode( aSrc, aSrcLen, s_COMPARE_Scratch.data(), s_COMPARE_Scratch.size(), &pCompressed );
+
+	if( compressedLen == 0 )
+	{
+		return 0;
+	}
+
+	const int decodedLen = LZ4_decompress_safe( (const char *)pCompressed, (char *)aDst, (int)compressedLen, (int)aDstSize );
+
+	if( decodedLen < 0 )
+	{
+		return 0;
+	}
+
+	*aOutDecoded = aDst;
+
+	return (size_t)decodedLen;
+}
+
+static size_t compare_lz4_cobs_encode_memory( size_t aMaxMessageSize )
+{
+	return sizeof( s_COMPARE_Lz4State ) + (size_t)LZ4_compressBound( (int)aMaxMessageSize );
+}
+
+static size_t compare_lz4_cobs_decode_memory( size_t aMaxMessageSize )
+{
+	return (size_t)LZ4_compressBound( (int)aMaxMessageSize );
+}
+
+static size_t compare_heatshrink_cobs_encode( const uint8_t *aSrc, size_t aSrcLen, uint8_t *aDst, size_t aDstSize )
+{
+	heatshrink_encoder *pEncoder = &s_COMPARE_HeatshrinkEncoder;
+	size_t sunk									 = 0;
+	size_t polled								 = 0;
+
+	heatshrink_encoder_reset( pEncoder );
+
+	for( ;; )
+	{
+		size_t count = 0;
+
+		if( sunk < aSrcLen )
+		{
+			if( heatshrink_encoder_sink( pEncoder, const_cast<uint8_t *>( aSrc + sunk ), aSrcLen - sunk, &count ) < 0 )
+			{
+				return 0;
+			}
+
+			sunk += count;
+		}
+		else if( heatshrink_encoder_finish( pEncoder ) == HSER_FINISH_DONE )
+		{
+			break;
+		}
+
+		HSE_poll_res pollRes;
+
+		do
+		{
+			pollRes = heatshrink_encoder_poll(
+			 pEncoder, s_COMPARE_Scratch.data() + polled, s_COMPARE_Scratch.size() - polled, &count );
+			polled += count;
+		} while( ( pollRes == HSER_POLL_MORE ) && ( count > 0 ) );
+
+		// Output full, while it still has more
+		if( ( pollRes < 0 ) || ( ( pollRes == HSER_POLL_MORE ) && ( count == 0 ) ) )
+		{
+			return 0;
+		}
+	}
+
+	return compare_cobs_encode( s_COMPARE_Scratch.data(), polled, aDst, aDstSize );
+}
+
+static size_t compare_heatshrink_cobs_decode( const uint8_t *aSrc,
+																							size_t aSrcLen,
+																							uint8_t *aDst,
+																							size_t aDstSize,
+																							const uint8_t **aOutDecoded )
+{
+	heatshrink_decoder *pDecoder = &s_COMPARE_HeatshrinkDecoder;
+	const uint8_t *pCompressed	 = nullptr;
+	const size_t compressedLen =
+	 compare_cobs_decode( aSrc, aSrcLen, s_COMPARE_Scratch.data(), s_COMPARE_Scratch.size(), &pCompressed );
+	size_t sunk		= 0;
+	size_t polled = 0;
+
+	heatshrink_decoder_reset( pDecoder );
+
+	for( ;; )
+	{
+		size_t count = 0;
+
+		if( sunk < compressedLen )
+		{
+			if( heatshrink_decoder_sink( pDecoder, const_cast<uint8_t *>( pCompressed + sunk ), compressedLen - sunk, &count ) <
+					0 )
+			{
+				return 0;
+			}
+
+			sunk += count;
+		}
+		else if( heatshrink_decoder_finish( pDecoder ) == HSDR_FINISH_DONE )
+		{
+			break;
+		}
+
+		HSD_poll_res pollRes;
+
+		do
+		{
+			pollRes = heatshrink_decoder_poll( pDecoder, aDst + polled, aDstSize - polled, &count );
+			polled += count;
+		} while( ( pollRes == HSDR_POLL_MORE ) && ( count > 0 ) );
+
+		// Output full, while it still has more
+		if( ( pollRes < 0 ) || ( ( pollRes == HSDR_POLL_MORE ) && ( count == 0 ) ) )
+		{
+			return 0;
+		}
+	}
+
+	*aOutDecoded = aDst;
+
+	return polled;
+}
+
+static size_t compare_heatshrink_cobs_encode_memory( size_t aMaxMessageSize )
+{
+	return sizeof( s_COMPARE_HeatshrinkEncoder ) + COMPARE_HEATSHRINK_MAX_SIZE( aMaxMessageSize );
+}
+
+static size_t compare_heatshrink_cobs_decode_memory( size_t aMaxMessageSize )
+{
+	return sizeof( s_COMPARE_HeatshrinkDecoder ) + COMPARE_HEATSHRINK_MAX_SIZE( aMaxMessageSize );
+}
+
+static const sCOMPARE_codec s_COMPARE_Codecs[] = {
+	{ "dzrcobs plain",
+		compare_dzrcobs_plain_encode,
+		compare_dzrcobs_decode,
+		compare_dzrcobs_plain_encode_memory,
+		compare_dzrcobs_plain_decode_memory,
+		true },
+	{ "dzrcobs dict_1",
+		compare_dzrcobs_dict_1_encode,
+		compare_dzrcobs_decode,
+		compare_dzrcobs_dict_encode_memory,
+		compare_dzrcobs_dict_decode_memory,
+		true },
+	{ "dzrcobs dict_2",
+		compare_dzrcobs_dict_2_encode,
+		compare_dzrcobs_decode,
+		compare_dzrcobs_dict_encode_memory,
+		compare_dzrcobs_dict_decode_memory,
+		true },
+	{ "rcobs", compare_rcobs_encode, compare_rcobs_decode, compare_rcobs_encode_memory, compare_no_memory, false },
+	{ "cobs", compare_cobs_encode, compare_cobs_decode, compare_no_memory, compare_no_memory, false },
+	{ "lz4+cobs",
+		compare_lz4_cobs_encode,
+		compare_lz4_cobs_decode,
+		compare_lz4_cobs_encode_memory,
+		compare_lz4_cobs_decode_memory,
+		false },
+	{ "heatshrink+cobs",
+		compare_heatshrink_cobs_encode,
+		compare_heatshrink_cobs_decode,
+		compare_heatshrink_cobs_encode_memory,
+		compare_heatshrink_cobs_decode_memory,
+		false },
+};
+
+static bool compare_run( const sBENCH_corpus &aCorpus, const sCOMPARE_codec &aCodec, sCOMPARE_row *aOutRow )
+{
+	const size_t messagesCount = aCorpus.messages.size();
+
+	sCOMPARE_row row			= {};
+	size_t maxMessageSize = 0;
+
+	for( const sDZRCOBS_batch_entry &message : aCorpus.messages )
+	{
+		row.bytesIn += message.srcLen;
+		maxMessageSize = ( message.srcLen > maxMessageSize ) ? message.srcLen : maxMessageSize;
+	}
+
+	// Larger than the worst case of all the codecs
+	const size_t maxFrameSize = ( 2 * maxMessageSize ) + 64;
+
+	std::vector<uint8_t> encoded( messagesCount * ( maxFrameSize + 1 ) );
+	std::vector<size_t> offsets( messagesCount + 1 );
+	std::vector<uint8_t> decoded( maxMessageSize );
+	bool failed = false;
+
+	s_COMPARE_Scratch.assign( maxFrameSize, 0 );
+
+	row.encodeMBps = bench_speed_mbps( row.bytesIn, [&] {
+		size_t pos = 0;
+
+		for( size_t i = 0; i < messagesCount; i++ )
+		{
+			const size_t frameSize =
+			 aCodec.encode( aCorpus.messages[i].pSrc, aCorpus.messages[i].srcLen, &encoded[pos], maxFrameSize );
+
+			failed |= ( frameSize == 0 );
+			offsets[i] = pos;
+			pos += frameSize;
+			encoded[pos++] = 0x00;
+		}
+
+		offsets[messagesCount] = pos;
+	} );
+
+	if( failed )
+	{
+		fprintf( stderr, "Encoding failed\n" );
+		return false;
+	}
+
+	row.bytesOut = offsets[messagesCount];
+
+	row.decodeMBps = bench_speed_mbps( row.bytesIn, [&] {
+		for( size_t i = 0; i < messagesCount; i++ )
+		{
+			const uint8_t *pDecoded = nullptr;
+			const size_t frameSize	= offsets[i + 1] - offsets[i] - 1;
+
+			failed |= ( aCodec.decode( &encoded[offsets[i]], frameSize, decoded.data(), decoded.size(), &pDecoded ) !=
+									aCorpus.messages[i].srcLen );
+		}
+	} );
+
+	// Round trip check, so a broken codec does not give a nice ratio
+	for( size_t i = 0; ( i < messagesCount ) && !failed; i++ )
+	{
+		const uint8_t *pDecoded = nullptr;
+		const size_t frameSize	= offsets[i + 1] - offsets[i] - 1;
+		const size_t decodedLen = aCodec.decode( &encoded[offsets[i]], frameSize, decoded.data(), decoded.size(), &pDecoded );
+
+		failed = ( decodedLen != aCorpus.messages[i].srcLen ) ||
+						 ( ( decodedLen > 0 ) && ( memcmp( pDecoded, aCorpus.messages[i].pSrc, decodedLen ) != 0 ) ) ||
+						 ( memchr( &encoded[offsets[i]], 0x00, frameSize ) != nullptr );
+	}
+
+	if( failed )
+	{
+		fprintf( stderr, "Decoding failed\n" );
+		return false;
+	}
+
+	row.encodeMemory = aCodec.encodeMemory( maxMessageSize );
+	row.decodeMemory = aCodec.decodeMemory( maxMessageSize );
+
+	*aOutRow = row;
+
+	return true;
+}
+
+int main( int argc, char **argv )
+{
+	const bool csv = ( argc > 1 ) && ( strcmp( argv[1], "--csv" ) == 0 );
+
+	if( ( argc > 2 ) || ( ( argc == 2 ) && !csv ) )
+	{
+		fprintf( stderr, "usage: %s [--csv]\n", argv[0] );
+		return 1;
+	}
+
+	if( csv )
+	{
+		printf( "corpus,codec,crc,bytes_in,bytes_out,out_in,encode_mbps,decode_mbps,encode_memory,decode_memory\n" );
+	}
+	else
+	{
+		printf( "Each message is a frame plus a 0x00 delimiter. Memory is the codec state and\n"
+						"intermediate buffers, in bytes (stack not included). Only dzrcobs has a CRC.\n\n" );
+		printf( "%-9s %-16s %9s %9s %7s %9s %9s %8s %8s\n",
+						"corpus",
+						"codec",
+						"in",
+						"out",
+						"out/in",
+						"enc MB/s",
+						"dec MB/s",
+						"enc mem",
+						"dec mem" );
+	}
+
+	for( int i = 0; i < BENCH_CORPUS_N; i++ )
+	{
+		const sBENCH_corpus &corpus = bench_corpus( (eBENCH_corpus)i );
+
+		for( const sCOMPARE_codec &codec : s_COMPARE_Codecs )
+		{
+			sCOMPARE_row row;
+
+			if( !compare_run( corpus, codec, &row ) )
+			{
+				fprintf( stderr, "%s %s failed\n", bench_corpus_name( (eBENCH_corpus)i ), codec.pName );
+				return 1;
+			}
+
+			if( csv )
+			{
+				printf( "%s,%s,%d,%zu,%zu,%.4f,%.1f,%.1f,%zu,%zu\n",
+								bench_corpus_name( (eBENCH_corpus)i ),
+								codec.pName,
+								codec.hasCrc ? 1 : 0,
+								row.bytesIn,
+								row.bytesOut,
+								(double)row.bytesOut / (double)row.bytesIn,
+								row.encodeMBps,
+								row.decodeMBps,
+								row.encodeMemory,
+								row.decodeMemory );
+			}
+			else
+			{
+				printf( "%-9s %-16s %9zu %9zu %7.3f %9.1f %9.1f %8zu %8zu\n",
+								bench_corpus_name( (eBENCH_corpus)i ),
+								codec.pName,
+								row.bytesIn,
+								row.bytesOut,
+								(double)row.bytesOut / (double)row.bytesIn,
+								row.encodeMBps,
+								row.decodeMBps,
+								row.encodeMemory,
+								row.decodeMemory );
+			}
+		}
+	}
+
+	return 0;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,77 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file main.cpp
+///	@brief Benchmarks runner, adds the build options to the report context
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <dzrcobs/dzrcobs_dictionary.h>
+#include "bench_data.h"
+#include "bench_perf.h"
+#include "crc8.h"
+#include "dzrcobs_simd.h"
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+int main( int argc, char **argv )
+{
+	bool perfCounters = false;
+	int argsCount			= 1;
+
+	// Own flags are removed, so they are not reported as unrecognized
+	for( int i = 1; i < argc; i++ )
+	{
+		if( strcmp( argv[i], BENCH_PERF_FLAG ) == 0 )
+		{
+			perfCounters = true;
+		}
+		else
+		{
+			argv[argsCount++] = argv[i];
+		}
+	}
+
+	argc = argsCount;
+
+	benchmark::Initialize( &argc, argv );
+
+	if( benchmark::ReportUnrecognizedArguments( argc, argv ) )
+	{
+		return 1;
+	}
+
+	// So results of different builds can be told apart (eg: on the JSON output)
+	benchmark::AddCustomContext( "dzrcobs_crc_table", std::to_string( DZRCOBS_CRC_TABLE ) );
+	benchmark::AddCustomContext( "dzrcobs_dict_accelerator", std::to_string( DZRCOBS_DICT_ACCELERATOR ) );
+	benchmark::AddCustomContext( "dzrcobs_simd", std::to_string( DZRCOBS_SIMD ) );
+	benchmark::AddCustomContext( "dzrcobs_simd_level", dzrcobs_simd_level_name( dzrcobs_simd_get_level() ) );
+	benchmark::AddCustomContext( "dzrcobs_bench_seed", std::to_string( BENCH_SEED ) );
+
+	if( perfCounters )
+	{
+		benchmark::AddCustomContext( "dzrcobs_perf_counters", bench_perf_enable() ? "1" : "0" );
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,204 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file report.cpp
+///	@brief Compression ratio and speed of each encoding on the corpus
+///
+///	@par  Plataform Target:	Benchmarks
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_decode.h>
+#include "bench_corpus.h"
+#include "bench_data.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+typedef struct s_REPORT_mode
+{
+	const char *pName;
+	eDZRCOBS_encoding encoding;
+} sREPORT_mode;
+
+// DICT_1 is the default dictionary and DICT_2 the text one, see bench_data.h
+static const sREPORT_mode s_REPORT_Modes[] = {
+	{ "plain", DZRCOBS_PLAIN },
+	{ "dict_1 default", DZRCOBS_USING_DICT_1 },
+	{ "dict_2 text", DZRCOBS_USING_DICT_2 },
+};
+
+typedef struct s_REPORT_row
+{
+	size_t bytesIn;
+	size_t bytesOut;
+	size_t bytesMax;
+	double encodeMBps;
+	double decodeMBps;
+} sREPORT_row;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static bool report_run( const sBENCH_corpus &aCorpus, eDZRCOBS_encoding aEncoding, sREPORT_row *aOutRow )
+{
+	const size_t messagesCount = aCorpus.messages.size();
+
+	sREPORT_row row = {};
+	size_t dstSize	= 0;
+
+	for( const sDZRCOBS_batch_entry &message : aCorpus.messages )
+	{
+		// Frame, header and delimiter
+		row.bytesIn += message.srcLen;
+		row.bytesMax += DZRCOBS_MAX_ENCODED_SIZE( message.srcLen ) + DZRCOBS_FRAME_HEADER_SIZE + 1;
+		dstSize += DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( message.srcLen ) + DZRCOBS_FRAME_HEADER_SIZE + 1;
+	}
+
+	std::vector<uint8_t> encoded( dstSize );
+	std::vector<size_t> offsets( messagesCount + 1 );
+	std::vector<uint8_t> decoded( row.bytesIn );
+	std::vector<sDZRCOBS_batch_result> results( messagesCount );
+
+	sDZRCOBS_ctx ctx;
+	ctx.pDict[0] = bench_binary_dictionary();
+	ctx.pDict[1] = bench_text_dictionary();
+
+	eDZRCOBS_ret ret		 = DZRCOBS_RET_SUCCESS;
+	size_t framesEncoded = 0;
+
+	row.encodeMBps = bench_speed_mbps( row.bytesIn, [&] {
+		ret = dzrcobs_encode_batch( &ctx,
+																aEncoding,
+																aCorpus.messages.data(),
+																messagesCount,
+																encoded.data(),
+																encoded.size(),
+																offsets.data(),
+																&framesEncoded );
+	} );
+
+	if( ( ret != DZRCOBS_RET_SUCCESS ) || ( framesEncoded != messagesCount ) )
+	{
+		fprintf( stderr, "dzrcobs_encode_batch failed (%d)\n", (int)ret );
+		return false;
+	}
+
+	row.bytesOut = offsets[messagesCount];
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= encoded.data();
+	decodeCtx.srcBufEncodedLen	= row.bytesOut;
+	decodeCtx.dstBufDecoded			= decoded.data();
+	decodeCtx.dstBufDecodedSize = decoded.size();
+	decodeCtx.pDict[0]					= ctx.pDict[0];
+	decodeCtx.pDict[1]					= ctx.pDict[1];
+
+	size_t resultsCount = 0;
+	size_t consumed			= 0;
+
+	row.decodeMBps = bench_speed_mbps( row.bytesIn, [&] {
+		ret = dzrcobs_decode_batch( &decodeCtx, results.data(), results.size(), &resultsCount, &consumed );
+	} );
+
+	if( ( ret != DZRCOBS_RET_SUCCESS ) || ( resultsCount != messagesCount ) )
+	{
+		fprintf( stderr, "dzrcobs_decode_batch failed (%d)\n", (int)ret );
+		return false;
+	}
+
+	// Round trip check, so a broken encoding does not give a nice ratio
+	for( size_t i = 0; i < messagesCount; i++ )
+	{
+		const sDZRCOBS_batch_entry &message = aCorpus.messages[i];
+
+		if( ( results[i].status != DZRCOBS_RET_SUCCESS ) || ( results[i].length != message.srcLen ) ||
+				( results[i].user6bits != message.user6bits ) ||
+				( ( message.srcLen > 0 ) && ( memcmp( &decoded[results[i].offset], message.pSrc, message.srcLen ) != 0 ) ) )
+		{
+			fprintf( stderr, "Message %zu does not match after decoding\n", i );
+			return false;
+		}
+	}
+
+	*aOutRow = row;
+
+	return true;
+}
+
+int main( int argc, char **argv )
+{
+	const bool csv = ( argc > 1 ) && ( strcmp( argv[1], "--csv" ) == 0 );
+
+	if( ( argc > 2 ) || ( ( argc == 2 ) && !csv ) )
+	{
+		fprintf( stderr, "usage: %s [--csv]\n", argv[0] );
+		return 1;
+	}
+
+	if( csv )
+	{
+		printf( "corpus,mode,messages,bytes_in,bytes_out,out_in,bytes_max,out_max,encode_mbps,decode_mbps\n" );
+	}
+	else
+	{
+		printf( "Each message is a frame (header and delimiter included), max is DZRCOBS_MAX_ENCODED_SIZE\n\n" );
+		printf( "%-9s %-15s %8s %9s %9s %7s %9s %7s %9s %9s\n",
+						"corpus",
+						"mode",
+						"messages",
+						"in",
+						"out",
+						"out/in",
+						"max",
+						"out/max",
+						"enc MB/s",
+						"dec MB/s" );
+	}
+
+	for( int i = 0; i < BENCH_CORPUS_N; i++ )
+	{
+		const sBENCH_corpus &corpus = bench_corpus( (eBENCH_corpus)i );
+
+		for( const sREPORT_mode &mode : s_REPORT_Modes )
+		{
+			sREPORT_row row;
+
+			if( !report_run( corpus, mode.encoding, &row ) )
+			{
+				fprintf( stderr, "%s %s failed\n", bench_corpus_name( (eBENCH_corpus)i ), mode.pName );
+				return 1;
+			}
+
+			printf( csv ? "%s,%s,%zu,%zu,%zu,%.4f,%zu,%.4f,%.1f,%.1f\n"
+									: "%-9s %-15s %8zu %9zu %9zu %7.3f %9zu %7.3f %9.1f %9.1f\n",
+							bench_corpus_name( (eBENCH_corpus)i ),
+							mode.pName,
+							corpus.messages.size(),
+							row.bytesIn,
+							row.bytesOut,
+							(double)row.bytesOut / (double)row.bytesIn,
+							row.bytesMax,
+							(double)row.bytesOut / (double)row.bytesMax,
+							row.encodeMBps,
+							row.decodeMBps );
+		}
+	}
+
+	return 0;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
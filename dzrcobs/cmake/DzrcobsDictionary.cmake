@@ -0,0 +1,60 @@
+# ===-----------------------------------------------------------------------===#
+# Distributed under the 3-Clause BSD License. See accompanying file LICENSE or
+# copy at https://opensource.org/licenses/BSD-3-Clause).
+# SPDX-License-Identifier: BSD-3-Clause
+# ===-----------------------------------------------------------------------===#
+
+# ------------------------------------------------------------------------------
+# dzrcobs_add_dictionary(<target> <file> [NAME <symbol>])
+#
+# Generates C code, at build time, from a C file with a DICT_ADD_WORD list (the
+# same file dzrcobs_dictionary_init would parse at runtime) and adds it to
+# <target>:
+#
+#   <symbol>          const sDICT_ctx, ready to use (no dzrcobs_dictionary_init)
+#   <symbol>_search   switch/trie search, same results as
+#                     dzrcobs_dictionary_search, set on <symbol>.searchFunc
+#
+# <symbol> defaults to <file name without extension>_ctx. Include
+# "<file name without extension>_generated.h" to use it.
+#
+# The generator (dzrcobs_dict_gen) runs on the host. When cross compiling, build
+# it for the host and set DZRCOBS_DICT_GEN_EXECUTABLE to its path.
+# ------------------------------------------------------------------------------
+
+function(dzrcobs_add_dictionary target file)
+  cmake_parse_arguments(x "" "NAME" "" ${ARGN})
+
+  get_filename_component(input "${file}" ABSOLUTE)
+  get_filename_component(stem "${file}" NAME_WE)
+
+  if(NOT x_NAME)
+    set(x_NAME "${stem}_ctx")
+  endif()
+
+  if(DZRCOBS_DICT_GEN_EXECUTABLE)
+    set(generator "${DZRCOBS_DICT_GEN_EXECUTABLE}")
+    set(generator_depends "${DZRCOBS_DICT_GEN_EXECUTABLE}")
+  elseif(TARGET dzrcobs_dict_gen)
+    set(generator "$<TARGET_FILE:dzrcobs_dict_gen>")
+    set(generator_depends dzrcobs_dict_gen)
+  else()
+    message(FATAL_ERROR "dzrcobs_add_dictionary: dzrcobs_dict_gen is not built, "
+                        "set DZRCOBS_DICT_GEN_EXECUTABLE to a host build of it")
+  endif()
+
+  set(output_dir "${CMAKE_CURRENT_BINARY_DIR}/dzrcobs_dictionaries")
+  set(output_source "${output_dir}/${stem}_generated.c")
+  set(output_header "${output_dir}/${stem}_generated.h")
+
+  add_custom_command(
+    OUTPUT "${output_source}" "${output_header}"
+    COMMAND ${CMAKE_COMMAND} -E make_directory "${output_dir}"
+    COMMAND ${generator} --name ${x_NAME} --source "${output_source}" --header "${output_header}" "${input}"
+    DEPENDS "${input}" ${generator_depends}
+    COMMENT "Generating dictionary ${x_NAME} from ${file}"
+    VERBATIM)
+
+  target_sources(${target} PRIVATE "${output_source}" "${output_header}")
+  target_include_directories(${target} PRIVATE "${output_dir}")
+endfunction()
@@ -52,6 +52,43 @@ typedef enum e_DZRCOBS_encoding
 	DZRCOBS_RESERVED		 = 3, ///< For future uses
 } eDZRCOBS_encoding;
 
+/// How the dictionary encoder chooses the words, see dzrcobs_encode_set_parsing
+typedef enum e_DZRCOBS_parsing
+{
+	/// The shortest word found at each position. The search tries the word
+	/// sizes in their order on sDICT_ctx, that dzrcobs_dictionary_init asserts
+	/// ascending and contiguous (wordSizeTable[i] has the words of i + 2 bytes)
+	DZRCOBS_PARSING_GREEDY	= 0,
+	DZRCOBS_PARSING_OPTIMAL = 1, ///< The words, or literals, that encode in fewer bytes
+} eDZRCOBS_parsing;
+
+// Set DZRCOBS_OPTIMAL_PARSING to 1 to build DZRCOBS_PARSING_OPTIMAL. Its
+// lookahead is held on each sDZRCOBS_ctx (the carry grows from 8 to 46 bytes)
+#ifndef DZRCOBS_OPTIMAL_PARSING
+#define DZRCOBS_OPTIMAL_PARSING 0
+#endif
+
+#if DZRCOBS_OPTIMAL_PARSING
+// Bytes looked ahead by DZRCOBS_PARSING_OPTIMAL to choose each token
+#ifndef DZRCOBS_OPTIMAL_WINDOW
+#define DZRCOBS_OPTIMAL_WINDOW ( 24 )
+#endif
+
+#if ( DZRCOBS_OPTIMAL_WINDOW < DICT_MAX_WORD_SIZE ) || ( DZRCOBS_OPTIMAL_WINDOW > 128 )
+#error DZRCOBS_OPTIMAL_WINDOW must be between DICT_MAX_WORD_SIZE and 128 (the carry length is 8 bits)
+#endif
+
+#define DZRCOBS_ENCODE_LOOKAHEAD ( DZRCOBS_OPTIMAL_WINDOW )
+#else
+#define DZRCOBS_ENCODE_LOOKAHEAD ( DICT_MAX_WORD_SIZE )
+#endif
+
+// Bytes held back between dzrcobs_encode_inc calls, so a dictionary word that
+// spans two calls is still found. Up to (lookahead - 1) pending bytes plus
+// the same amount of lookahead taken from the next call, the lookahead is the
+// max word size or DZRCOBS_OPTIMAL_WINDOW.
+#define DZRCOBS_ENCODE_CARRY_SIZE ( 2 * ( DZRCOBS_ENCODE_LOOKAHEAD - 1 ) )
+
 typedef struct s_DZRCOB_ctx sDZRCOBS_ctx;
 
 typedef eDZRCOBS_ret ( *dzrcobs_encode_inc_funcPtr )( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
@@ -75,10 +112,24 @@ struct s_DZRCOB_ctx
 	uint8_t pendingMask;
 
 	bool isFirstByteInTheBuffer;
+#if DZRCOBS_OPTIMAL_PARSING
+	bool isOptimalParsing; ///< DZRCOBS_PARSING_OPTIMAL on this frame
+#endif
+
+	uint8_t carry[DZRCOBS_ENCODE_CARRY_SIZE]; ///< Source bytes not encoded yet, waiting for lookahead
+	uint8_t carryLen;													///< Number of bytes on carry
 
 	size_t writeCounter; ///< Current destiny counter, for debug
 };
 
+/// One message of dzrcobs_encode_batch
+typedef struct s_DZRCOBS_batch_entry
+{
+	const uint8_t *pSrc; ///< Message data
+	size_t srcLen;			 ///< Message size, can be 0
+	uint8_t user6bits;	 ///< user application 6 bits of this frame, 1..63
+} sDZRCOBS_batch_entry;
+
 #define DZRCOBS_ONE_BYTE_OVERHEAD_EVERY ( 63 )
 #define Z_DZRCOBS_DIV_ROUND_UP( n, d ) ( ( ( n ) + ( d ) - 1 ) / ( d ) )
 #define DZRCOBS_MAX_OVERHEAD( size ) Z_DZRCOBS_DIV_ROUND_UP( ( size ), DZRCOBS_ONE_BYTE_OVERHEAD_EVERY )
@@ -93,6 +144,10 @@ struct s_DZRCOB_ctx
 #define DZRCOBS_CODE_JUMP ( 0x3F )
 #define DZRCOBS_CODE_JUMP_PLAIN ( 0x7F )
 
+// Dictionary encodings jump every 62 bytes, so their worst case is larger than
+// DZRCOBS_MAX_ENCODED_SIZE (a jump code each 62 bytes, plus the last code)
+#define DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( size ) ( ( size ) + ( ( size ) / ( DZRCOBS_CODE_JUMP - 1 ) ) + 1 )
+
 // Declarations
 // /////////////////////////////////////////////////////////////////////////////
 
@@ -122,8 +177,38 @@ eDZRCOBS_ret dzrcobs_encode_inc_begin( sDZRCOBS_ctx *aCtx,
 																			 uint8_t *aDstBuf,
 																			 size_t aDstBufSize );
 
+/**
+ * @brief Set how the words are chosen on the dictionary encodings of the
+ *        frame begun by dzrcobs_encode_inc_begin, that sets
+ *        DZRCOBS_PARSING_GREEDY. Must be called before any data is added.
+ *        DZRCOBS_PARSING_OPTIMAL looks DZRCOBS_OPTIMAL_WINDOW bytes ahead
+ *        and takes the word (of any size) or literal that gives the fewest
+ *        encoded bytes, counting the code bytes that a word in a literal run
+ *        and a zero cost. It is slower, and the frames decode with
+ *        dzrcobs_decode as any other. It has no effect on DZRCOBS_PLAIN.
+ *        It is only built with DZRCOBS_OPTIMAL_PARSING: without it,
+ *        DZRCOBS_PARSING_OPTIMAL returns DZRCOBS_RET_ERR_BAD_ARG and the frame
+ *        stays on DZRCOBS_PARSING_GREEDY.
+ *
+ * @param aCtx Context in use
+ * @param aParsing The parsing to use
+ * @retval DZRCOBS_RET_SUCCESS
+ * @retval DZRCOBS_RET_ERR_BAD_ARG invalid arguments, data was already added,
+ * or DZRCOBS_PARSING_OPTIMAL without DZRCOBS_OPTIMAL_PARSING
+ * @retval DZRCOBS_RET_ERR_NOTINITIALIZED no frame begun
+ */
+eDZRCOBS_ret dzrcobs_encode_set_parsing( sDZRCOBS_ctx *aCtx, eDZRCOBS_parsing aParsing );
+
 /**
  * @brief Add the data to encoding
+ *        On dictionary encodings, the last bytes may be held on the context
+ *        until the next call (or dzrcobs_encode_inc_end), so the output does
+ *        not depend on how the source is split between calls.
+ *        On DZRCOBS_RET_ERR_OVERFLOW nothing of aSrcBuf was added: the context
+ *        is as before the call (the destiny bytes after the encoded ones may
+ *        have changed), so the frame can still be ended, or the data added
+ *        in smaller parts. The plain encoding checks its worst case before
+ *        writing, the dictionary ones check each write and undo the call.
  *
  * @param aCtx Context in use
  * @param aSrcBuf Source buffer
@@ -133,7 +218,26 @@ eDZRCOBS_ret dzrcobs_encode_inc_begin( sDZRCOBS_ctx *aCtx,
 eDZRCOBS_ret dzrcobs_encode_inc( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
 
 /**
- * @brief Finalize the encoding. It adds a 0 in the end of buffer
+ * @brief dzrcobs_encode_inc of each encoding, the functions that encFunc
+ *        points to. They do not check the arguments: aSrcBufSize > 0.
+ *        The plain one does not check the destiny room, so
+ *        DZRCOBS_FRAME_HEADER_SIZE + DZRCOBS_MAX_ENCODED_SIZE( aSrcBufSize )
+ *        bytes must be free on the destiny. The dictionary one checks it on
+ *        each write and returns DZRCOBS_RET_ERR_OVERFLOW with the context as
+ *        before the call. Used by dzrcobs_cpp.h to call the encoding directly.
+ *
+ * @param aCtx Context started with dzrcobs_encode_inc_begin on the same encoding
+ * @param aSrcBuf Source buffer
+ * @param aSrcBufSize Size of source buffer
+ * @return eRCOBS_ret
+ */
+eDZRCOBS_ret dzrcobs_encode_inc_plain( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
+eDZRCOBS_ret dzrcobs_encode_inc_dictionary( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
+
+/**
+ * @brief Finalize the encoding. It encodes the bytes still held on the
+ *        context and adds a 0 in the end of buffer
+ *        On DZRCOBS_RET_ERR_OVERFLOW the context is as before the call.
  *
  * @param aCtx Context in use
  * @param aOutSizeEncoded Size of encoded data (last 0 included)
@@ -141,6 +245,79 @@ eDZRCOBS_ret dzrcobs_encode_inc( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, siz
  */
 eDZRCOBS_ret dzrcobs_encode_inc_end( sDZRCOBS_ctx *aCtx, size_t *aOutSizeEncoded );
 
+/**
+ * @brief Encode a whole frame on the encoding that gives the fewest bytes:
+ *        DZRCOBS_PLAIN or the dictionaries set with
+ *        dzrcobs_encode_set_dictionary. The source is read twice: a first
+ *        pass counts the encoded sizes of all the encodings at once, without
+ *        writing, then a second pass writes only the smallest one. The
+ *        written size is checked against the counted one. The choice is on
+ *        the encoding bits of the frame, so it decodes with dzrcobs_decode
+ *        as any other.
+ *        On a tie, DZRCOBS_PLAIN, then DZRCOBS_USING_DICT_1, is taken.
+ *        The words are chosen by DZRCOBS_PARSING_GREEDY.
+ *
+ * @param aCtx Context to be used. Only the dictionaries and user6bits (1..63)
+ *        are used, the rest of it is overwritten. No frame is left open for
+ *        dzrcobs_encode_inc.
+ * @param aSrcBuf Source buffer, can be NULL if aSrcBufSize is 0
+ * @param aSrcBufSize Size of source buffer
+ * @param aDstBuf Destiny buffer. DZRCOBS_MAX_ENCODED_SIZE( aSrcBufSize ) +
+ *        DZRCOBS_FRAME_HEADER_SIZE is enough, even if a dictionary frame may
+ *        need up to DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY: the plain frame
+ *        fits on it, and a dictionary is only taken when its counted size is
+ *        smaller than the plain one. The dictionary encoder checks each
+ *        write, so a wrong count can not write past aDstBufSize.
+ * @param aDstBufSize Max buffer size
+ * @param aOutSizeEncoded Size of encoded data (without a delimiter)
+ * @param aOutEncoding The encoding taken
+ * @retval DZRCOBS_RET_SUCCESS
+ * @retval DZRCOBS_RET_ERR_BAD_ARG if invalid arguments are passed, or the
+ *         user6bits are out of 1..63
+ * @retval DZRCOBS_RET_ERR_OVERFLOW if the frame does not fit on aDstBuf
+ * @retval DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if the written frame is not of
+ *         the counted size (a bug of the counting, the frame is not valid)
+ */
+eDZRCOBS_ret dzrcobs_encode_auto( sDZRCOBS_ctx *aCtx,
+																	const uint8_t *aSrcBuf,
+																	size_t aSrcBufSize,
+																	uint8_t *aDstBuf,
+																	size_t aDstBufSize,
+																	size_t *aOutSizeEncoded,
+																	eDZRCOBS_encoding *aOutEncoding );
+
+/**
+ * @brief Encode many messages, each one as a frame followed by a 0x00 delimiter,
+ *        back to back on the same buffer. The checks and the encoding setup
+ *        are done once for all the batch.
+ *
+ * @param aCtx Context to be used. Only the dictionaries set with
+ *        dzrcobs_encode_set_dictionary are used, the rest of it is overwritten.
+ *        The frames use DZRCOBS_PARSING_GREEDY.
+ * @param aEncoding The desired encoding for all the frames
+ * @param aEntries Messages to encode
+ * @param aEntriesCount Number of messages
+ * @param aDstBuf Destiny buffer
+ * @param aDstBufSize Max buffer size
+ * @param aOutOffsets Array of aEntriesCount + 1 entries. aOutOffsets[i] is
+ *        where frame i starts, so frame i has aOutOffsets[i + 1] - aOutOffsets[i] - 1
+ *        bytes (delimiter not included). The last one is the total size written.
+ * @param aOutFramesEncoded Number of frames encoded. On error, the frames
+ *        before the failing entry are complete on aDstBuf.
+ * @retval DZRCOBS_RET_SUCCESS all the frames were encoded
+ * @retval DZRCOBS_RET_ERR_BAD_ARG if invalid arguments are passed, or an entry
+ *         has a NULL pSrc with data or its user6bits are out of 1..63
+ * @retval DZRCOBS_RET_ERR_OVERFLOW if the frames do not fit on aDstBuf
+ */
+eDZRCOBS_ret dzrcobs_encode_batch( sDZRCOBS_ctx *aCtx,
+																	 eDZRCOBS_encoding aEncoding,
+																	 const sDZRCOBS_batch_entry *aEntries,
+																	 size_t aEntriesCount,
+																	 uint8_t *aDstBuf,
+																	 size_t aDstBufSize,
+																	 size_t *aOutOffsets,
+																	 size_t *aOutFramesEncoded );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,481 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_constexpr.h
+///	@brief constexpr dzrcobs and rcobs encoders and CRC8, for frames known at
+///        compile time (heartbeats, ACKs, fixed commands)
+///
+/// Header only, C++20. The frames are the same, byte by byte, as the ones
+/// written by dzrcobs_encode_inc_* / rcobs_encode_inc_* (without the 0x00
+/// delimiter). The dictionary encodings use the greedy parsing
+/// (DZRCOBS_PARSING_GREEDY).
+///
+/// @code
+/// constexpr char kDictionary[] = DICT_ADD_WORD(2, "OK") DICT_ADD_WORD(3, "ACK");
+///
+/// constexpr auto kHeartbeat = dzrcobs::plain_frame<std::array<uint8_t, 3>{ 0x01, 0x00, 0x02 }, 5>;
+/// constexpr auto kAck =
+///  dzrcobs::dictionary_frame<std::array<uint8_t, 3>{ 'A', 'C', 'K' }, dzrcobs::sDZRCOBS_dictionary_string{ kDictionary },
+///                            DZRCOBS_USING_DICT_1, 5>;
+/// @endcode
+///
+///	@par  Plataform Target:	Any (C++20)
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZRCOBS_CONSTEXPR_H_
+#define _DZRCOBS_CONSTEXPR_H_
+
+#if !defined( __cplusplus ) || ( ( __cplusplus < 202002L ) && ( !defined( _MSVC_LANG ) || ( _MSVC_LANG < 202002L ) ) )
+#error dzrcobs_constexpr.h needs C++20
+#endif
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include "dzrcobs.h"
+#include "rcobs.h"
+
+namespace dzrcobs
+{
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+/// Dictionary string (a DICT_ADD_WORD list, null terminated) as a template argument
+template <size_t N> struct sDZRCOBS_dictionary_string
+{
+	consteval sDZRCOBS_dictionary_string( const char ( &aWords )[N] )
+	{
+		for( size_t i = 0; i < N; i++ )
+		{
+			words[i] = aWords[i];
+		}
+	}
+
+	char words[N] = {};
+};
+
+/// Encoded frame on a buffer of the worst case size
+template <size_t N> struct sDZRCOBS_sized_frame
+{
+	std::array<uint8_t, N> data = {};
+	size_t size									= 0; ///< 0 if the encoding failed
+};
+
+namespace detail
+{
+
+// Same as crc8.h and dzrcobs.c, not public on the C headers
+inline constexpr uint8_t CRC_POLYNOMIAL = 0xA6;
+inline constexpr uint8_t CRC_INIT_VAL		= 0xFF;
+
+inline constexpr uint8_t RCOBS_CODE_JUMP = 0xFF;
+
+inline constexpr uint8_t PREVIOUS_CODE_BLOCK			= 0x00;
+inline constexpr uint8_t PREVIOUS_CODE_DICTIONARY = 0x01;
+inline constexpr uint8_t PREVIOUS_CODE_ZERO				= 0x02;
+
+// Writes on aDst, counting the CRC of what was written
+struct sWriter
+{
+	constexpr void put( uint8_t aByte )
+	{
+		if( pos >= dst.size() )
+		{
+			isOverflow = true;
+			return;
+		}
+
+		dst[pos++] = aByte;
+		crc				 = crc8_byte( crc, aByte );
+	}
+
+	static constexpr uint8_t crc8_byte( uint8_t aCrc, uint8_t aByte )
+	{
+		uint8_t crc = (uint8_t)( aCrc ^ aByte );
+
+		for( int bit = 0; bit < 8; bit++ )
+		{
+			crc = ( crc & 0x80 ) ? (uint8_t)( (uint8_t)( crc << 1 ) ^ CRC_POLYNOMIAL ) : (uint8_t)( crc << 1 );
+		}
+
+		return crc;
+	}
+
+	std::span<uint8_t> dst;
+	size_t pos			= 0;
+	uint8_t crc			= CRC_INIT_VAL;
+	bool isOverflow = false;
+};
+
+// Same as dzrcobs_dictionary_search: the words are sorted by size, so the first
+// match is the shortest one. Returns the word index (1 based) or 0.
+constexpr uint8_t dictionary_search( std::span<const char> aDictionary,
+																		 std::span<const uint8_t> aKey,
+																		 size_t *aOutKeySizeFound )
+{
+	uint8_t idx = 1;
+
+	for( size_t pos = 0; ( pos < aDictionary.size() ) && ( aDictionary[pos] != '\0' ); idx++ )
+	{
+		const size_t wordSize = (size_t)( aDictionary[pos] - '0' );
+		const size_t wordPos	= pos + 1;
+
+		pos = wordPos + wordSize;
+
+		if( ( wordSize > aKey.size() ) || ( pos > aDictionary.size() ) )
+		{
+			continue;
+		}
+
+		bool isMatch = true;
+
+		for( size_t i = 0; ( i < wordSize ) && isMatch; i++ )
+		{
+			isMatch = ( (uint8_t)aDictionary[wordPos + i] == aKey[i] );
+		}
+
+		if( isMatch )
+		{
+			*aOutKeySizeFound = wordSize;
+			return idx;
+		}
+	}
+
+	return 0;
+}
+
+// Words with sizes 2..DICT_MAX_WORD_SIZE, ascending, up to DICT_MAX_WORDS, null terminated
+constexpr bool dictionary_isvalid( std::span<const char> aDictionary )
+{
+	size_t wordsCount		 = 0;
+	size_t lastWordSize	 = 0;
+	size_t pos					 = 0;
+
+	for( ; ( pos < aDictionary.size() ) && ( aDictionary[pos] != '\0' ); wordsCount++ )
+	{
+		const size_t wordSize = (size_t)( aDictionary[pos] - '0' );
+
+		if( ( wordSize < 2 ) || ( wordSize > DICT_MAX_WORD_SIZE ) || ( wordSize < lastWordSize ) )
+		{
+			return false;
+		}
+
+		lastWordSize = wordSize;
+		pos += wordSize + 1;
+	}
+
+	return ( wordsCount > 0 ) && ( wordsCount <= DICT_MAX_WORDS ) && ( pos < aDictionary.size() );
+}
+
+} // namespace detail
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief CRC8 0xA6, same as DZRCOBS_CRC
+ */
+constexpr uint8_t crc8( uint8_t aCrc, uint8_t aByte )
+{
+	return detail::sWriter::crc8_byte( aCrc, aByte );
+}
+
+/**
+ * @brief CRC8 0xA6 over a buffer, same as dzrcobs_crc8_block
+ */
+constexpr uint8_t crc8( uint8_t aCrc, std::span<const uint8_t> aBuf )
+{
+	for( const uint8_t byte : aBuf )
+	{
+		aCrc = crc8( aCrc, byte );
+	}
+
+	return aCrc;
+}
+
+/**
+ * @brief Same as rcobs_encode_inc_begin, rcobs_encode_inc and rcobs_encode_inc_end
+ *
+ * @param aSrc Data to encode
+ * @param aDst Destiny buffer, RCOBS_MAX_ENCODED_SIZE( aSrc.size() ) is enough
+ * @return size_t Encoded size, 0 if aDst is too small
+ */
+constexpr size_t rcobs_encode( std::span<const uint8_t> aSrc, std::span<uint8_t> aDst )
+{
+	detail::sWriter writer{ aDst };
+	uint8_t code = 1;
+
+	for( const uint8_t byte : aSrc )
+	{
+		if( byte == 0 )
+		{
+			writer.put( code );
+			code = 1;
+			continue;
+		}
+
+		writer.put( byte );
+		code++;
+
+		if( code == detail::RCOBS_CODE_JUMP )
+		{
+			writer.put( code );
+			code = 1;
+		}
+	}
+
+	writer.put( code );
+
+	return writer.isOverflow ? 0 : writer.pos;
+}
+
+/**
+ * @brief Same as dzrcobs_encode_inc_* with DZRCOBS_PLAIN
+ *
+ * @param aSrc Data to encode
+ * @param aUser6bits User application 6 bits, 1..63
+ * @param aDst Destiny buffer, DZRCOBS_MAX_ENCODED_SIZE( aSrc.size() ) +
+ *             DZRCOBS_FRAME_HEADER_SIZE is enough
+ * @return size_t Encoded size, 0 if aDst is too small or aUser6bits is not valid
+ */
+constexpr size_t encode_plain( std::span<const uint8_t> aSrc, uint8_t aUser6bits, std::span<uint8_t> aDst )
+{
+	if( ( aUser6bits == 0 ) || ( aUser6bits > 0x3F ) )
+	{
+		return 0;
+	}
+
+	detail::sWriter writer{ aDst };
+	uint8_t code = 1;
+
+	for( const uint8_t byte : aSrc )
+	{
+		if( byte == 0 )
+		{
+			writer.put( code );
+			code = 1;
+			continue;
+		}
+
+		writer.put( byte );
+		code++;
+
+		if( code == DZRCOBS_CODE_JUMP_PLAIN )
+		{
+			writer.put( code );
+			code = 1;
+		}
+	}
+
+	writer.put( code );
+	writer.put( (uint8_t)( (uint8_t)( aUser6bits << 2 ) | DZRCOBS_PLAIN ) );
+
+	const uint8_t crc = writer.crc;
+	writer.put( ( crc == 0x00 ) ? DZRCOBS_CRC_VALUE_WHEN_CRC_IS_ZERO : crc );
+
+	return writer.isOverflow ? 0 : writer.pos;
+}
+
+/**
+ * @brief Same as dzrcobs_encode_inc_* with a dictionary encoding and
+ *        DZRCOBS_PARSING_GREEDY
+ *
+ * @param aSrc Data to encode
+ * @param aDictionary Dictionary string, as given to dzrcobs_dictionary_init
+ * @param aEncoding DZRCOBS_USING_DICT_1 or DZRCOBS_USING_DICT_2
+ * @param aUser6bits User application 6 bits, 0..63
+ * @param aDst Destiny buffer, DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( aSrc.size() ) +
+ *             DZRCOBS_FRAME_HEADER_SIZE is enough
+ * @return size_t Encoded size, 0 if aDst is too small or an argument is not valid
+ */
+constexpr size_t encode_dictionary( std::span<const uint8_t> aSrc,
+																		std::span<const char> aDictionary,
+																		eDZRCOBS_encoding aEncoding,
+																		uint8_t aUser6bits,
+																		std::span<uint8_t> aDst )
+{
+	if( ( ( aEncoding != DZRCOBS_USING_DICT_1 ) && ( aEncoding != DZRCOBS_USING_DICT_2 ) ) || ( aUser6bits > 0x3F ) ||
+			!detail::dictionary_isvalid( aDictionary ) )
+	{
+		return 0;
+	}
+
+	detail::sWriter writer{ aDst };
+
+	uint8_t code				 = 1;
+	uint8_t previousCode = detail::PREVIOUS_CODE_ZERO;
+	uint8_t pendingMask	 = DZRCOBS_NEXTCODE_IS_ZERO;
+	bool isFirstByte		 = true;
+
+	// Same as dzrcobs_block_code
+	const auto blockCode = [&]() -> uint8_t {
+		return ( ( code == 1 ) && ( previousCode != detail::PREVIOUS_CODE_BLOCK ) ) ? (uint8_t)0x01
+																																								: (uint8_t)( code | pendingMask );
+	};
+
+	for( size_t pos = 0; pos < aSrc.size(); )
+	{
+		size_t keySizeFound = 0;
+		const uint8_t idx		= detail::dictionary_search( aDictionary, aSrc.subspan( pos ), &keySizeFound );
+
+		if( idx != 0 )
+		{
+			if( previousCode != detail::PREVIOUS_CODE_DICTIONARY )
+			{
+				if( !isFirstByte )
+				{
+					writer.put( blockCode() );
+				}
+
+				code = 1;
+			}
+
+			previousCode = detail::PREVIOUS_CODE_DICTIONARY;
+			pendingMask	 = DZRCOBS_NEXTCODE_IS_DICTIONARY;
+			isFirstByte	 = false;
+
+			writer.put( (uint8_t)( DZRCOBS_DICTIONARY_BITMASK | ( idx - 1 ) ) );
+
+			pos += keySizeFound;
+			continue;
+		}
+
+		const uint8_t byte = aSrc[pos++];
+
+		if( byte == 0 )
+		{
+			if( previousCode != detail::PREVIOUS_CODE_DICTIONARY )
+			{
+				writer.put( blockCode() );
+
+				pendingMask = DZRCOBS_NEXTCODE_IS_ZERO;
+				isFirstByte = false;
+			}
+
+			code				 = 1;
+			previousCode = detail::PREVIOUS_CODE_ZERO;
+			continue;
+		}
+
+		if( previousCode == detail::PREVIOUS_CODE_ZERO )
+		{
+			pendingMask = DZRCOBS_NEXTCODE_IS_ZERO;
+		}
+		else if( previousCode == detail::PREVIOUS_CODE_DICTIONARY )
+		{
+			pendingMask = DZRCOBS_NEXTCODE_IS_DICTIONARY;
+		}
+
+		writer.put( byte );
+
+		isFirstByte	 = false;
+		previousCode = detail::PREVIOUS_CODE_BLOCK;
+		code++;
+
+		if( code == DZRCOBS_CODE_JUMP )
+		{
+			writer.put( code );
+			code = 1;
+		}
+	}
+
+	if( previousCode != detail::PREVIOUS_CODE_DICTIONARY )
+	{
+		writer.put( blockCode() );
+	}
+
+	const uint8_t encodingByte = (uint8_t)( (uint8_t)( aUser6bits << 2 ) | ( (uint8_t)aEncoding & 0x03 ) );
+	writer.put( encodingByte );
+
+	const uint8_t crc = writer.crc;
+	writer.put( ( crc == 0x00 ) ? DZRCOBS_CRC_VALUE_WHEN_CRC_IS_ZERO : crc );
+
+	return writer.isOverflow ? 0 : writer.pos;
+}
+
+namespace detail
+{
+
+template <auto Frame> consteval auto to_exact_array()
+{
+	static_assert( Frame.size > 0, "The frame could not be encoded, check the arguments" );
+
+	std::array<uint8_t, Frame.size> frame = {};
+
+	for( size_t i = 0; i < Frame.size; i++ )
+	{
+		frame[i] = Frame.data[i];
+	}
+
+	return frame;
+}
+
+template <auto Payload> consteval void check_payload()
+{
+	static_assert( std::is_same_v<typename decltype( Payload )::value_type, uint8_t>,
+								 "The payload must be a std::array<uint8_t, N>" );
+}
+
+template <std::array Payload> consteval auto rcobs_sized_frame()
+{
+	check_payload<Payload>();
+
+	sDZRCOBS_sized_frame<RCOBS_MAX_ENCODED_SIZE( Payload.size() )> frame;
+	frame.size = rcobs_encode( Payload, frame.data );
+
+	return frame;
+}
+
+template <std::array Payload, uint8_t User6bits> consteval auto plain_sized_frame()
+{
+	check_payload<Payload>();
+
+	sDZRCOBS_sized_frame<DZRCOBS_MAX_ENCODED_SIZE( Payload.size() ) + DZRCOBS_FRAME_HEADER_SIZE> frame;
+	frame.size = encode_plain( Payload, User6bits, frame.data );
+
+	return frame;
+}
+
+template <std::array Payload, sDZRCOBS_dictionary_string Dictionary, eDZRCOBS_encoding Encoding, uint8_t User6bits>
+consteval auto dictionary_sized_frame()
+{
+	check_payload<Payload>();
+
+	sDZRCOBS_sized_frame<DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( Payload.size() ) + DZRCOBS_FRAME_HEADER_SIZE> frame;
+	frame.size = encode_dictionary( Payload, Dictionary.words, Encoding, User6bits, frame.data );
+
+	return frame;
+}
+
+} // namespace detail
+
+/// rcobs encoded Payload (a std::array<uint8_t, N>), as a std::array of its exact size
+template <std::array Payload>
+inline constexpr auto rcobs_frame = detail::to_exact_array<detail::rcobs_sized_frame<Payload>()>();
+
+/// DZRCOBS_PLAIN frame of Payload (a std::array<uint8_t, N>), as a std::array of its exact size
+template <std::array Payload, uint8_t User6bits>
+inline constexpr auto plain_frame = detail::to_exact_array<detail::plain_sized_frame<Payload, User6bits>()>();
+
+/// Dictionary encoded frame of Payload (a std::array<uint8_t, N>), as a std::array of its exact size
+template <std::array Payload, sDZRCOBS_dictionary_string Dictionary, eDZRCOBS_encoding Encoding, uint8_t User6bits>
+inline constexpr auto dictionary_frame =
+ detail::to_exact_array<detail::dictionary_sized_frame<Payload, Dictionary, Encoding, User6bits>()>();
+
+} // namespace dzrcobs
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,336 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_cpp.h
+///	@brief C++ encoder and decoder over the C API, the encoding is a template
+///        parameter
+///
+/// Header only, C++17. dzrcobs::Encoder calls the encoding function directly
+/// (no encFunc indirect call). The arguments are references and spans, so
+/// only the destiny room is checked on each add.
+///
+/// @code
+/// dzrcobs::Encoder<DZRCOBS_USING_DICT_1, &G_MY_DictionaryCtx> encoder;
+/// size_t encodedSize = 0;
+///
+/// encoder.encode( payload, buffer, 5, encodedSize );
+/// @endcode
+///
+///	@par  Plataform Target:	Any (C++17)
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZRCOBS_CPP_H_
+#define _DZRCOBS_CPP_H_
+
+#if !defined( __cplusplus ) || ( ( __cplusplus < 201703L ) && ( !defined( _MSVC_LANG ) || ( _MSVC_LANG < 201703L ) ) )
+#error dzrcobs_cpp.h needs C++17
+#endif
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "dzrcobs.h"
+#include "dzrcobs_decode.h"
+
+namespace dzrcobs
+{
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+/// View of contiguous elements, the part of std::span (C++20) used here.
+/// Made from a pointer and a size, an array or a container with data() and size().
+template <typename T> class span
+{
+public:
+	constexpr span() noexcept = default;
+
+	constexpr span( T *aData, size_t aSize ) noexcept : m_data( aData ), m_size( aSize ) {}
+
+	template <size_t N> constexpr span( T ( &aArray )[N] ) noexcept : m_data( aArray ), m_size( N ) {}
+
+	template <typename C,
+						typename = std::enable_if_t<
+						 !std::is_array_v<std::remove_reference_t<C>> &&
+						 std::is_convertible_v<decltype( std::declval<C &>().data() ), T *> &&
+						 std::is_convertible_v<decltype( std::declval<C &>().size() ), size_t>>>
+	constexpr span( C &&aContainer ) noexcept : m_data( aContainer.data() ), m_size( aContainer.size() )
+	{
+	}
+
+	constexpr T *data() const noexcept
+	{
+		return m_data;
+	}
+
+	constexpr size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	constexpr T &operator[]( size_t aIdx ) const noexcept
+	{
+		return m_data[aIdx];
+	}
+
+	constexpr T *begin() const noexcept
+	{
+		return m_data;
+	}
+
+	constexpr T *end() const noexcept
+	{
+		return m_data + m_size;
+	}
+
+private:
+	T *m_data		 = nullptr;
+	size_t m_size = 0;
+};
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Encoder of a single encoding, see Encoder. The dictionary is given
+ *        by Encoder, so it is checked by the specialization it picks.
+ */
+template <eDZRCOBS_encoding Encoding> class EncoderBase
+{
+	static_assert( ( Encoding == DZRCOBS_PLAIN ) || ( Encoding == DZRCOBS_USING_DICT_1 ) ||
+									( Encoding == DZRCOBS_USING_DICT_2 ),
+								 "Encoding must be DZRCOBS_PLAIN, DZRCOBS_USING_DICT_1 or DZRCOBS_USING_DICT_2" );
+
+public:
+
+	/// Destiny size that fits any frame of aSrcSize bytes
+	static constexpr size_t max_encoded_size( size_t aSrcSize ) noexcept
+	{
+		return ( ( Encoding == DZRCOBS_PLAIN ) ? DZRCOBS_MAX_ENCODED_SIZE( aSrcSize )
+																					 : DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( aSrcSize ) ) +
+					 DZRCOBS_FRAME_HEADER_SIZE;
+	}
+
+	/**
+	 * @brief Same as dzrcobs_encode_inc_begin
+	 *
+	 * @param aDst Destiny buffer, kept until end
+	 * @param aUser6bits User application 6 bits, 1..63 (0 is also valid on the
+	 *        dictionary encodings)
+	 */
+	eDZRCOBS_ret begin( span<uint8_t> aDst, uint8_t aUser6bits ) noexcept
+	{
+		if( ( aUser6bits > 0x3F ) || ( ( Encoding == DZRCOBS_PLAIN ) && ( aUser6bits == 0 ) ) )
+		{
+			return DZRCOBS_RET_ERR_BAD_ARG;
+		}
+
+		const eDZRCOBS_ret ret = dzrcobs_encode_inc_begin( &m_ctx, Encoding, aDst.data(), aDst.size() );
+
+		m_ctx.user6bits = aUser6bits;
+
+		return ret;
+	}
+
+	/// Same as dzrcobs_encode_inc, with the encoding called directly
+	eDZRCOBS_ret add( span<const uint8_t> aSrc ) noexcept
+	{
+		assert( m_ctx.encFunc != nullptr ); // begin was called
+
+		if( aSrc.empty() )
+		{
+			return DZRCOBS_RET_SUCCESS;
+		}
+
+		if constexpr( Encoding == DZRCOBS_PLAIN )
+		{
+			const size_t room						= (size_t)( m_ctx.pDstEnd - m_ctx.pCurDst );
+			const size_t maxEncodedSize = DZRCOBS_MAX_ENCODED_SIZE( aSrc.size() );
+
+			if( room < ( DZRCOBS_FRAME_HEADER_SIZE + maxEncodedSize ) )
+			{
+				return DZRCOBS_RET_ERR_OVERFLOW;
+			}
+
+			return dzrcobs_encode_inc_plain( &m_ctx, aSrc.data(), aSrc.size() );
+		}
+		else
+		{
+			// It checks the room on each write
+			return dzrcobs_encode_inc_dictionary( &m_ctx, aSrc.data(), aSrc.size() );
+		}
+	}
+
+	/// Same as dzrcobs_encode_inc_end
+	eDZRCOBS_ret end( size_t &aOutSizeEncoded ) noexcept
+	{
+		return dzrcobs_encode_inc_end( &m_ctx, &aOutSizeEncoded );
+	}
+
+	/// A whole frame, begin, add and end
+	eDZRCOBS_ret encode( span<const uint8_t> aSrc,
+											 span<uint8_t> aDst,
+											 uint8_t aUser6bits,
+											 size_t &aOutSizeEncoded ) noexcept
+	{
+		eDZRCOBS_ret ret = begin( aDst, aUser6bits );
+
+		if( ret == DZRCOBS_RET_SUCCESS )
+		{
+			ret = add( aSrc );
+		}
+
+		if( ret == DZRCOBS_RET_SUCCESS )
+		{
+			ret = end( aOutSizeEncoded );
+		}
+
+		return ret;
+	}
+
+	/// The C context, for the C API (eg: dzrcobs_encode_set_parsing after begin)
+	sDZRCOBS_ctx &ctx() noexcept
+	{
+		return m_ctx;
+	}
+
+	const sDZRCOBS_ctx &ctx() const noexcept
+	{
+		return m_ctx;
+	}
+
+protected:
+	explicit EncoderBase( const sDICT_ctx *aDict ) noexcept : m_ctx()
+	{
+		if constexpr( Encoding != DZRCOBS_PLAIN )
+		{
+			m_ctx.pDict[Encoding - DZRCOBS_USING_DICT_1] = aDict;
+		}
+	}
+
+private:
+	sDZRCOBS_ctx m_ctx;
+};
+
+/**
+ * @brief Encoder of a single encoding. Dict is the dictionary of
+ *        DZRCOBS_USING_DICT_1 / DZRCOBS_USING_DICT_2 (eg: one generated by
+ *        dzrcobs_add_dictionary, or one set by dzrcobs_dictionary_init before
+ *        the first frame), nullptr for DZRCOBS_PLAIN.
+ *        Dict is matched by specialization, not compared: the address of a
+ *        dictionary is not a constant expression with some flags (eg: GCC
+ *        -fsanitize=undefined or -fno-delete-null-pointer-checks).
+ */
+template <eDZRCOBS_encoding Encoding, const sDICT_ctx *Dict = nullptr> class Encoder : public EncoderBase<Encoding>
+{
+	static_assert( Encoding != DZRCOBS_PLAIN, "DZRCOBS_PLAIN does not use Dict" );
+
+public:
+	Encoder() noexcept : EncoderBase<Encoding>( Dict ) {}
+};
+
+/// Without a dictionary, only DZRCOBS_PLAIN
+template <eDZRCOBS_encoding Encoding> class Encoder<Encoding, nullptr> : public EncoderBase<Encoding>
+{
+	static_assert( Encoding == DZRCOBS_PLAIN, "The dictionary encodings need Dict" );
+
+public:
+	Encoder() noexcept : EncoderBase<Encoding>( nullptr ) {}
+};
+
+/**
+ * @brief Decoder of all the encodings. The encoding is on each frame, so the
+ *        dictionaries of both dictionary encodings may be given.
+ */
+class Decoder
+{
+public:
+	explicit Decoder( const sDICT_ctx *aDict1 = nullptr, const sDICT_ctx *aDict2 = nullptr ) noexcept : m_ctx()
+	{
+		m_ctx.pDict[0] = aDict1;
+		m_ctx.pDict[1] = aDict2;
+	}
+
+	/**
+	 * @brief Same as dzrcobs_decode, the decoded data is right aligned on aDst
+	 *
+	 * @param aEncoded Frame, without the 0x00 delimiter
+	 * @param aDst Destiny buffer
+	 * @param aOutDecoded The decoded data, inside aDst
+	 * @param aOutUser6bits User application 6 bits of the frame
+	 */
+	eDZRCOBS_ret decode( span<const uint8_t> aEncoded,
+											 span<uint8_t> aDst,
+											 span<uint8_t> &aOutDecoded,
+											 uint8_t &aOutUser6bits ) noexcept
+	{
+		set_buffers( aEncoded, aDst );
+
+		size_t decodedLen		= 0;
+		uint8_t *pDecoded		= nullptr;
+		const eDZRCOBS_ret ret = dzrcobs_decode( &m_ctx, &decodedLen, &pDecoded, &aOutUser6bits );
+
+		aOutDecoded = ( ret == DZRCOBS_RET_SUCCESS ) ? span<uint8_t>( pDecoded, decodedLen ) : span<uint8_t>();
+
+		return ret;
+	}
+
+	/// Same as dzrcobs_decode_left_aligned, the decoded data starts at aDst[0]
+	eDZRCOBS_ret decode_left_aligned( span<const uint8_t> aEncoded,
+																		span<uint8_t> aDst,
+																		span<uint8_t> &aOutDecoded,
+																		uint8_t &aOutUser6bits ) noexcept
+	{
+		set_buffers( aEncoded, aDst );
+
+		size_t decodedLen		= 0;
+		const eDZRCOBS_ret ret = dzrcobs_decode_left_aligned( &m_ctx, &decodedLen, &aOutUser6bits );
+
+		aOutDecoded = ( ret == DZRCOBS_RET_SUCCESS ) ? span<uint8_t>( aDst.data(), decodedLen ) : span<uint8_t>();
+
+		return ret;
+	}
+
+	/// The C context of the last decode, for the C API
+	sDZRCOBS_decodectx &ctx() noexcept
+	{
+		return m_ctx;
+	}
+
+	const sDZRCOBS_decodectx &ctx() const noexcept
+	{
+		return m_ctx;
+	}
+
+private:
+	void set_buffers( span<const uint8_t> aEncoded, span<uint8_t> aDst ) noexcept
+	{
+		m_ctx.srcBufEncoded			= aEncoded.data();
+		m_ctx.srcBufEncodedLen	= aEncoded.size();
+		m_ctx.dstBufDecoded			= aDst.data();
+		m_ctx.dstBufDecodedSize = aDst.size();
+	}
+
+	sDZRCOBS_decodectx m_ctx;
+};
+
+} // namespace dzrcobs
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -41,6 +41,15 @@ typedef struct s_DZRCOB_decodectx
 	const sDICT_ctx *pDict[DZRCOBS_DICT_N];
 } sDZRCOBS_decodectx;
 
+/// Result of a frame of dzrcobs_decode_batch
+typedef struct s_DZRCOBS_batch_result
+{
+	size_t offset;			 ///< Start of the decoded data on dstBufDecoded
+	size_t length;			 ///< Size of the decoded data, 0 if the frame failed
+	uint8_t user6bits;	 ///< user application 6 bits of the frame
+	eDZRCOBS_ret status; ///< Result of this frame
+} sDZRCOBS_batch_result;
+
 /**
  * @brief Decodes a source encoded buffer. It will place the decoded data
  *        right aligned with the dstBufDecoded.
@@ -48,6 +57,16 @@ typedef struct s_DZRCOB_decodectx
  *        Data ends dstBufDecoded[dstBufEncodedSize - 1]
  *        It implicit assumes that the encoded data ends with a 0,
  *        so srcBufEncoded[srcBufEncodedLen] == 0 (implicit)
+ *        In-place: srcBufEncoded may be inside dstBufDecoded, if the frame
+ *        does not end after the end of dstBufDecoded (eg: both the same
+ *        buffer). Plain frames always fit. Dictionary frames need
+ *        dzrcobs_decode_inplace_headroom bytes after the end of the frame,
+ *        otherwise it fails with RCOBS_RET_ERR_OVERFLOW.
+ *        The encoded data is lost when decoding in-place.
+ *        The bytes of dstBufDecoded before the decoded data are scratch: with
+ *        DZRCOBS_DICT_ACCELERATOR the words are copied 8 bytes at a time, and
+ *        up to 7 bytes before aOutDecodedStartPos may be changed. Nothing is
+ *        written outside dstBufDecoded.
  *
  * @param aDecodeCtx Struct with variables prepared to decode.
  * @param aOutDecodedLen Size of decoded data
@@ -56,7 +75,8 @@ typedef struct s_DZRCOB_decodectx
  * the package. Right aligned
  * (between &dstBufDecoded[0] and &dstBufDecoded[dstBufEncodedSize - 1])
  * @retval RCOBS_RET_SUCCESS if decoded is ok
- * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed, or if
+ * dstBufDecoded overlaps the frame and ends before the end of it
  * @retval RCOBS_RET_ERR_OVERFLOW if it overflows the destiny buffer
  * @retval RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if some invalid value (eg: 0x00)
  */
@@ -65,6 +85,89 @@ eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 														 uint8_t **aOutDecodedStartPos,
 														 uint8_t *aOutUser6bitDataRightAlgn );
 
+/**
+ * @brief Computes the headroom needed to decode a frame in-place.
+ *        Dictionary words are larger than their tokens, so the decoded data
+ *        may reach the encoded bytes not read yet. As the decoded data is
+ *        right aligned, dstBufDecoded must end aOutHeadroom bytes (or more)
+ *        after the end of the frame, eg: dstBufDecoded = srcBufEncoded and
+ *        dstBufDecodedSize = srcBufEncodedLen + aOutHeadroom.
+ *        Only the codes are walked, the CRC and the data are not checked.
+ *
+ * @param aDecodeCtx srcBufEncoded, srcBufEncodedLen and pDict are used
+ * @param aOutHeadroom Bytes that dstBufDecoded must extend after the end of
+ * the frame, the most that the decoded bytes get ahead of the encoded bytes
+ * read. 0 for plain frames
+ * @retval RCOBS_RET_SUCCESS if the headroom was computed
+ * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if some invalid code
+ * @retval RCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE if the dictionary is not set
+ * @retval RCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY if a token is not valid
+ */
+eDZRCOBS_ret dzrcobs_decode_inplace_headroom( const sDZRCOBS_decodectx *aDecodeCtx, size_t *aOutHeadroom );
+
+/**
+ * @brief Computes the size that a frame decodes to.
+ *        Only the codes are walked, the CRC and the data are not checked.
+ *
+ * @param aDecodeCtx srcBufEncoded, srcBufEncodedLen and pDict are used
+ * @param aOutDecodedLen Size of decoded data
+ * @retval RCOBS_RET_SUCCESS if the size was computed
+ * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if some invalid code
+ * @retval RCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE if the dictionary is not set
+ * @retval RCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY if a token is not valid
+ */
+eDZRCOBS_ret dzrcobs_decoded_size( const sDZRCOBS_decodectx *aDecodeCtx, size_t *aOutDecodedLen );
+
+/**
+ * @brief Same as dzrcobs_decode, but the decoded data starts at
+ *        dstBufDecoded[0], so the caller chooses its alignment.
+ *        The size is computed first (see dzrcobs_decoded_size), it costs a
+ *        walk over the codes, not over the data.
+ *        It does not decode in-place.
+ *
+ * @param aDecodeCtx Struct with variables prepared to decode.
+ * @param aOutDecodedLen Size of decoded data
+ * @param uint8_t *aOutUser6bitDataRightAlgn The 6 bit user data that arrived in
+ * the package. Right aligned
+ * @retval RCOBS_RET_SUCCESS if decoded is ok
+ * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval RCOBS_RET_ERR_CRC if the CRC does not match
+ * @retval RCOBS_RET_ERR_OVERFLOW if it overflows the destiny buffer
+ * @retval RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if some invalid value (eg: 0x00)
+ */
+eDZRCOBS_ret dzrcobs_decode_left_aligned( const sDZRCOBS_decodectx *aDecodeCtx,
+																					size_t *aOutDecodedLen,
+																					uint8_t *aOutUser6bitDataRightAlgn );
+
+/**
+ * @brief Decodes all the 0x00 delimited frames of a buffer (eg: a socket read)
+ *        into an arena. The decoded data of the frames is placed back to back,
+ *        from dstBufDecoded[0], each one left aligned.
+ *        A frame that fails does not stop the batch, its status is on its
+ *        result and it takes no room on the arena. Empty frames (consecutive
+ *        delimiters) are skipped. The bytes after the last delimiter are a
+ *        frame not complete yet, they are not consumed.
+ *        The arena must not overlap the frames buffer.
+ *
+ * @param aDecodeCtx srcBufEncoded and srcBufEncodedLen are the frames buffer,
+ *        dstBufDecoded and dstBufDecodedSize the arena, pDict are used by all
+ *        the frames
+ * @param aOutResults Array for the results, one per frame
+ * @param aResultsSize Entries of aOutResults. The batch stops when it is full.
+ * @param aOutResultsCount Number of results written
+ * @param aOutConsumed Bytes of the frames buffer handled (delimiters included),
+ *        the next batch continues from there
+ * @retval RCOBS_RET_SUCCESS if the buffer was handled, see each result status
+ * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ */
+eDZRCOBS_ret dzrcobs_decode_batch( const sDZRCOBS_decodectx *aDecodeCtx,
+																	 sDZRCOBS_batch_result *aOutResults,
+																	 size_t aResultsSize,
+																	 size_t *aOutResultsCount,
+																	 size_t *aOutConsumed );
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,19 @@ typedef enum e_DICTVALID_ret
 } eDICTVALID_ret;
 
 #define DICT_MAX_DIFFERENTWORDSIZES ( 4 )
+#define DICT_MAX_WORD_SIZE ( 5 )
+
+// Set DZRCOBS_DICT_ACCELERATOR to 0 to remove the lookup tables from sDICT_ctx
+// (saves ~1.8 KiB per dictionary, dzrcobs_dictionary_search will be slower,
+// and dzrcobs_decode copies the words from the dictionary, byte by byte)
+#ifndef DZRCOBS_DICT_ACCELERATOR
+#define DZRCOBS_DICT_ACCELERATOR 1
+#endif
+
+#define DICT_ACCEL_BUCKETS ( 64 )
+#define DICT_ACCEL_SLOTS ( 256 )
+#define DICT_MAX_WORDS ( 126 )
+#define DICT_FLAT_WORD_SIZE ( 8 )
 
 /// Dictionary entry for different word sizes
 typedef struct s_DICT_wordentry
@@ -56,11 +69,41 @@ typedef struct s_DICT_wordentry
 	uint8_t strideSize;							///< word size + 1, that is the size of each word entry
 } sDICT_wordentry;
 
+#if DZRCOBS_DICT_ACCELERATOR
+/// Lookup tables built by dzrcobs_dictionary_init
+typedef struct s_DICT_accel
+{
+	uint8_t firstByteTiers[256];							///< Bit i set if wordSizeTable[i] has a word starting with this byte
+	uint8_t displacement[DICT_ACCEL_BUCKETS]; ///< Perfect hash displacement of each bucket
+	uint8_t slots[DICT_ACCEL_SLOTS];					///< Global index (1..126) of the word on each slot, 0 if empty
+	///< Candidate filter on the first two bytes of the words, Teddy style.
+	///< For byte 0 low and high nibble and byte 1 low and high nibble,
+	///< the set of buckets (one bit each) that have words with that nibble.
+	uint8_t pairNibbleMasks[4][16];
+	///< Words by index (0..125), right aligned (last byte at [7]), for the decoder
+	uint8_t flatWords[DICT_MAX_WORDS][DICT_FLAT_WORD_SIZE];
+	uint8_t flatWordSize[DICT_MAX_WORDS]; ///< Size of each flatWords entry, 0 if the index is not used
+	uint8_t seed;															///< Seed of the perfect hash
+	uint8_t isHashed; ///< 0 if no perfect hash was found, the binary search is then used
+} sDICT_accel;
+#endif
+
+/// Search specialized for a dictionary, same results as dzrcobs_dictionary_search
+typedef uint8_t ( *dzrcobs_dictionary_search_funcPtr )( const uint8_t *aSearchKey,
+																												size_t aSearchKeySize,
+																												size_t *aOutKeySizeFound );
+
 typedef struct s_DICT_ctx
 {
 	sDICT_wordentry wordSizeTable[DICT_MAX_DIFFERENTWORDSIZES];
 	uint8_t minWordSize;
 	uint8_t maxWordSize;
+	///< Generated by dzrcobs_add_dictionary (see cmake/DzrcobsDictionary.cmake),
+	///< used by dzrcobs_dictionary_search. NULL after dzrcobs_dictionary_init.
+	dzrcobs_dictionary_search_funcPtr searchFunc;
+#if DZRCOBS_DICT_ACCELERATOR
+	sDICT_accel accel;
+#endif
 } sDICT_ctx;
 
 typedef enum e_DICT_ret
@@ -114,6 +157,18 @@ uint8_t dzrcobs_dictionary_search( const sDICT_ctx *aCtx,
 																	 size_t aSearchKeySize,
 																	 size_t *aOutKeySizeFound );
 
+/**
+ * @brief Search for the word of a given size that starts a key. Unlike
+ *        dzrcobs_dictionary_search, a shorter word that also matches is not
+ *        returned.
+ *
+ * @param aCtx The context to be used
+ * @param aSearchKey The key buffer data, with at least aWordSize bytes
+ * @param aWordSize The word size to search (2..5)
+ * @return uint8_t 0 not found, 1..126 index of the key found (1 index based)
+ */
+uint8_t dzrcobs_dictionary_search_size( const sDICT_ctx *aCtx, const uint8_t *aSearchKey, size_t aWordSize );
+
 /**
  * @brief Gets a word pointer and size, based on aIndex
  *
@@ -0,0 +1,117 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_framer.h
+///	@brief Splits a continuous byte stream in 0x00 delimited frames
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZRCOBS_FRAMER_H_
+#define _DZRCOBS_FRAMER_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+typedef enum e_DZRCOBS_framer_ret
+{
+	DZRCOBS_FRAMER_RET_FRAME = 0,			 ///< A frame is returned
+	DZRCOBS_FRAMER_RET_NEED_DATA,			 ///< The fed chunk is consumed, feed the next one
+	DZRCOBS_FRAMER_RET_ERR_BAD_ARG,		 ///< Invalid arguments
+	DZRCOBS_FRAMER_RET_ERR_BUSY,			 ///< The previous chunk is not consumed yet
+	DZRCOBS_FRAMER_RET_ERR_OVERSIZE, ///< A frame larger than the buffer was dropped
+} eDZRCOBS_framer_ret;
+
+typedef struct s_DZRCOBS_framer
+{
+	uint8_t *pBuf;				 ///< Caller buffer, holds a frame split across chunks
+	size_t bufSize;				 ///< Size of pBuf, also the max frame size accepted
+	size_t bufLen;				 ///< Bytes of the partial frame on pBuf
+	const uint8_t *pChunk; ///< Remaining of the chunk being consumed
+	size_t chunkLen;			 ///< Bytes remaining on pChunk
+	bool isDiscarding;		 ///< Dropping bytes until the next delimiter
+} sDZRCOBS_framer;
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initialize a framer context
+ *
+ * @param aCtx Context to be initialized
+ * @param aBuf Buffer to hold a frame that is split across chunks
+ * @param aBufSize Size of aBuf. Frames larger than this are dropped.
+ * @retval DZRCOBS_FRAMER_RET_NEED_DATA ready to be fed
+ * @retval DZRCOBS_FRAMER_RET_ERR_BAD_ARG if invalid arguments are passed
+ */
+eDZRCOBS_framer_ret dzrcobs_framer_init( sDZRCOBS_framer *aCtx, uint8_t *aBuf, size_t aBufSize );
+
+/**
+ * @brief Gives the next chunk of the stream (any size, eg: from read() or DMA)
+ *        The chunk must remain valid until dzrcobs_framer_pop returns
+ *        DZRCOBS_FRAMER_RET_NEED_DATA.
+ *
+ * @param aCtx Context in use
+ * @param aChunk Chunk of the stream
+ * @param aChunkLen Size of the chunk
+ * @retval DZRCOBS_FRAMER_RET_NEED_DATA if the chunk was accepted
+ * @retval DZRCOBS_FRAMER_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval DZRCOBS_FRAMER_RET_ERR_BUSY if the previous chunk is not consumed
+ */
+eDZRCOBS_framer_ret dzrcobs_framer_feed( sDZRCOBS_framer *aCtx, const uint8_t *aChunk, size_t aChunkLen );
+
+/**
+ * @brief Gets the next complete frame, without the 0x00 delimiter.
+ *        Call it until it returns DZRCOBS_FRAMER_RET_NEED_DATA.
+ *        A frame that is all inside the chunk is returned as a view of
+ *        the chunk (no copy), otherwise as a view of the framer buffer.
+ *        The view is valid until the next call of dzrcobs_framer_pop,
+ *        dzrcobs_framer_feed or dzrcobs_framer_resync.
+ *        Empty frames (consecutive delimiters) are skipped.
+ *
+ * @param aCtx Context in use
+ * @param aOutFrame Start of the frame
+ * @param aOutFrameLen Size of the frame
+ * @retval DZRCOBS_FRAMER_RET_FRAME if a frame is returned
+ * @retval DZRCOBS_FRAMER_RET_NEED_DATA if the chunk is consumed
+ * @retval DZRCOBS_FRAMER_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval DZRCOBS_FRAMER_RET_ERR_OVERSIZE if a frame was larger than the
+ * buffer. It is reported once, the bytes until the next delimiter are dropped.
+ */
+eDZRCOBS_framer_ret dzrcobs_framer_pop( sDZRCOBS_framer *aCtx, const uint8_t **aOutFrame, size_t *aOutFrameLen );
+
+/**
+ * @brief Drops the partial frame and the bytes until the next delimiter.
+ *        To be used when the stream is known to be broken (eg: UART error)
+ *        or when joining a stream in the middle.
+ *
+ * @param aCtx Context in use
+ */
+void dzrcobs_framer_resync( sDZRCOBS_framer *aCtx );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -94,6 +94,9 @@ eRCOBS_ret rcobs_encode_inc_end( sRCOBS_ctx *aCtx, size_t *aOutSizeEncoded );
  *        Data ends aDstBufDecoded[aDstBufEncodedSize - 1]
  *        It implicit assumes that the encoded data ends with a 0,
  *        so aSrcBufEncoded[aSrcBufEncodedLen] == 0 (implicit)
+ *        In-place: aSrcBufEncoded may be inside aDstBufDecoded, if it does
+ *        not end after the end of aDstBufDecoded (eg: both the same buffer).
+ *        The encoded data is lost when decoding in-place.
  *
  * @param aSrcBufEncoded Source buffer encoded
  * @param aSrcBufEncodedLen Source buffer encoded data length
@@ -103,7 +106,8 @@ eRCOBS_ret rcobs_encode_inc_end( sRCOBS_ctx *aCtx, size_t *aOutSizeEncoded );
  * @param aOutDecodedStartPos Start position of the decoded data
  * (between &aDstBufDecoded[0] and &aDstBufDecoded[aDstBufEncodedSize - 1])
  * @retval RCOBS_RET_SUCCESS if decoded is ok
- * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed, or if
+ * aDstBufDecoded overlaps aSrcBufEncoded and ends before the end of it
  * @retval RCOBS_RET_ERR_OVERFLOW if it overflows the destiny buffer
  * @retval RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if some invalid value (eg: 0x00)
  */
@@ -114,6 +118,42 @@ eRCOBS_ret rcobs_decode( const uint8_t *aSrcBufEncoded,
 												 size_t *aOutDecodedLen,
 												 uint8_t **aOutDecodedStartPos );
 
+/**
+ * @brief Computes the size that a source encoded buffer decodes to.
+ *        Only the codes are walked, the data is not checked.
+ *
+ * @param aSrcBufEncoded Source buffer encoded
+ * @param aSrcBufEncodedLen Source buffer encoded data length
+ * @param aOutDecodedLen Size of decoded data
+ * @retval RCOBS_RET_SUCCESS if the size was computed
+ * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if some invalid code
+ */
+eRCOBS_ret rcobs_decoded_size( const uint8_t *aSrcBufEncoded, size_t aSrcBufEncodedLen, size_t *aOutDecodedLen );
+
+/**
+ * @brief Same as rcobs_decode, but the decoded data starts at
+ *        aDstBufDecoded[0], so the caller chooses its alignment.
+ *        The size is computed first (see rcobs_decoded_size), it costs a
+ *        walk over the codes, not over the data.
+ *        It does not decode in-place.
+ *
+ * @param aSrcBufEncoded Source buffer encoded
+ * @param aSrcBufEncodedLen Source buffer encoded data length
+ * @param aDstBufDecoded Destiny buffer
+ * @param aDstBufDecodedSize Max buffer size
+ * @param aOutDecodedLen Size of decoded data
+ * @retval RCOBS_RET_SUCCESS if decoded is ok
+ * @retval RCOBS_RET_ERR_BAD_ARG if invalid arguments are passed
+ * @retval RCOBS_RET_ERR_OVERFLOW if it overflows the destiny buffer
+ * @retval RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD if some invalid value (eg: 0x00)
+ */
+eRCOBS_ret rcobs_decode_left_aligned( const uint8_t *aSrcBufEncoded,
+																			size_t aSrcBufEncodedLen,
+																			uint8_t *aDstBufDecoded,
+																			size_t aDstBufDecodedSize,
+																			size_t *aOutDecodedLen );
+
 #ifdef __cplusplus
 }
 #endif
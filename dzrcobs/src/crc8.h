@@ -18,25 +18,106 @@
 
 // Includes
 // /////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
 #include <stdint.h>
+#include "dzrcobs_simd.h"
 
 // Definitions
 // /////////////////////////////////////////////////////////////////////////////
+
+// CRC8 0xA6 backends, selected at build time with DZRCOBS_CRC_TABLE:
+// 1 - 256 bytes table, one lookup per byte (default)
+// 2 - Slicing-by-8, 8 x 256 bytes tables, 8 independent lookups per 8 bytes
+// 3 - Carry-less multiply (x86-64 PCLMULQDQ) Barrett reduction per 8 bytes
+// 4 - 16 entries nibble table, for cache / flash constrained targets
+#define DZRCOBS_CRC_TABLE_BYTE ( 1 )
+#define DZRCOBS_CRC_TABLE_SLICING8 ( 2 )
+#define DZRCOBS_CRC_TABLE_CLMUL ( 3 )
+#define DZRCOBS_CRC_TABLE_NIBBLE ( 4 )
+
 #ifndef DZRCOBS_CRC_TABLE
-#define DZRCOBS_CRC_TABLE 1
+#define DZRCOBS_CRC_TABLE DZRCOBS_CRC_TABLE_BYTE
+#endif
+
+// With DZRCOBS_SIMD_DISPATCH the carry-less multiply backend does not need
+// -mpclmul: it is built with a target attribute and chosen at runtime with the
+// scan kernels, when the level is not scalar and the CPU has PCLMULQDQ.
+// Else slicing-by-8 is used, on the same tables.
+#if( DZRCOBS_CRC_TABLE == DZRCOBS_CRC_TABLE_CLMUL ) && DZRCOBS_SIMD_DISPATCH && \
+ ( defined( __x86_64__ ) || defined( _M_X64 ) )
+#define DZRCOBS_CRC_DISPATCH 1
+#else
+#define DZRCOBS_CRC_DISPATCH 0
 #endif
 
 #define DZRCOBS_CRC_INIT_VAL ( 0xFF )
 
 // Declarations
 // /////////////////////////////////////////////////////////////////////////////
-#if DZRCOBS_CRC_TABLE == 1
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+#if( DZRCOBS_CRC_TABLE == DZRCOBS_CRC_TABLE_BYTE ) || ( DZRCOBS_CRC_TABLE == DZRCOBS_CRC_TABLE_SLICING8 ) || \
+ ( DZRCOBS_CRC_TABLE == DZRCOBS_CRC_TABLE_CLMUL )
 extern const uint8_t G_CRC8_0xA6[256];
 #define DZRCOBS_CRC( crc, newbyte ) G_CRC8_0xA6[(uint8_t)( (uint8_t)( crc ) ^ (uint8_t)( newbyte ) )]
+#elif DZRCOBS_CRC_TABLE == DZRCOBS_CRC_TABLE_NIBBLE
+extern const uint8_t G_CRC8_0xA6_NIBBLE[16];
+
+static inline uint8_t dzrcobs_crc8_nibble( uint8_t aCrc, uint8_t aNewByte )
+{
+	uint8_t crc = (uint8_t)( aCrc ^ aNewByte );
+
+	crc = (uint8_t)( (uint8_t)( crc << 4 ) ^ G_CRC8_0xA6_NIBBLE[crc >> 4] );
+	crc = (uint8_t)( (uint8_t)( crc << 4 ) ^ G_CRC8_0xA6_NIBBLE[crc >> 4] );
+
+	return crc;
+}
+
+#define DZRCOBS_CRC( crc, newbyte ) dzrcobs_crc8_nibble( (uint8_t)( crc ), (uint8_t)( newbyte ) )
 #else
 #error No CRC mode defined. Define: DZRCOBS_CRC_TABLE
 #endif
 
+#if( DZRCOBS_CRC_TABLE == DZRCOBS_CRC_TABLE_SLICING8 ) || ( DZRCOBS_CRC_TABLE == DZRCOBS_CRC_TABLE_CLMUL )
+/// G_CRC8_0xA6_SLICE[k - 1][x] is the CRC of byte x followed by k zero bytes
+extern const uint8_t G_CRC8_0xA6_SLICE[7][256];
+#endif
+
+/**
+ * @brief Continues a CRC8 0xA6 over a buffer, using the selected backend
+ *
+ * @param aCrc Current CRC value (DZRCOBS_CRC_INIT_VAL to start)
+ * @param aBuf Buffer with the data
+ * @param aSize Size of the buffer
+ * @return uint8_t The CRC updated with all aSize bytes, same as calling DZRCOBS_CRC for each byte
+ */
+uint8_t dzrcobs_crc8_block( uint8_t aCrc, const uint8_t *aBuf, size_t aSize );
+
+#if DZRCOBS_CRC_DISPATCH
+/// dzrcobs_crc8_block backends, same arguments and result
+uint8_t dzrcobs_crc8_block_slicing8( uint8_t aCrc, const uint8_t *aBuf, size_t aSize );
+uint8_t dzrcobs_crc8_block_clmul( uint8_t aCrc, const uint8_t *aBuf, size_t aSize );
+
+/**
+ * @brief dzrcobs_crc8_block with the backend chosen for the SIMD level in use
+ *        (implemented on dzrcobs_simd.c)
+ */
+uint8_t dzrcobs_simd_crc8_block( uint8_t aCrc, const uint8_t *aBuf, size_t aSize );
+
+#define DZRCOBS_CRC_BLOCK( crc, buf, size ) dzrcobs_simd_crc8_block( ( crc ), ( buf ), ( size ) )
+#else
+#define DZRCOBS_CRC_BLOCK( crc, buf, size ) dzrcobs_crc8_block( ( crc ), ( buf ), ( size ) )
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
 
 // EOF
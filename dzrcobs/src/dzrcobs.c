@@ -18,22 +18,138 @@
 // /////////////////////////////////////////////////////////////////////////////
 #include <dzrcobs/dzrcobs.h>
 #include <stdbool.h>
+#include <string.h>
 #include "crc8.h"
 #include "dzrcobs/dzrcobs_dictionary.h"
 #include "dzrcobs_assert.h"
+#include "dzrcobs_simd.h"
 
 // Definitions
 // /////////////////////////////////////////////////////////////////////////////
-eDZRCOBS_ret dzrcobs_encode_inc_plain( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
-eDZRCOBS_ret dzrcobs_encode_inc_dictionary( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize );
+static eDZRCOBS_ret dzrcobs_encode_dictionary_until( sDZRCOBS_ctx *aCtx,
+																										 const sDICT_ctx *pDict,
+																										 const uint8_t *aSrcBuf,
+																										 size_t aSrcBufSize,
+																										 size_t aStopAt,
+																										 size_t *aOutConsumed );
 
 #define DZRCOBS_PREVIOUS_CODE_BLOCK ( 0x00 )
 #define DZRCOBS_PREVIOUS_CODE_DICTIONARY ( 0x01 )
 #define DZRCOBS_PREVIOUS_CODE_ZERO ( 0x02 )
+#define DZRCOBS_PREVIOUS_CODE_N ( 3 )
+
+// Source bytes counted by all the encodings at a time on dzrcobs_encode_auto
+#define DZRCOBS_AUTO_BLOCK_SIZE ( 256 )
+
+#if DZRCOBS_OPTIMAL_PARSING
+#define DZRCOBS_OPTIMAL_COST_NONE ( 0xFFFF )
+
+// Words of each size found on the last DZRCOBS_OPTIMAL_WINDOW positions, so
+// each position is searched once while the window moves
+typedef struct s_DZRCOBS_match_cache
+{
+	uint8_t idx[DZRCOBS_OPTIMAL_WINDOW][DICT_MAX_DIFFERENTWORDSIZES]; ///< 0 or the word index (1 based) of size i + 2
+	size_t searchedEnd; ///< Positions (from the start of the source) already searched
+} sDZRCOBS_match_cache;
+#endif
+
+// Encoded size of a frame on a dictionary encoding, counted by dzrcobs_encode_auto
+typedef struct s_DZRCOBS_size_state
+{
+	size_t size;		///< Bytes that would be written, without the frame tail
+	size_t nextPos; ///< Next source position to encode
+	uint8_t code;
+	uint8_t previousCode;
+	bool isFirstByteInTheBuffer;
+#if DZRCOBS_DICT_ACCELERATOR
+	size_t noCandidateCount; ///< Positions ahead that cannot start a dictionary word
+#endif
+} sDZRCOBS_size_state;
 
 // Implementation
 // /////////////////////////////////////////////////////////////////////////////
 
+// Code that terminates a block. An empty block is a single 0x01, except right
+// after a jump code, where it carries what precedes the block split by the jump.
+static inline uint8_t dzrcobs_block_code( const sDZRCOBS_ctx *aCtx, uint8_t aCode )
+{
+	if( ( aCode == 1 ) && ( aCtx->previousCode != DZRCOBS_PREVIOUS_CODE_BLOCK ) )
+	{
+		return 0x01;
+	}
+
+	return (uint8_t)( aCode | aCtx->pendingMask );
+}
+
+// Sets the state to start a new frame at aDstBuf
+static void dzrcobs_encode_frame_init( sDZRCOBS_ctx *aCtx, uint8_t *aDstBuf, size_t aDstBufSize )
+{
+	aCtx->pDst		= aDstBuf;
+	aCtx->pCurDst = aDstBuf;
+	aCtx->pDstEnd = aDstBuf + aDstBufSize;
+	aCtx->code		= 1;
+	aCtx->crc			= DZRCOBS_CRC_INIT_VAL;
+
+	aCtx->previousCode = DZRCOBS_PREVIOUS_CODE_ZERO;
+	aCtx->pendingMask	 = DZRCOBS_NEXTCODE_IS_ZERO;
+
+	aCtx->isFirstByteInTheBuffer = true;
+#if DZRCOBS_OPTIMAL_PARSING
+	aCtx->isOptimalParsing = false;
+#endif
+
+	aCtx->carryLen = 0;
+
+	DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter = 0 );
+}
+
+static inline bool dzrcobs_is_last_code_needed( const sDZRCOBS_ctx *aCtx )
+{
+	return ( aCtx->encoding == DZRCOBS_PLAIN ) || ( aCtx->previousCode != DZRCOBS_PREVIOUS_CODE_DICTIONARY );
+}
+
+// Bytes written by dzrcobs_encode_frame_tail
+static inline size_t dzrcobs_encode_frame_tail_size( const sDZRCOBS_ctx *aCtx )
+{
+	return ( dzrcobs_is_last_code_needed( aCtx ) ? 1 : 0 ) + DZRCOBS_FRAME_HEADER_SIZE;
+}
+
+// Writes the last code, the encoding byte and the CRC. The room must be checked by the caller.
+static void dzrcobs_encode_frame_tail( sDZRCOBS_ctx *aCtx )
+{
+	// Add last tracked zero code
+	if( dzrcobs_is_last_code_needed( aCtx ) )
+	{
+		DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
+
+		const uint8_t curCode = dzrcobs_block_code( aCtx, aCtx->code );
+
+		aCtx->crc = DZRCOBS_CRC( aCtx->crc, curCode );
+
+		*aCtx->pCurDst++ = curCode;
+	}
+
+	// Add (tail) header info
+	const uint8_t encodingByte = (uint8_t)( aCtx->user6bits << 2 ) | ( (uint8_t)aCtx->encoding & 0x03 );
+
+	DZRCOBS_ASSERT( encodingByte != 0 );
+
+	aCtx->crc = DZRCOBS_CRC( aCtx->crc, encodingByte );
+
+	DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
+	*aCtx->pCurDst++ = encodingByte;
+
+	const uint8_t finalCrc = aCtx->crc;
+
+	DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
+	*aCtx->pCurDst++ = ( finalCrc == 0x00 ) ? DZRCOBS_CRC_VALUE_WHEN_CRC_IS_ZERO : finalCrc; // Avoid zero ending CRC.
+}
+
+static inline bool dzrcobs_has_room( const uint8_t *aCurDst, const uint8_t *aDstLimit, size_t aSize )
+{
+	return ( aCurDst <= aDstLimit ) && ( (size_t)( aDstLimit - aCurDst ) >= aSize );
+}
+
 eDZRCOBS_ret dzrcobs_encode_set_dictionary( sDZRCOBS_ctx *aCtx,
 																						const sDICT_ctx *aDictCtx,
 																						eDZRCOBS_encoding aDictEncoding )
@@ -66,19 +182,9 @@ eDZRCOBS_ret dzrcobs_encode_inc_begin( sDZRCOBS_ctx *aCtx,
 		return DZRCOBS_RET_ERR_BAD_ARG;
 	}
 
-	aCtx->pDst		 = aDstBuf;
-	aCtx->pCurDst	 = aDstBuf;
-	aCtx->pDstEnd	 = aDstBuf + aDstBufSize;
-	aCtx->code		 = 1;
-	aCtx->crc			 = DZRCOBS_CRC_INIT_VAL;
 	aCtx->encoding = aEncoding;
 
-	aCtx->previousCode = DZRCOBS_PREVIOUS_CODE_ZERO;
-	aCtx->pendingMask	 = DZRCOBS_NEXTCODE_IS_ZERO;
-
-	aCtx->isFirstByteInTheBuffer = true;
-
-	DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter = 0 );
+	dzrcobs_encode_frame_init( aCtx, aDstBuf, aDstBufSize );
 
 	switch( aEncoding )
 	{
@@ -101,44 +207,77 @@ eDZRCOBS_ret dzrcobs_encode_inc_begin( sDZRCOBS_ctx *aCtx,
 	return DZRCOBS_RET_SUCCESS;
 }
 
-eDZRCOBS_ret dzrcobs_encode_inc_end( sDZRCOBS_ctx *aCtx, size_t *aOutSizeEncoded )
+eDZRCOBS_ret dzrcobs_encode_set_parsing( sDZRCOBS_ctx *aCtx, eDZRCOBS_parsing aParsing )
 {
-	if( ( !aCtx ) || ( !aOutSizeEncoded ) )
+	if( ( !aCtx ) || ( ( aParsing != DZRCOBS_PARSING_GREEDY ) && ( aParsing != DZRCOBS_PARSING_OPTIMAL ) ) )
 	{
 		return DZRCOBS_RET_ERR_BAD_ARG;
 	}
 
-	if( ( aCtx->pCurDst + 1 ) > aCtx->pDstEnd )
+	if( aCtx->encFunc == NULL )
 	{
-		return DZRCOBS_RET_ERR_OVERFLOW;
+		return DZRCOBS_RET_ERR_NOTINITIALIZED;
 	}
 
-	// Add last tracked zero code
-	if( ( aCtx->encoding == DZRCOBS_PLAIN ) || ( aCtx->previousCode != DZRCOBS_PREVIOUS_CODE_DICTIONARY ) )
+	// The lookahead held between calls depends on it
+	if( ( aCtx->pCurDst != aCtx->pDst ) || ( aCtx->carryLen > 0 ) )
 	{
-		DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
 
-		const uint8_t curCode = ( aCtx->code == 1 ) ? 0x01 : ( aCtx->code | aCtx->pendingMask );
+#if DZRCOBS_OPTIMAL_PARSING
+	aCtx->isOptimalParsing = ( aParsing == DZRCOBS_PARSING_OPTIMAL );
+#else
+	// Not built, see DZRCOBS_OPTIMAL_PARSING
+	if( aParsing == DZRCOBS_PARSING_OPTIMAL )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+#endif
 
-		aCtx->crc = DZRCOBS_CRC( aCtx->crc, curCode );
+	return DZRCOBS_RET_SUCCESS;
+}
 
-		*aCtx->pCurDst++ = curCode;
+eDZRCOBS_ret dzrcobs_encode_inc_end( sDZRCOBS_ctx *aCtx, size_t *aOutSizeEncoded )
+{
+	if( ( !aCtx ) || ( !aOutSizeEncoded ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
 	}
 
-	// Add (tail) header info
-	const uint8_t encodingByte = (uint8_t)( aCtx->user6bits << 2 ) | ( (uint8_t)aCtx->encoding & 0x03 );
+	// As dzrcobs_encode_inc_dictionary, an overflow leaves the context as before
+	const sDZRCOBS_ctx ctxBefore = *aCtx;
 
-	DZRCOBS_ASSERT( encodingByte != 0 );
+	if( aCtx->carryLen > 0 )
+	{
+		const sDICT_ctx *pDict = aCtx->pDict[aCtx->encoding - DZRCOBS_USING_DICT_1];
 
-	aCtx->crc = DZRCOBS_CRC( aCtx->crc, encodingByte );
+		// No more lookahead will come, so all the held bytes are encoded now
+		size_t consumed = 0;
 
-	DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
-	*aCtx->pCurDst++ = encodingByte;
+		const eDZRCOBS_ret ret =
+		 dzrcobs_encode_dictionary_until( aCtx, pDict, aCtx->carry, aCtx->carryLen, aCtx->carryLen, &consumed );
 
-	const uint8_t finalCrc = aCtx->crc;
+		if( ret != DZRCOBS_RET_SUCCESS )
+		{
+			*aCtx = ctxBefore;
 
-	DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
-	*aCtx->pCurDst++ = ( finalCrc == 0x00 ) ? DZRCOBS_CRC_VALUE_WHEN_CRC_IS_ZERO : finalCrc; // Avoid zero ending CRC.
+			return ret;
+		}
+
+		DZRCOBS_ASSERT( consumed == aCtx->carryLen );
+
+		aCtx->carryLen = 0;
+	}
+
+	if( ( aCtx->pCurDst + dzrcobs_encode_frame_tail_size( aCtx ) ) > aCtx->pDstEnd )
+	{
+		*aCtx = ctxBefore;
+
+		return DZRCOBS_RET_ERR_OVERFLOW;
+	}
+
+	dzrcobs_encode_frame_tail( aCtx );
 
 	// Calc encoded size
 	*aOutSizeEncoded = (size_t)( aCtx->pCurDst - aCtx->pDst );
@@ -165,14 +304,336 @@ eDZRCOBS_ret dzrcobs_encode_inc( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, siz
 		return DZRCOBS_RET_SUCCESS;
 	}
 
-	const size_t maxEncodedSize = DZRCOBS_MAX_ENCODED_SIZE( aSrcBufSize );
+	// The dictionary encodings check the room on each write, as a compressed
+	// frame may fit on less than its worst case
+	if( aCtx->encoding == DZRCOBS_PLAIN )
+	{
+		const size_t maxEncodedSize = DZRCOBS_MAX_ENCODED_SIZE( aSrcBufSize );
+
+		if( ( aCtx->pCurDst + DZRCOBS_FRAME_HEADER_SIZE + maxEncodedSize ) > aCtx->pDstEnd )
+		{
+			return DZRCOBS_RET_ERR_OVERFLOW;
+		}
+	}
+
+	return aCtx->encFunc( aCtx, aSrcBuf, aSrcBufSize );
+}
 
-	if( ( aCtx->pCurDst + DZRCOBS_FRAME_HEADER_SIZE + maxEncodedSize ) > aCtx->pDstEnd )
+// Encodes a whole frame, body and tail, on the state set by dzrcobs_encode_frame_init
+static eDZRCOBS_ret dzrcobs_encode_frame( sDZRCOBS_ctx *aCtx,
+																					const sDICT_ctx *pDict,
+																					const uint8_t *aSrcBuf,
+																					size_t aSrcBufSize )
+{
+	if( aSrcBufSize > 0 )
+	{
+		if( pDict == NULL )
+		{
+			const size_t maxEncodedSize = DZRCOBS_MAX_ENCODED_SIZE( aSrcBufSize );
+
+			if( ( aCtx->pCurDst + DZRCOBS_FRAME_HEADER_SIZE + maxEncodedSize ) > aCtx->pDstEnd )
+			{
+				return DZRCOBS_RET_ERR_OVERFLOW;
+			}
+
+			dzrcobs_encode_inc_plain( aCtx, aSrcBuf, aSrcBufSize );
+		}
+		else
+		{
+			// All the frame is here, so no bytes are held for lookahead
+			size_t consumed = 0;
+
+			const eDZRCOBS_ret ret =
+			 dzrcobs_encode_dictionary_until( aCtx, pDict, aSrcBuf, aSrcBufSize, aSrcBufSize, &consumed );
+
+			if( ret != DZRCOBS_RET_SUCCESS )
+			{
+				return ret;
+			}
+
+			DZRCOBS_ASSERT( consumed == aSrcBufSize );
+		}
+	}
+
+	if( ( aCtx->pCurDst + dzrcobs_encode_frame_tail_size( aCtx ) ) > aCtx->pDstEnd )
 	{
 		return DZRCOBS_RET_ERR_OVERFLOW;
 	}
 
-	return aCtx->encFunc( aCtx, aSrcBuf, aSrcBufSize );
+	dzrcobs_encode_frame_tail( aCtx );
+
+	return DZRCOBS_RET_SUCCESS;
+}
+
+// Counts the jump codes that DZRCOBS_PLAIN writes for aSrcBuf, every other
+// source byte writes one byte. aRun is the number of non zero bytes since the
+// last zero or jump code.
+static inline void dzrcobs_encoded_size_plain( const uint8_t *aSrcBuf, size_t aSrcBufSize, size_t *aRun, size_t *aJumps )
+{
+	size_t run = *aRun;
+
+	for( size_t i = 0; i < aSrcBufSize; i++ )
+	{
+		run = ( aSrcBuf[i] != 0 ) ? ( run + 1 ) : 0;
+
+		if( run == ( DZRCOBS_CODE_JUMP_PLAIN - 1 ) )
+		{
+			( *aJumps )++;
+			run = 0;
+		}
+	}
+
+	*aRun = run;
+}
+
+// Counts the token at aState->nextPos, as dzrcobs_encode_dictionary_until
+// writes it with DZRCOBS_PARSING_GREEDY, and moves aState->nextPos after it
+static void dzrcobs_encoded_size_dictionary( const sDICT_ctx *pDict,
+																						 sDZRCOBS_size_state *aState,
+																						 const uint8_t *aSrcBuf,
+																						 size_t aSrcBufSize )
+{
+	const uint8_t *pSrc		 = aSrcBuf + aState->nextPos;
+	const size_t remaining = aSrcBufSize - aState->nextPos;
+	bool isSearchNeeded		 = true;
+	size_t literalsCount	 = 0;
+
+#if DZRCOBS_DICT_ACCELERATOR
+	if( aState->noCandidateCount == 0 )
+	{
+		aState->noCandidateCount = dzrcobs_simd_find_dict_candidate( pDict->accel.pairNibbleMasks, pSrc, remaining );
+	}
+
+	if( aState->noCandidateCount > 0 )
+	{
+		// All the non zero bytes until the next candidate are literals
+		literalsCount	 = dzrcobs_simd_find_zero( pSrc, aState->noCandidateCount );
+		isSearchNeeded = false;
+
+		aState->noCandidateCount -= ( literalsCount > 0 ) ? literalsCount : 1;
+	}
+#endif
+
+	if( isSearchNeeded )
+	{
+		size_t keySizeFound = 0;
+
+		if( dzrcobs_dictionary_search( pDict, pSrc, remaining, &keySizeFound ) )
+		{
+			const bool isCodeNeeded =
+			 ( aState->previousCode != DZRCOBS_PREVIOUS_CODE_DICTIONARY ) && ( !aState->isFirstByteInTheBuffer );
+
+			aState->size += isCodeNeeded ? 2 : 1;
+			aState->nextPos += keySizeFound;
+			aState->code									 = 1;
+			aState->previousCode					 = DZRCOBS_PREVIOUS_CODE_DICTIONARY;
+			aState->isFirstByteInTheBuffer = false;
+
+			return;
+		}
+
+		literalsCount = ( *pSrc != 0 ) ? 1 : 0;
+	}
+
+	if( literalsCount == 0 )
+	{
+		// A zero after a word is on the word code
+		if( aState->previousCode != DZRCOBS_PREVIOUS_CODE_DICTIONARY )
+		{
+			aState->size++;
+			aState->isFirstByteInTheBuffer = false;
+		}
+
+		aState->nextPos++;
+		aState->code				 = 1;
+		aState->previousCode = DZRCOBS_PREVIOUS_CODE_ZERO;
+
+		return;
+	}
+
+	// A jump code each time the code reaches DZRCOBS_CODE_JUMP
+	const size_t codeRun = (size_t)( aState->code - 1 ) + literalsCount;
+
+	aState->size += literalsCount + ( codeRun / ( DZRCOBS_CODE_JUMP - 1 ) );
+	aState->nextPos += literalsCount;
+	aState->code									 = (uint8_t)( ( codeRun % ( DZRCOBS_CODE_JUMP - 1 ) ) + 1 );
+	aState->previousCode					 = DZRCOBS_PREVIOUS_CODE_BLOCK;
+	aState->isFirstByteInTheBuffer = false;
+}
+
+eDZRCOBS_ret dzrcobs_encode_auto( sDZRCOBS_ctx *aCtx,
+																	const uint8_t *aSrcBuf,
+																	size_t aSrcBufSize,
+																	uint8_t *aDstBuf,
+																	size_t aDstBufSize,
+																	size_t *aOutSizeEncoded,
+																	eDZRCOBS_encoding *aOutEncoding )
+{
+	if( ( !aCtx ) || ( ( !aSrcBuf ) && ( aSrcBufSize > 0 ) ) || ( !aDstBuf ) || ( !aOutSizeEncoded ) ||
+			( !aOutEncoding ) || ( aCtx->user6bits == 0 ) || ( aCtx->user6bits > 63 ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
+	sDZRCOBS_size_state states[DZRCOBS_DICT_N];
+
+	for( size_t i = 0; i < DZRCOBS_DICT_N; i++ )
+	{
+		// As set by dzrcobs_encode_frame_init
+		states[i].size									 = 0;
+		states[i].nextPos								 = ( aCtx->pDict[i] != NULL ) ? 0 : SIZE_MAX;
+		states[i].code									 = 1;
+		states[i].previousCode					 = DZRCOBS_PREVIOUS_CODE_ZERO;
+		states[i].isFirstByteInTheBuffer = true;
+#if DZRCOBS_DICT_ACCELERATOR
+		states[i].noCandidateCount = 0;
+#endif
+	}
+
+	size_t plainRun		= 0;
+	size_t plainJumps = 0;
+
+	// One pass over the source, by blocks that stay on cache while all the
+	// encodings count them. A word can end after its block.
+	for( size_t blockBegin = 0; blockBegin < aSrcBufSize; blockBegin += DZRCOBS_AUTO_BLOCK_SIZE )
+	{
+		const size_t blockSize = ( ( aSrcBufSize - blockBegin ) < DZRCOBS_AUTO_BLOCK_SIZE ) ? ( aSrcBufSize - blockBegin )
+																																											: DZRCOBS_AUTO_BLOCK_SIZE;
+
+		dzrcobs_encoded_size_plain( &aSrcBuf[blockBegin], blockSize, &plainRun, &plainJumps );
+
+		for( size_t i = 0; i < DZRCOBS_DICT_N; i++ )
+		{
+			while( states[i].nextPos < ( blockBegin + blockSize ) )
+			{
+				dzrcobs_encoded_size_dictionary( aCtx->pDict[i], &states[i], aSrcBuf, aSrcBufSize );
+			}
+		}
+	}
+
+	// The last code (a word has none) and the frame tail
+	eDZRCOBS_encoding bestEncoding = DZRCOBS_PLAIN;
+	size_t bestSize								= aSrcBufSize + plainJumps + 1 + DZRCOBS_FRAME_HEADER_SIZE;
+
+	for( size_t i = 0; i < DZRCOBS_DICT_N; i++ )
+	{
+		if( aCtx->pDict[i] == NULL )
+		{
+			continue;
+		}
+
+		const size_t size = states[i].size +
+												( ( states[i].previousCode != DZRCOBS_PREVIOUS_CODE_DICTIONARY ) ? 1 : 0 ) +
+												DZRCOBS_FRAME_HEADER_SIZE;
+
+		if( size < bestSize )
+		{
+			bestSize		 = size;
+			bestEncoding = (eDZRCOBS_encoding)( DZRCOBS_USING_DICT_1 + i );
+		}
+	}
+
+	aCtx->encoding = bestEncoding;
+	aCtx->encFunc	 = NULL; // No frame left open for dzrcobs_encode_inc
+
+	dzrcobs_encode_frame_init( aCtx, aDstBuf, aDstBufSize );
+
+	const eDZRCOBS_ret ret =
+	 dzrcobs_encode_frame( aCtx,
+												 ( bestEncoding == DZRCOBS_PLAIN ) ? NULL : aCtx->pDict[bestEncoding - DZRCOBS_USING_DICT_1],
+												 aSrcBuf,
+												 aSrcBufSize );
+
+	if( ret != DZRCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	const size_t encodedSize = (size_t)( aCtx->pCurDst - aCtx->pDst );
+
+	// The choice and the destiny size (see the header) rely on the counting
+	if( encodedSize != bestSize )
+	{
+		DZRCOBS_ASSERT( false );
+
+		return DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	*aOutSizeEncoded = encodedSize;
+	*aOutEncoding		 = bestEncoding;
+
+	return DZRCOBS_RET_SUCCESS;
+}
+
+eDZRCOBS_ret dzrcobs_encode_batch( sDZRCOBS_ctx *aCtx,
+																	 eDZRCOBS_encoding aEncoding,
+																	 const sDZRCOBS_batch_entry *aEntries,
+																	 size_t aEntriesCount,
+																	 uint8_t *aDstBuf,
+																	 size_t aDstBufSize,
+																	 size_t *aOutOffsets,
+																	 size_t *aOutFramesEncoded )
+{
+	if( ( !aCtx ) || ( ( !aEntries ) && ( aEntriesCount > 0 ) ) || ( !aDstBuf ) || ( !aOutOffsets ) ||
+			( !aOutFramesEncoded ) || ( aEncoding == DZRCOBS_RESERVED ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
+	const sDICT_ctx *pDict = NULL;
+
+	if( aEncoding != DZRCOBS_PLAIN )
+	{
+		pDict = aCtx->pDict[aEncoding - DZRCOBS_USING_DICT_1];
+
+		if( pDict == NULL )
+		{
+			return DZRCOBS_RET_ERR_BAD_ARG;
+		}
+	}
+
+	aCtx->encoding = aEncoding;
+	aCtx->encFunc	 = NULL; // No frame left open for dzrcobs_encode_inc
+
+	uint8_t *pCurDst						= aDstBuf;
+	const uint8_t *const pDstEnd = aDstBuf + aDstBufSize;
+
+	*aOutFramesEncoded = 0;
+	aOutOffsets[0]		 = 0;
+
+	for( size_t i = 0; i < aEntriesCount; i++ )
+	{
+		const sDZRCOBS_batch_entry *pEntry = &aEntries[i];
+
+		if( ( ( !pEntry->pSrc ) && ( pEntry->srcLen > 0 ) ) || ( pEntry->user6bits == 0 ) || ( pEntry->user6bits > 63 ) )
+		{
+			return DZRCOBS_RET_ERR_BAD_ARG;
+		}
+
+		// Keep one byte for the delimiter
+		if( pCurDst == pDstEnd )
+		{
+			return DZRCOBS_RET_ERR_OVERFLOW;
+		}
+
+		dzrcobs_encode_frame_init( aCtx, pCurDst, (size_t)( pDstEnd - pCurDst ) - 1 );
+		aCtx->user6bits = pEntry->user6bits;
+
+		const eDZRCOBS_ret ret = dzrcobs_encode_frame( aCtx, pDict, pEntry->pSrc, pEntry->srcLen );
+
+		if( ret != DZRCOBS_RET_SUCCESS )
+		{
+			return ret;
+		}
+
+		pCurDst		 = aCtx->pCurDst;
+		*pCurDst++ = 0x00;
+
+		aOutOffsets[i + 1] = (size_t)( pCurDst - aDstBuf );
+		*aOutFramesEncoded = i + 1;
+	}
+
+	return DZRCOBS_RET_SUCCESS;
 }
 
 eDZRCOBS_ret dzrcobs_encode_inc_plain( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
@@ -188,84 +649,314 @@ eDZRCOBS_ret dzrcobs_encode_inc_plain( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBu
 #endif
 
 	uint8_t curCode = aCtx->code;
+	uint8_t crc			= aCtx->crc;
 
 	while( aSrcBufSize )
 	{
-		aSrcBufSize--;
-
-		DZRCOBS_RUN_ONDEBUG( srcReadCounter++ );
+		// Longest run of non zero bytes that still fits on the current code block
+		const size_t blockRoom = (size_t)( DZRCOBS_CODE_JUMP_PLAIN - curCode );
+		const size_t runMax		 = ( aSrcBufSize < blockRoom ) ? aSrcBufSize : blockRoom;
+		const size_t runSize	 = dzrcobs_simd_find_zero( aSrcBuf, runMax );
 
-		const uint8_t byte = *aSrcBuf++;
+		DZRCOBS_ASSERT( blockRoom > 0 );
 
-		if( byte == 0 )
+		if( runSize > 0 )
 		{
-			DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
+			DZRCOBS_RUN_ONDEBUG( srcReadCounter += runSize );
+			DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter += runSize );
 
-			aCtx->crc = DZRCOBS_CRC( aCtx->crc, curCode );
-			*curDst++ = curCode;
+			aCtx->isFirstByteInTheBuffer = false;
 
-			curCode = 1;
-		}
-		else
-		{
-			DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
+			memcpy( curDst, aSrcBuf, runSize );
 
-			aCtx->isFirstByteInTheBuffer = false;
+			crc = DZRCOBS_CRC_BLOCK( crc, aSrcBuf, runSize );
 
-			aCtx->crc = DZRCOBS_CRC( aCtx->crc, byte );
-			*curDst++ = byte;
-			curCode++;
+			curDst += runSize;
+			aSrcBuf += runSize;
+			aSrcBufSize -= runSize;
+			curCode = (uint8_t)( curCode + runSize );
 
 			if( curCode == DZRCOBS_CODE_JUMP_PLAIN )
 			{
 				DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
 
-				aCtx->crc = DZRCOBS_CRC( aCtx->crc, curCode );
+				crc				= DZRCOBS_CRC( crc, curCode );
 				*curDst++ = curCode;
 				curCode		= 1;
+
+				continue;
 			}
 		}
+
+		if( runSize < runMax )
+		{
+			// The run was stopped by a zero
+			DZRCOBS_ASSERT( *aSrcBuf == 0 );
+			DZRCOBS_RUN_ONDEBUG( srcReadCounter++ );
+			DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
+
+			aSrcBuf++;
+			aSrcBufSize--;
+
+			crc				= DZRCOBS_CRC( crc, curCode );
+			*curDst++ = curCode;
+
+			curCode = 1;
+		}
 	}
 
+	aCtx->crc			= crc;
 	aCtx->code		= curCode;
 	aCtx->pCurDst = curDst;
 
 	return DZRCOBS_RET_SUCCESS;
 }
 
-eDZRCOBS_ret dzrcobs_encode_inc_dictionary( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
+#if DZRCOBS_OPTIMAL_PARSING
+// Chooses the token at aSrcBuf for DZRCOBS_PARSING_OPTIMAL, by the fewest encoded
+// bytes on the next DZRCOBS_OPTIMAL_WINDOW bytes (a dynamic program over the
+// positions and the previous code). aOffset is the position of aSrcBuf from the
+// start of the source, for aCache. Returns the word index (1 based) or 0 for a
+// literal (or zero) byte.
+static uint8_t dzrcobs_encode_optimal_choice( const sDZRCOBS_ctx *aCtx,
+																							const sDICT_ctx *pDict,
+																							uint8_t aCode,
+																							const uint8_t *aSrcBuf,
+																							size_t aSrcBufSize,
+																							size_t aOffset,
+																							sDZRCOBS_match_cache *aCache,
+																							size_t *aOutKeySizeFound )
 {
-	DZRCOBS_ASSERT( aCtx != NULL );
-	DZRCOBS_ASSERT( aSrcBuf != NULL );
-	DZRCOBS_ASSERT( aSrcBufSize > 0 );
-	DZRCOBS_ASSERT( ( aCtx->encoding == DZRCOBS_USING_DICT_1 ) || ( aCtx->encoding == DZRCOBS_USING_DICT_2 ) );
+	// A shorter window is only seen at the end of the frame, on any split of the source
+	const bool isFrameEnd = aSrcBufSize < DZRCOBS_OPTIMAL_WINDOW;
+	const size_t window		= isFrameEnd ? aSrcBufSize : DZRCOBS_OPTIMAL_WINDOW;
+
+	// Words of each size on the window, a word must end inside it
+	for( size_t offset = ( aCache->searchedEnd > aOffset ) ? aCache->searchedEnd : aOffset; offset < ( aOffset + window );
+			 offset++ )
+	{
+		uint8_t *pIdx					 = aCache->idx[offset % DZRCOBS_OPTIMAL_WINDOW];
+		const size_t available = aSrcBufSize - ( offset - aOffset );
+
+		for( size_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+		{
+			const size_t wordSize = i + 2;
+
+			pIdx[i] = ( ( wordSize >= pDict->minWordSize ) && ( wordSize <= pDict->maxWordSize ) && ( wordSize <= available ) )
+								 ? dzrcobs_dictionary_search_size( pDict, &aSrcBuf[offset - aOffset], wordSize )
+								 : 0;
+		}
+
+		aCache->searchedEnd = offset + 1;
+	}
+
+	// Bytes written to reach each position with each previous code, the code
+	// of the block (on DZRCOBS_PREVIOUS_CODE_BLOCK) and the first token taken
+	uint16_t cost[DZRCOBS_OPTIMAL_WINDOW + 1][DZRCOBS_PREVIOUS_CODE_N];
+	uint8_t blockCode[DZRCOBS_OPTIMAL_WINDOW + 1];
+	uint8_t firstToken[DZRCOBS_OPTIMAL_WINDOW + 1][DZRCOBS_PREVIOUS_CODE_N];
+
+	memset( cost, 0xFF, sizeof( cost ) );
+
+	cost[0][aCtx->previousCode]				= 0;
+	blockCode[0]											= aCode;
+	firstToken[0][aCtx->previousCode] = 0;
+
+	for( size_t pos = 0; pos < window; pos++ )
+	{
+		const uint8_t *pIdx = aCache->idx[( aOffset + pos ) % DZRCOBS_OPTIMAL_WINDOW];
+
+		for( uint8_t previous = 0; previous < DZRCOBS_PREVIOUS_CODE_N; previous++ )
+		{
+			const uint16_t curCost = cost[pos][previous];
+
+			if( curCost == DZRCOBS_OPTIMAL_COST_NONE )
+			{
+				continue;
+			}
+
+			const uint8_t curCode	 = ( previous == DZRCOBS_PREVIOUS_CODE_BLOCK ) ? blockCode[pos] : 1;
+			const uint8_t curFirst = firstToken[pos][previous];
+
+			// A word closes the block before it, unless nothing was written yet
+			const bool isFirst			= ( pos == 0 ) && aCtx->isFirstByteInTheBuffer;
+			const uint16_t wordCost = (uint16_t)( curCost + 1 +
+																						( ( ( previous != DZRCOBS_PREVIOUS_CODE_DICTIONARY ) && !isFirst ) ? 1 : 0 ) );
+
+			for( size_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+			{
+				const size_t next = pos + i + 2;
+
+				if( ( pIdx[i] != 0 ) && ( next <= window ) &&
+						( wordCost < cost[next][DZRCOBS_PREVIOUS_CODE_DICTIONARY] ) )
+				{
+					cost[next][DZRCOBS_PREVIOUS_CODE_DICTIONARY]			 = wordCost;
+					firstToken[next][DZRCOBS_PREVIOUS_CODE_DICTIONARY] = ( pos == 0 ) ? pIdx[i] : curFirst;
+				}
+			}
+
+			if( aSrcBuf[pos] == 0 )
+			{
+				// A zero after a word is on the word code
+				const uint16_t zeroCost = (uint16_t)( curCost + ( ( previous != DZRCOBS_PREVIOUS_CODE_DICTIONARY ) ? 1 : 0 ) );
+
+				if( zeroCost < cost[pos + 1][DZRCOBS_PREVIOUS_CODE_ZERO] )
+				{
+					cost[pos + 1][DZRCOBS_PREVIOUS_CODE_ZERO]				= zeroCost;
+					firstToken[pos + 1][DZRCOBS_PREVIOUS_CODE_ZERO] = ( pos == 0 ) ? 0 : curFirst;
+				}
+			}
+			else
+			{
+				uint8_t nextCode				 = (uint8_t)( curCode + 1 );
+				uint16_t literalCost = (uint16_t)( curCost + 1 );
+
+				if( nextCode == DZRCOBS_CODE_JUMP )
+				{
+					literalCost++;
+					nextCode = 1;
+				}
+
+				// On a tie, the block further from its jump code
+				const uint16_t bestCost = cost[pos + 1][DZRCOBS_PREVIOUS_CODE_BLOCK];
+
+				if( ( literalCost < bestCost ) || ( ( literalCost == bestCost ) && ( nextCode < blockCode[pos + 1] ) ) )
+				{
+					cost[pos + 1][DZRCOBS_PREVIOUS_CODE_BLOCK]			 = literalCost;
+					blockCode[pos + 1]															 = nextCode;
+					firstToken[pos + 1][DZRCOBS_PREVIOUS_CODE_BLOCK] = ( pos == 0 ) ? 0 : curFirst;
+				}
+			}
+		}
+	}
+
+	// A block still open will need its code, at the end of the frame or later
+	uint16_t bestCost = DZRCOBS_OPTIMAL_COST_NONE;
+	uint8_t bestToken = 0;
+
+	for( uint8_t previous = 0; previous < DZRCOBS_PREVIOUS_CODE_N; previous++ )
+	{
+		if( cost[window][previous] == DZRCOBS_OPTIMAL_COST_NONE )
+		{
+			continue;
+		}
+
+		const uint16_t endCost =
+		 (uint16_t)( cost[window][previous] + ( ( previous != DZRCOBS_PREVIOUS_CODE_DICTIONARY ) ? 1 : 0 ) );
+
+		if( endCost < bestCost )
+		{
+			bestCost	= endCost;
+			bestToken = firstToken[window][previous];
+		}
+	}
+
+	if( bestToken != 0 )
+	{
+		const uint8_t *pIdx = aCache->idx[aOffset % DZRCOBS_OPTIMAL_WINDOW];
+
+		for( size_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+		{
+			if( pIdx[i] == bestToken )
+			{
+				*aOutKeySizeFound = i + 2;
+			}
+		}
+	}
+
+	return bestToken;
+}
+#endif
+
+// Encodes the positions before aStopAt. The bytes from aStopAt up to aSrcBufSize
+// are only used as lookahead by the dictionary search, a word that starts before
+// aStopAt can end after it. aOutConsumed is the number of source bytes consumed.
+static eDZRCOBS_ret dzrcobs_encode_dictionary_until( sDZRCOBS_ctx *aCtx,
+																										 const sDICT_ctx *pDict,
+																										 const uint8_t *aSrcBuf,
+																										 size_t aSrcBufSize,
+																										 size_t aStopAt,
+																										 size_t *aOutConsumed )
+{
+	DZRCOBS_ASSERT( aStopAt <= aSrcBufSize );
+
+	const uint8_t *pSrcBegin = aSrcBuf;
+	const uint8_t *pSrcStop	 = aSrcBuf + aStopAt;
 
 	uint8_t *curDst = aCtx->pCurDst;
 
+	// A jump code every 62 bytes can take more than DZRCOBS_MAX_ENCODED_SIZE,
+	// so the room is checked on each write, keeping the frame tail reserved
+	const uint8_t *pDstLimit = aCtx->pDstEnd - DZRCOBS_FRAME_HEADER_SIZE;
+
+	eDZRCOBS_ret ret = DZRCOBS_RET_SUCCESS;
+
 	uint8_t curCode = aCtx->code;
 
-	const sDICT_ctx *pDict = aCtx->pDict[aCtx->encoding - DZRCOBS_USING_DICT_1];
+#if DZRCOBS_OPTIMAL_PARSING
+	sDZRCOBS_match_cache matchCache;
+	matchCache.searchedEnd = 0;
+#endif
 
-	bool previously_found_a_dictionary = false;
+#if DZRCOBS_DICT_ACCELERATOR
+	// Positions ahead that cannot start a dictionary word
+	size_t noCandidateCount = 0;
+#endif
 
-	while( aSrcBufSize )
+	while( aSrcBuf < pSrcStop )
 	{
 		size_t keySizeFound = 0;
 
+#if DZRCOBS_DICT_ACCELERATOR
+		if( noCandidateCount == 0 )
+		{
+			noCandidateCount = dzrcobs_simd_find_dict_candidate( pDict->accel.pairNibbleMasks, aSrcBuf, aSrcBufSize );
+		}
+
+		uint8_t foundIdx = 0;
+
+		if( noCandidateCount == 0 )
+		{
+			foundIdx = dzrcobs_dictionary_search( pDict, aSrcBuf, aSrcBufSize, &keySizeFound );
+		}
+		else
+		{
+			noCandidateCount--;
+		}
+#else
 		uint8_t foundIdx = dzrcobs_dictionary_search( pDict, aSrcBuf, aSrcBufSize, &keySizeFound );
+#endif
+
+#if DZRCOBS_OPTIMAL_PARSING
+		// Without a word here, a literal is the only choice
+		if( foundIdx && aCtx->isOptimalParsing )
+		{
+			foundIdx = dzrcobs_encode_optimal_choice(
+			 aCtx, pDict, curCode, aSrcBuf, aSrcBufSize, (size_t)( aSrcBuf - pSrcBegin ), &matchCache, &keySizeFound );
+		}
+#endif
 
 		if( foundIdx )
 		{
 			DZRCOBS_ASSERT( keySizeFound > 0 );
 			DZRCOBS_ASSERT( keySizeFound <= aSrcBufSize );
 
-			if( !previously_found_a_dictionary )
+			const bool isCodeNeeded =
+			 ( aCtx->previousCode != DZRCOBS_PREVIOUS_CODE_DICTIONARY ) && ( !aCtx->isFirstByteInTheBuffer );
+
+			if( !dzrcobs_has_room( curDst, pDstLimit, isCodeNeeded ? 2 : 1 ) )
 			{
-				if( !aCtx->isFirstByteInTheBuffer )
+				ret = DZRCOBS_RET_ERR_OVERFLOW;
+				break;
+			}
+
+			if( aCtx->previousCode != DZRCOBS_PREVIOUS_CODE_DICTIONARY )
+			{
+				if( isCodeNeeded )
 				{
 					DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
 
-					curCode = ( curCode == 1 ) ? 0x01 : ( curCode | aCtx->pendingMask );
+					curCode = dzrcobs_block_code( aCtx, curCode );
 
 					aCtx->crc = DZRCOBS_CRC( aCtx->crc, curCode );
 
@@ -278,8 +969,6 @@ eDZRCOBS_ret dzrcobs_encode_inc_dictionary( sDZRCOBS_ctx *aCtx, const uint8_t *a
 			aCtx->previousCode = DZRCOBS_PREVIOUS_CODE_DICTIONARY;
 			aCtx->pendingMask	 = DZRCOBS_NEXTCODE_IS_DICTIONARY;
 
-			previously_found_a_dictionary = true;
-
 			DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
 
 			foundIdx -= 1; // remove base index
@@ -298,12 +987,19 @@ eDZRCOBS_ret dzrcobs_encode_inc_dictionary( sDZRCOBS_ctx *aCtx, const uint8_t *a
 			continue;
 		}
 
-		previously_found_a_dictionary = false;
-
 		// Continue with regular plain encoding
-		aSrcBufSize--;
+		const uint8_t byte = *aSrcBuf;
 
-		const uint8_t byte = *aSrcBuf++;
+		// A zero after a word, or a literal byte, writes one byte
+		if( ( ( byte != 0 ) || ( aCtx->previousCode != DZRCOBS_PREVIOUS_CODE_DICTIONARY ) ) &&
+				( !dzrcobs_has_room( curDst, pDstLimit, 1 ) ) )
+		{
+			ret = DZRCOBS_RET_ERR_OVERFLOW;
+			break;
+		}
+
+		aSrcBuf++;
+		aSrcBufSize--;
 
 		if( byte == 0 )
 		{
@@ -311,7 +1007,7 @@ eDZRCOBS_ret dzrcobs_encode_inc_dictionary( sDZRCOBS_ctx *aCtx, const uint8_t *a
 			{
 				DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
 
-				curCode = ( curCode == 1 ) ? 0x01 : ( curCode | aCtx->pendingMask );
+				curCode = dzrcobs_block_code( aCtx, curCode );
 
 				aCtx->crc = DZRCOBS_CRC( aCtx->crc, curCode );
 
@@ -349,8 +1045,44 @@ eDZRCOBS_ret dzrcobs_encode_inc_dictionary( sDZRCOBS_ctx *aCtx, const uint8_t *a
 			*curDst++ = byte;
 			curCode++;
 
+#if DZRCOBS_DICT_ACCELERATOR
+			// The following non zero bytes without word candidates go on the same block
+			const size_t blockRoom = (size_t)( DZRCOBS_CODE_JUMP - curCode );
+			const size_t stopRoom	 = (size_t)( pSrcStop - aSrcBuf );
+			size_t runMax					 = ( noCandidateCount < blockRoom ) ? noCandidateCount : blockRoom;
+
+			runMax = ( runMax < stopRoom ) ? runMax : stopRoom;
+
+			// Keep one byte for the jump code
+			const size_t dstRoom = ( pDstLimit > curDst ) ? (size_t)( pDstLimit - curDst - 1 ) : 0;
+			runMax							 = ( runMax < dstRoom ) ? runMax : dstRoom;
+
+			if( runMax > 0 )
+			{
+				const size_t runSize = dzrcobs_simd_find_zero( aSrcBuf, runMax );
+
+				DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter += runSize );
+
+				memcpy( curDst, aSrcBuf, runSize );
+
+				aCtx->crc = DZRCOBS_CRC_BLOCK( aCtx->crc, aSrcBuf, runSize );
+
+				curDst += runSize;
+				aSrcBuf += runSize;
+				aSrcBufSize -= runSize;
+				noCandidateCount -= runSize;
+				curCode = (uint8_t)( curCode + runSize );
+			}
+#endif
+
 			if( curCode == DZRCOBS_CODE_JUMP )
 			{
+				if( !dzrcobs_has_room( curDst, pDstLimit, 1 ) )
+				{
+					ret = DZRCOBS_RET_ERR_OVERFLOW;
+					break;
+				}
+
 				DZRCOBS_RUN_ONDEBUG( aCtx->writeCounter++ );
 
 				aCtx->crc = DZRCOBS_CRC( aCtx->crc, curCode );
@@ -366,8 +1098,114 @@ eDZRCOBS_ret dzrcobs_encode_inc_dictionary( sDZRCOBS_ctx *aCtx, const uint8_t *a
 	aCtx->code		= curCode;
 	aCtx->pCurDst = curDst;
 
+	*aOutConsumed = (size_t)( aSrcBuf - pSrcBegin );
+
+	return ret;
+}
+
+// Encodes the positions that have their lookahead, holds the others on the carry
+static eDZRCOBS_ret dzrcobs_encode_dictionary_lookahead( sDZRCOBS_ctx *aCtx,
+																												 const uint8_t *aSrcBuf,
+																												 size_t aSrcBufSize )
+{
+	DZRCOBS_ASSERT( aCtx != NULL );
+	DZRCOBS_ASSERT( aSrcBuf != NULL );
+	DZRCOBS_ASSERT( aSrcBufSize > 0 );
+	DZRCOBS_ASSERT( ( aCtx->encoding == DZRCOBS_USING_DICT_1 ) || ( aCtx->encoding == DZRCOBS_USING_DICT_2 ) );
+
+	const sDICT_ctx *pDict = aCtx->pDict[aCtx->encoding - DZRCOBS_USING_DICT_1];
+
+	// A position is only encoded when the longest word can be compared on it,
+	// so the matches are the same however the source is split between calls
+	size_t lookahead = ( pDict->maxWordSize > 1 ) ? (size_t)( pDict->maxWordSize - 1 ) : 0;
+
+#if DZRCOBS_OPTIMAL_PARSING
+	if( aCtx->isOptimalParsing )
+	{
+		lookahead = DZRCOBS_OPTIMAL_WINDOW - 1;
+	}
+#endif
+
+	DZRCOBS_ASSERT( lookahead <= ( DZRCOBS_ENCODE_CARRY_SIZE / 2 ) );
+
+	if( aCtx->carryLen > 0 )
+	{
+		// Join the held bytes with the start of this buffer
+		const size_t pendingLen = aCtx->carryLen;
+		const size_t takeLen		= ( aSrcBufSize < lookahead ) ? aSrcBufSize : lookahead;
+		const size_t joinedLen	= pendingLen + takeLen;
+
+		memcpy( &aCtx->carry[pendingLen], aSrcBuf, takeLen );
+
+		const size_t readyLen = ( joinedLen > lookahead ) ? ( joinedLen - lookahead ) : 0;
+		const size_t stopAt		= ( readyLen < pendingLen ) ? readyLen : pendingLen;
+
+		size_t consumed = 0;
+
+		if( stopAt > 0 )
+		{
+			const eDZRCOBS_ret ret =
+			 dzrcobs_encode_dictionary_until( aCtx, pDict, aCtx->carry, joinedLen, stopAt, &consumed );
+
+			if( ret != DZRCOBS_RET_SUCCESS )
+			{
+				return ret;
+			}
+		}
+
+		if( takeLen == aSrcBufSize )
+		{
+			// All this buffer is on the carry now
+			memmove( aCtx->carry, &aCtx->carry[consumed], joinedLen - consumed );
+			aCtx->carryLen = (uint8_t)( joinedLen - consumed );
+
+			return DZRCOBS_RET_SUCCESS;
+		}
+
+		DZRCOBS_ASSERT( consumed >= pendingLen );
+
+		aCtx->carryLen = 0;
+
+		aSrcBuf += consumed - pendingLen;
+		aSrcBufSize -= consumed - pendingLen;
+	}
+
+	size_t consumed = 0;
+
+	if( aSrcBufSize > lookahead )
+	{
+		const eDZRCOBS_ret ret =
+		 dzrcobs_encode_dictionary_until( aCtx, pDict, aSrcBuf, aSrcBufSize, aSrcBufSize - lookahead, &consumed );
+
+		if( ret != DZRCOBS_RET_SUCCESS )
+		{
+			return ret;
+		}
+	}
+
+	DZRCOBS_ASSERT( ( aSrcBufSize - consumed ) <= lookahead );
+
+	memcpy( aCtx->carry, &aSrcBuf[consumed], aSrcBufSize - consumed );
+	aCtx->carryLen = (uint8_t)( aSrcBufSize - consumed );
+
 	return DZRCOBS_RET_SUCCESS;
 }
 
+eDZRCOBS_ret dzrcobs_encode_inc_dictionary( sDZRCOBS_ctx *aCtx, const uint8_t *aSrcBuf, size_t aSrcBufSize )
+{
+	// The encoder only appends to the destiny, so the context before the call
+	// undoes a partial write
+	const sDZRCOBS_ctx ctxBefore = *aCtx;
+
+	const eDZRCOBS_ret ret = dzrcobs_encode_dictionary_lookahead( aCtx, aSrcBuf, aSrcBufSize );
+
+	if( ret != DZRCOBS_RET_SUCCESS )
+	{
+		*aCtx = ctxBefore;
+	}
+
+	return ret;
+}
+
 // EOF
 // /////////////////////////////////////////////////////////////////////////////
@@ -18,15 +18,35 @@
 // /////////////////////////////////////////////////////////////////////////////
 #include <dzrcobs/dzrcobs_decode.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include "crc8.h"
 #include "dzrcobs/dzrcobs.h"
 #include "dzrcobs_assert.h"
+#include "dzrcobs_simd.h"
 
 // Definitions
 // /////////////////////////////////////////////////////////////////////////////
 
 // Implementation
 // /////////////////////////////////////////////////////////////////////////////
+
+static bool dzrcobs_is_crc_valid( uint8_t aCrc, uint8_t aReceivedCRC8 )
+{
+	return ( ( aCrc != 0 ) && ( aCrc == aReceivedCRC8 ) ) ||
+				 ( ( aCrc == 0 ) && ( aReceivedCRC8 == DZRCOBS_CRC_VALUE_WHEN_CRC_IS_ZERO ) );
+}
+
+static bool dzrcobs_is_overlapping( const sDZRCOBS_decodectx *aDecodeCtx )
+{
+	const uintptr_t beginEncoded = (uintptr_t)aDecodeCtx->srcBufEncoded;
+	const uintptr_t beginDecoded = (uintptr_t)aDecodeCtx->dstBufDecoded;
+
+	return ( beginEncoded < ( beginDecoded + aDecodeCtx->dstBufDecodedSize ) ) &&
+				 ( beginDecoded < ( beginEncoded + aDecodeCtx->srcBufEncodedLen ) );
+}
+
 eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 														 size_t *aOutDecodedLen,
 														 uint8_t **aOutDecodedStartPos,
@@ -45,6 +65,15 @@ eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 	uint8_t *pWriteDecodedInitial = aDecodeCtx->dstBufDecoded + aDecodeCtx->dstBufDecodedSize;
 	uint8_t *pWriteDecoded				= pWriteDecodedInitial; // starts out of buffer, will be decremented latter
 
+	// In-place, the decoded data is written over the encoded bytes already read
+	const bool isInPlace = dzrcobs_is_overlapping( aDecodeCtx );
+
+	// and must not end before the frame, it would overwrite the bytes not read yet
+	if( isInPlace && ( (uintptr_t)pWriteDecodedInitial < (uintptr_t)( pBeginEncoded + aDecodeCtx->srcBufEncodedLen ) ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
 #ifdef IS_DEBUG_BUILD
 	size_t totalWrite = 0;
 	size_t totalRead	= 0;
@@ -59,18 +88,10 @@ eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 		return DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
 	}
 
-	uint8_t crc = DZRCOBS_CRC_INIT_VAL;
-
-	const uint8_t *pData		= pBeginEncoded;
-	const uint8_t *pDataEnd = aDecodeCtx->srcBufEncoded + aDecodeCtx->srcBufEncodedLen - 1; // -1 removed CRC
-
-	while( pData < pDataEnd )
-	{
-		crc = DZRCOBS_CRC( crc, *pData++ );
-	}
+	const uint8_t crc =
+	 DZRCOBS_CRC_BLOCK( DZRCOBS_CRC_INIT_VAL, pBeginEncoded, aDecodeCtx->srcBufEncodedLen - 1 ); // -1 removed CRC
 
-	if( ( ( crc != 0 ) && ( crc != receivedCRC8 ) ) ||
-			( ( crc == 0 ) && ( receivedCRC8 != DZRCOBS_CRC_VALUE_WHEN_CRC_IS_ZERO ) ) )
+	if( !dzrcobs_is_crc_valid( crc, receivedCRC8 ) )
 	{
 		return DZRCOBS_RET_ERR_CRC;
 	}
@@ -149,6 +170,17 @@ eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 					break;
 				}
 
+				// A jump block is not terminated by a zero
+				if( *pReadEncoded == jumpCodeBitmask )
+				{
+					continue;
+				}
+
+				if( ( pWriteDecoded - 1 ) < pBeginDecoded )
+				{
+					return DZRCOBS_RET_ERR_OVERFLOW;
+				}
+
 				DZRCOBS_RUN_ONDEBUG( totalWrite++ );
 
 				pWriteDecoded--;
@@ -156,22 +188,46 @@ eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 			}
 			else
 			{
-				while( code )
+				if( (size_t)( pReadEncoded + 1 - pBeginEncoded ) < code )
 				{
-					code--;
+					return DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+				}
 
-					const uint8_t byte = *pReadEncoded--;
-					DZRCOBS_RUN_ONDEBUG( totalRead++ );
+				DZRCOBS_RUN_ONDEBUG( totalRead += code );
+				DZRCOBS_RUN_ONDEBUG( totalWrite += code );
 
-					if( byte == 0 )
+				if( code >= DZRCOBS_SIMD_RUN_MIN )
+				{
+					// The run is stored in the same order, so it is a forward copy
+					const uint8_t *pRun = pReadEncoded + 1 - code;
+
+					if( dzrcobs_simd_find_zero( pRun, code ) != code )
 					{
 						return DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
 					}
 
-					pWriteDecoded--;
-					*pWriteDecoded = byte;
+					// In-place the run may overlap its destiny
+					pWriteDecoded -= code;
+					memmove( pWriteDecoded, pRun, code );
 
-					DZRCOBS_RUN_ONDEBUG( totalWrite++ );
+					pReadEncoded -= code;
+				}
+				else
+				{
+					while( code )
+					{
+						code--;
+
+						const uint8_t byte = *pReadEncoded--;
+
+						if( byte == 0 )
+						{
+							return DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+						}
+
+						pWriteDecoded--;
+						*pWriteDecoded = byte;
+					}
 				}
 
 				if( is_end_of_code_a_zero )
@@ -200,6 +256,46 @@ eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 		{
 			const uint8_t dictIdx = ( code & ~DZRCOBS_DICTIONARY_BITMASK );
 
+			// The last two tokens are never produced by the encoder
+			if( dictIdx >= DICT_MAX_WORDS )
+			{
+				return DZRCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY;
+			}
+
+#if DZRCOBS_DICT_ACCELERATOR
+			const uint8_t wordSize = pDict->accel.flatWordSize[dictIdx];
+
+			if( wordSize == 0 )
+			{
+				return DZRCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY;
+			}
+
+			if( ( pWriteDecoded - wordSize ) < pBeginDecoded )
+			{
+				return DZRCOBS_RET_ERR_OVERFLOW;
+			}
+
+			// In-place, a word is larger than its token and must not reach the bytes not read yet
+			if( isInPlace && ( ( pWriteDecoded - wordSize ) <= pReadEncoded ) )
+			{
+				return DZRCOBS_RET_ERR_OVERFLOW;
+			}
+
+			DZRCOBS_RUN_ONDEBUG( totalWrite += wordSize );
+
+			// The bytes before the word are not decoded yet, so the padding can be written over them
+			if( ( (size_t)( pWriteDecoded - pBeginDecoded ) >= DICT_FLAT_WORD_SIZE ) &&
+					( ( !isInPlace ) || ( ( pWriteDecoded - DICT_FLAT_WORD_SIZE ) > pReadEncoded ) ) )
+			{
+				memcpy( pWriteDecoded - DICT_FLAT_WORD_SIZE, pDict->accel.flatWords[dictIdx], DICT_FLAT_WORD_SIZE );
+			}
+			else
+			{
+				memcpy( pWriteDecoded - wordSize, &pDict->accel.flatWords[dictIdx][DICT_FLAT_WORD_SIZE - wordSize], wordSize );
+			}
+
+			pWriteDecoded -= wordSize;
+#else
 			uint8_t wordSize = 0;
 
 			const uint8_t *word = dzrcobs_dictionary_get( pDict, dictIdx, &wordSize );
@@ -214,6 +310,12 @@ eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 				return DZRCOBS_RET_ERR_OVERFLOW;
 			}
 
+			// In-place, a word is larger than its token and must not reach the bytes not read yet
+			if( isInPlace && ( ( pWriteDecoded - wordSize ) <= pReadEncoded ) )
+			{
+				return DZRCOBS_RET_ERR_OVERFLOW;
+			}
+
 			const uint8_t *wordEnd = word + wordSize;
 			wordEnd--;
 
@@ -225,6 +327,7 @@ eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 				pWriteDecoded--;
 				*pWriteDecoded = *wordEnd--;
 			}
+#endif
 		}
 	}
 
@@ -237,5 +340,327 @@ eDZRCOBS_ret dzrcobs_decode( const sDZRCOBS_decodectx *aDecodeCtx,
 	return DZRCOBS_RET_SUCCESS;
 }
 
+/**
+ * @brief Walks the codes of a frame, as dzrcobs_decode does, without
+ *        writing. Runs are skipped, so the data and the CRC are not checked.
+ *
+ * @param aOutDecodedLen Size that the frame decodes to
+ * @param aOutHeadroom Max of bytes written minus bytes read, see dzrcobs_decode_inplace_headroom
+ */
+static eDZRCOBS_ret dzrcobs_decode_walk( const sDZRCOBS_decodectx *aDecodeCtx,
+																				 size_t *aOutDecodedLen,
+																				 size_t *aOutHeadroom )
+{
+	const uint8_t *pBeginEncoded = aDecodeCtx->srcBufEncoded;
+	const uint8_t *pReadEncoded	 = aDecodeCtx->srcBufEncoded + aDecodeCtx->srcBufEncodedLen - 3; // skip encoding and CRC
+
+	const uint8_t receivedUserEncoding = pReadEncoded[1];
+	const eDZRCOBS_encoding encoding	 = (eDZRCOBS_encoding)( receivedUserEncoding & 0x03 );
+
+	if( ( receivedUserEncoding == 0 ) || ( pReadEncoded[2] == 0 ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+	}
+
+	const sDICT_ctx *pDict	= NULL;
+	uint8_t jumpCodeBitmask = 0;
+
+	switch( encoding )
+	{
+	case DZRCOBS_PLAIN:
+		jumpCodeBitmask = DZRCOBS_CODE_JUMP_PLAIN;
+		break;
+	case DZRCOBS_USING_DICT_1:
+	case DZRCOBS_USING_DICT_2:
+		jumpCodeBitmask = DZRCOBS_CODE_JUMP;
+
+		pDict = aDecodeCtx->pDict[encoding - DZRCOBS_USING_DICT_1];
+		if( pDict == NULL )
+		{
+			return DZRCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE;
+		}
+		break;
+
+	case DZRCOBS_RESERVED:
+	default:
+		return DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		break;
+	}
+
+	size_t totalWrite = 0;
+	size_t totalRead	= 2; // frame header
+
+	// Bytes written minus bytes read, only a dictionary word makes it grow
+	ptrdiff_t maxExcess = 0;
+
+	bool is_end_of_code_a_zero = false;
+
+	while( pReadEncoded >= pBeginEncoded )
+	{
+		uint8_t code = *pReadEncoded--;
+		totalRead++;
+
+		if( ( encoding == DZRCOBS_PLAIN ) || ( code < DZRCOBS_DICTIONARY_BITMASK ) )
+		{
+			const bool is_code_jump_delimiter = ( ( code & jumpCodeBitmask ) == jumpCodeBitmask );
+
+			if( !is_code_jump_delimiter )
+			{
+				is_end_of_code_a_zero = ( encoding == DZRCOBS_PLAIN ) ? true : ( ( code & DZRCOBS_NEXTCODE_BITMASK ) == 0 );
+			}
+
+			code &= jumpCodeBitmask;
+
+			if( code == 0 )
+			{
+				return DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+			}
+
+			code--;
+
+			if( (size_t)( pReadEncoded + 1 - pBeginEncoded ) < code )
+			{
+				return DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+			}
+
+			pReadEncoded -= code;
+			totalRead += code;
+			totalWrite += code;
+
+			const bool is_zero_written = ( ( code == 0 ) || is_end_of_code_a_zero ) && ( pReadEncoded >= pBeginEncoded ) &&
+																	 ( *pReadEncoded != jumpCodeBitmask );
+
+			if( is_zero_written )
+			{
+				totalWrite++;
+			}
+		}
+		else
+		{
+			const uint8_t dictIdx = (uint8_t)( code & ~DZRCOBS_DICTIONARY_BITMASK );
+			uint8_t wordSize			= 0;
+
+			if( ( dictIdx >= DICT_MAX_WORDS ) || ( dzrcobs_dictionary_get( pDict, dictIdx, &wordSize ) == NULL ) )
+			{
+				return DZRCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY;
+			}
+
+			totalWrite += wordSize;
+
+			const ptrdiff_t excess = (ptrdiff_t)totalWrite - (ptrdiff_t)totalRead;
+
+			if( excess > maxExcess )
+			{
+				maxExcess = excess;
+			}
+		}
+	}
+
+	*aOutDecodedLen = totalWrite;
+	*aOutHeadroom		= (size_t)maxExcess;
+
+	return DZRCOBS_RET_SUCCESS;
+}
+
+eDZRCOBS_ret dzrcobs_decode_inplace_headroom( const sDZRCOBS_decodectx *aDecodeCtx, size_t *aOutHeadroom )
+{
+	if( ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aOutHeadroom ) || ( aDecodeCtx->srcBufEncodedLen < 3 ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
+	size_t decodedLen = 0;
+
+	return dzrcobs_decode_walk( aDecodeCtx, &decodedLen, aOutHeadroom );
+}
+
+eDZRCOBS_ret dzrcobs_decoded_size( const sDZRCOBS_decodectx *aDecodeCtx, size_t *aOutDecodedLen )
+{
+	if( ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aOutDecodedLen ) || ( aDecodeCtx->srcBufEncodedLen < 3 ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
+	size_t headroom = 0;
+
+	return dzrcobs_decode_walk( aDecodeCtx, aOutDecodedLen, &headroom );
+}
+
+// dzrcobs_decode_left_aligned, without the argument checks
+static eDZRCOBS_ret dzrcobs_decode_left_aligned_frame( const sDZRCOBS_decodectx *aDecodeCtx,
+																											 size_t *aOutDecodedLen,
+																											 uint8_t *aOutUser6bitDataRightAlgn )
+{
+	size_t decodedLen = 0;
+	size_t headroom		= 0;
+
+	eDZRCOBS_ret ret = dzrcobs_decode_walk( aDecodeCtx, &decodedLen, &headroom );
+
+	if( ret != DZRCOBS_RET_SUCCESS )
+	{
+		// A CRC failure has priority over any decoding error, same as on dzrcobs_decode
+		const uint8_t crc = DZRCOBS_CRC_BLOCK(
+		 DZRCOBS_CRC_INIT_VAL, aDecodeCtx->srcBufEncoded, aDecodeCtx->srcBufEncodedLen - 1 ); // -1 removed CRC
+
+		if( !dzrcobs_is_crc_valid( crc, aDecodeCtx->srcBufEncoded[aDecodeCtx->srcBufEncodedLen - 1] ) )
+		{
+			return DZRCOBS_RET_ERR_CRC;
+		}
+
+		return ret;
+	}
+
+	if( decodedLen > aDecodeCtx->dstBufDecodedSize )
+	{
+		return DZRCOBS_RET_ERR_OVERFLOW;
+	}
+
+	// Right aligned on a destiny of the exact size is left aligned
+	sDZRCOBS_decodectx exactCtx = *aDecodeCtx;
+
+	// An empty frame writes nothing, but the destiny cannot be empty
+	uint8_t emptyFrameDst = 0;
+
+	if( decodedLen > 0 )
+	{
+		exactCtx.dstBufDecodedSize = decodedLen;
+	}
+	else
+	{
+		exactCtx.dstBufDecoded		 = &emptyFrameDst;
+		exactCtx.dstBufDecodedSize = 1;
+	}
+
+	uint8_t *decodedPos = NULL;
+
+	ret = dzrcobs_decode( &exactCtx, aOutDecodedLen, &decodedPos, aOutUser6bitDataRightAlgn );
+
+	DZRCOBS_ASSERT( ( ret != DZRCOBS_RET_SUCCESS ) || ( *aOutDecodedLen == decodedLen ) );
+
+	return ret;
+}
+
+eDZRCOBS_ret dzrcobs_decode_left_aligned( const sDZRCOBS_decodectx *aDecodeCtx,
+																					size_t *aOutDecodedLen,
+																					uint8_t *aOutUser6bitDataRightAlgn )
+{
+	if( ( !aDecodeCtx ) || ( !aDecodeCtx->srcBufEncoded ) || ( !aDecodeCtx->dstBufDecoded ) || ( !aOutDecodedLen ) ||
+			( aDecodeCtx->dstBufDecodedSize == 0 ) || ( aDecodeCtx->srcBufEncodedLen < 3 ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
+	return dzrcobs_decode_left_aligned_frame( aDecodeCtx, aOutDecodedLen, aOutUser6bitDataRightAlgn );
+}
+
+eDZRCOBS_ret dzrcobs_decode_batch( const sDZRCOBS_decodectx *aDecodeCtx,
+																	 sDZRCOBS_batch_result *aOutResults,
+																	 size_t aResultsSize,
+																	 size_t *aOutResultsCount,
+																	 size_t *aOutConsumed )
+{
+	if( ( !aDecodeCtx ) || ( ( !aDecodeCtx->srcBufEncoded ) && ( aDecodeCtx->srcBufEncodedLen > 0 ) ) ||
+			( !aDecodeCtx->dstBufDecoded ) || ( ( !aOutResults ) && ( aResultsSize > 0 ) ) || ( !aOutResultsCount ) ||
+			( !aOutConsumed ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
+	const uint8_t *pRead			= aDecodeCtx->srcBufEncoded;
+	const uint8_t *const pEnd = pRead + aDecodeCtx->srcBufEncodedLen;
+
+	// The dictionaries are taken once, only the buffers change per frame
+	sDZRCOBS_decodectx frameCtx = *aDecodeCtx;
+
+	size_t arenaUsed		= 0;
+	size_t resultsCount = 0;
+
+	while( ( resultsCount < aResultsSize ) && ( pRead < pEnd ) )
+	{
+		const size_t frameLen = dzrcobs_simd_find_zero( pRead, (size_t)( pEnd - pRead ) );
+
+		if( ( pRead + frameLen ) == pEnd )
+		{
+			// No delimiter, the frame continues on the next buffer
+			break;
+		}
+
+		const uint8_t *pNext = pRead + frameLen + 1;
+
+		if( frameLen == 0 )
+		{
+			pRead = pNext;
+			continue;
+		}
+
+		// Next frame on the way to the cache while this one is decoded
+		DZRCOBS_PREFETCH( pNext );
+		DZRCOBS_PREFETCH( pNext + DZRCOBS_CACHE_LINE_SIZE );
+
+		sDZRCOBS_batch_result *pResult = &aOutResults[resultsCount++];
+
+		pResult->offset		 = arenaUsed;
+		pResult->length		 = 0;
+		pResult->user6bits = 0;
+
+		if( frameLen < 3 )
+		{
+			pResult->status = DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
+		else
+		{
+			uint8_t *pArenaFree		 = aDecodeCtx->dstBufDecoded + arenaUsed;
+			const size_t arenaFree = aDecodeCtx->dstBufDecodedSize - arenaUsed;
+
+			frameCtx.srcBufEncoded		 = pRead;
+			frameCtx.srcBufEncodedLen	 = frameLen;
+			frameCtx.dstBufDecoded		 = pArenaFree;
+			frameCtx.dstBufDecodedSize = arenaFree;
+
+			size_t decodedLen = 0;
+			uint8_t user6bits = 0;
+
+			const uint8_t encoding = pRead[frameLen - DZRCOBS_FRAME_HEADER_SIZE] & 0x03;
+
+			if( ( encoding == DZRCOBS_PLAIN ) && ( arenaFree > 0 ) )
+			{
+				// A plain frame does not decode to more than its codes and data, so it
+				// is decoded right aligned just after its place and moved there,
+				// instead of walking the codes first to know its size
+				const size_t maxDecodedLen = frameLen - DZRCOBS_FRAME_HEADER_SIZE;
+
+				frameCtx.dstBufDecodedSize = ( maxDecodedLen < arenaFree ) ? maxDecodedLen : arenaFree;
+
+				uint8_t *pDecoded = NULL;
+
+				pResult->status = dzrcobs_decode( &frameCtx, &decodedLen, &pDecoded, &user6bits );
+
+				if( pResult->status == DZRCOBS_RET_SUCCESS )
+				{
+					memmove( pArenaFree, pDecoded, decodedLen );
+				}
+			}
+			else
+			{
+				pResult->status = dzrcobs_decode_left_aligned_frame( &frameCtx, &decodedLen, &user6bits );
+			}
+
+			if( pResult->status == DZRCOBS_RET_SUCCESS )
+			{
+				pResult->length		 = decodedLen;
+				pResult->user6bits = user6bits;
+				arenaUsed += decodedLen;
+			}
+		}
+
+		pRead = pNext;
+	}
+
+	*aOutResultsCount = resultsCount;
+	*aOutConsumed			= (size_t)( pRead - aDecodeCtx->srcBufEncoded );
+
+	return DZRCOBS_RET_SUCCESS;
+}
+
 // EOF
 // /////////////////////////////////////////////////////////////////////////////
@@ -17,10 +17,207 @@
 // Includes
 // /////////////////////////////////////////////////////////////////////////////
 #include "dzrcobs/dzrcobs_dictionary.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
 #include "dzrcobs_assert.h"
 
+#if DZRCOBS_DICT_ACCELERATOR
+
+// Number of seeds tried to build the perfect hash before give up
+#define DZRCOBS_DICT_ACCEL_MAX_SEEDS ( 64 )
+
+// Hashes a word (or key) together with its size
+static inline uint64_t dzrcobs_dictionary_hash( const uint8_t *aWord, uint8_t aWordSize, uint8_t aSeed )
+{
+	uint64_t key = aWordSize;
+
+	for( uint8_t i = 0; i < aWordSize; i++ )
+	{
+		key = ( key << 8 ) | aWord[i];
+	}
+
+	return ( key ^ ( aSeed * 0xD6E8FEB86659FD93ULL ) ) * 0x9E3779B97F4A7C15ULL;
+}
+
+#define DZRCOBS_DICT_HASH_BUCKET( hash ) ( (uint8_t)( ( hash ) >> 58 ) )
+#define DZRCOBS_DICT_HASH_SLOT( hash ) ( (uint8_t)( ( hash ) >> 32 ) )
+
+// Tries to place all words on the slots, using a displacement per bucket
+static bool dzrcobs_dictionary_accel_try_seed( sDICT_ctx *aCtx, uint8_t aSeed )
+{
+	sDICT_accel *accel = &aCtx->accel;
+
+	uint8_t wordBucket[DICT_MAX_WORDS];
+	uint8_t wordSlot[DICT_MAX_WORDS];
+	uint8_t bucketCount[DICT_ACCEL_BUCKETS];
+	uint8_t nWords = 0;
+
+	memset( bucketCount, 0, sizeof( bucketCount ) );
+	memset( accel->slots, 0, sizeof( accel->slots ) );
+	memset( accel->displacement, 0, sizeof( accel->displacement ) );
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *wordEntry = &aCtx->wordSizeTable[i];
+		const uint8_t *word							 = wordEntry->dictionaryBegin + 1;
+
+		for( uint8_t e = 0; e < wordEntry->nEntries; e++ )
+		{
+			const uint64_t hash = dzrcobs_dictionary_hash( word, wordEntry->strideSize - 1, aSeed );
+
+			wordBucket[nWords] = DZRCOBS_DICT_HASH_BUCKET( hash );
+			wordSlot[nWords]	 = DZRCOBS_DICT_HASH_SLOT( hash );
+			bucketCount[wordBucket[nWords]]++;
+
+			nWords++;
+			word += wordEntry->strideSize;
+		}
+	}
+
+	// Words are numbered in the same order of the global index
+	DZRCOBS_ASSERT( nWords <= DICT_MAX_WORDS );
+
+	// Place the largest buckets first
+	for( uint8_t count = nWords; count > 0; count-- )
+	{
+		for( uint8_t bucket = 0; bucket < DICT_ACCEL_BUCKETS; bucket++ )
+		{
+			if( bucketCount[bucket] != count )
+			{
+				continue;
+			}
+
+			bool isPlaced = false;
+
+			for( uint16_t displacement = 0; ( displacement < DICT_ACCEL_SLOTS ) && !isPlaced; displacement++ )
+			{
+				isPlaced = true;
+
+				for( uint8_t w = 0; w < nWords; w++ )
+				{
+					if( wordBucket[w] != bucket )
+					{
+						continue;
+					}
+
+					const uint8_t slot = (uint8_t)( wordSlot[w] + displacement );
+
+					if( accel->slots[slot] != 0 )
+					{
+						isPlaced = false;
+						break;
+					}
+
+					accel->slots[slot] = w + 1;
+				}
+
+				if( !isPlaced )
+				{
+					// Undo the words of this bucket already placed
+					for( uint8_t w = 0; w < nWords; w++ )
+					{
+						const uint8_t slot = (uint8_t)( wordSlot[w] + displacement );
+
+						if( ( wordBucket[w] == bucket ) && ( accel->slots[slot] == ( w + 1 ) ) )
+						{
+							accel->slots[slot] = 0;
+						}
+					}
+				}
+				else
+				{
+					accel->displacement[bucket] = (uint8_t)displacement;
+				}
+			}
+
+			if( !isPlaced )
+			{
+				return false;
+			}
+		}
+	}
+
+	accel->seed = aSeed;
+
+	return true;
+}
+
+static void dzrcobs_dictionary_accel_init( sDICT_ctx *aCtx )
+{
+	sDICT_accel *accel = &aCtx->accel;
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *wordEntry = &aCtx->wordSizeTable[i];
+		const uint8_t *word							 = wordEntry->dictionaryBegin + 1;
+
+		for( uint8_t e = 0; e < wordEntry->nEntries; e++ )
+		{
+			accel->firstByteTiers[word[0]] |= (uint8_t)( 1 << i );
+
+			// Words with the same first byte share the bucket
+			const uint8_t bucketBit = (uint8_t)( 1 << ( ( word[0] ^ ( word[0] >> 3 ) ^ ( word[0] >> 6 ) ) & 0x07 ) );
+
+			accel->pairNibbleMasks[0][word[0] & 0x0F] |= bucketBit;
+			accel->pairNibbleMasks[1][word[0] >> 4] |= bucketBit;
+			accel->pairNibbleMasks[2][word[1] & 0x0F] |= bucketBit;
+			accel->pairNibbleMasks[3][word[1] >> 4] |= bucketBit;
+
+			const uint8_t wordSize = wordEntry->strideSize - 1;
+			const uint8_t index		 = (uint8_t)( wordEntry->globalIndex + e - 1 );
+
+			memcpy( &accel->flatWords[index][DICT_FLAT_WORD_SIZE - wordSize], word, wordSize );
+			accel->flatWordSize[index] = wordSize;
+
+			word += wordEntry->strideSize;
+		}
+	}
+
+	accel->isHashed = 0;
+
+	for( uint8_t seed = 0; seed < DZRCOBS_DICT_ACCEL_MAX_SEEDS; seed++ )
+	{
+		if( dzrcobs_dictionary_accel_try_seed( aCtx, seed ) )
+		{
+			accel->isHashed = 1;
+			break;
+		}
+	}
+}
+
+// Same as DZRCOBS_Dictionary_SearchKeyOnEntry, using the perfect hash
+static inline uint8_t dzrcobs_dictionary_accel_search( const sDICT_ctx *aCtx,
+																											 const uint8_t *aSearchKey,
+																											 const sDICT_wordentry *aDictWordEntry )
+{
+	const sDICT_accel *accel = &aCtx->accel;
+	const uint8_t wordSize	 = aDictWordEntry->strideSize - 1;
+
+	const uint64_t hash = dzrcobs_dictionary_hash( aSearchKey, wordSize, accel->seed );
+	const uint8_t slot	= (uint8_t)( DZRCOBS_DICT_HASH_SLOT( hash ) + accel->displacement[DZRCOBS_DICT_HASH_BUCKET( hash )] );
+
+	// Slots store the global index, also 0 (empty) wraps to out of range
+	const uint8_t idx				= accel->slots[slot];
+	const uint8_t idxOnEntry = (uint8_t)( idx - aDictWordEntry->globalIndex );
+
+	if( idxOnEntry > aDictWordEntry->lastIndex )
+	{
+		return 0;
+	}
+
+	const uint8_t *entry = aDictWordEntry->dictionaryBegin + 1 + ( (size_t)aDictWordEntry->strideSize * idxOnEntry );
+
+	if( memcmp( aSearchKey, entry, wordSize ) != 0 )
+	{
+		return 0;
+	}
+
+	return idx;
+}
+
+#endif
+
 eDICT_ret dzrcobs_dictionary_init( sDICT_ctx *aCtx, const char *aDictionary, size_t aDictionarySize )
 {
 	if( ( !aCtx ) || ( !aDictionary ) || ( aDictionarySize < 3 ) )
@@ -90,16 +287,24 @@ eDICT_ret dzrcobs_dictionary_init( sDICT_ctx *aCtx, const char *aDictionary, siz
 		currentWordIndex++;
 	}
 
+	// The last word size is closed here, there is no next size to close it
+	DZRCOBS_ASSERT( pWordEntry != NULL );
+	pWordEntry->lastIndex = pWordEntry->nEntries - 1;
+
 	DZRCOBS_ASSERT( ( aCtx->wordSizeTable[0].strideSize == ( 2 + 1 ) ) || ( aCtx->wordSizeTable[0].nEntries == 0 ) );
 	DZRCOBS_ASSERT( ( aCtx->wordSizeTable[1].strideSize == ( 3 + 1 ) ) || ( aCtx->wordSizeTable[1].nEntries == 0 ) );
 	DZRCOBS_ASSERT( ( aCtx->wordSizeTable[2].strideSize == ( 4 + 1 ) ) || ( aCtx->wordSizeTable[2].nEntries == 0 ) );
 	DZRCOBS_ASSERT( ( aCtx->wordSizeTable[3].strideSize == ( 5 + 1 ) ) || ( aCtx->wordSizeTable[3].nEntries == 0 ) );
 
+#if DZRCOBS_DICT_ACCELERATOR
+	dzrcobs_dictionary_accel_init( aCtx );
+#endif
+
 	return DICT_RET_SUCCESS;
 }
 
 #define DZRCOBS_MIN_DICT_WORD_SIZE ( 2 )
-#define DZRCOBS_MAX_DICT_WORD_SIZE ( 5 )
+#define DZRCOBS_MAX_DICT_WORD_SIZE ( DICT_MAX_WORD_SIZE )
 #define DZRCOBS_MAX_DICT_WORD_COUNTING ( 126 )
 
 eDICTVALID_ret dzrcobs_dictionary_isvalid( const char *aDictionary, size_t aDictionarySize )
@@ -149,8 +354,9 @@ eDICTVALID_ret dzrcobs_dictionary_isvalid( const char *aDictionary, size_t aDict
 		}
 		else
 		{
+			// The buffer that is not in use, so the swap below keeps the two apart
 			previousWordLen			= currentWordLen;
-			pPreviousWordBuffer = tmpBuffer[1];
+			pPreviousWordBuffer = ( pCurrentWordBuffer == tmpBuffer[0] ) ? tmpBuffer[1] : tmpBuffer[0];
 			differentWordCount++;
 
 			if( differentWordCount > DICT_MAX_DIFFERENTWORDSIZES )
@@ -241,6 +447,11 @@ uint8_t dzrcobs_dictionary_search( const sDICT_ctx *aCtx,
 	DZRCOBS_ASSERT( ( aCtx->wordSizeTable[2].strideSize == ( 4 + 1 ) ) || ( aCtx->wordSizeTable[2].nEntries == 0 ) );
 	DZRCOBS_ASSERT( ( aCtx->wordSizeTable[3].strideSize == ( 5 + 1 ) ) || ( aCtx->wordSizeTable[3].nEntries == 0 ) );
 
+	if( aCtx->searchFunc != NULL )
+	{
+		return aCtx->searchFunc( aSearchKey, aSearchKeySize, aOutKeySizeFound );
+	}
+
 	if( aSearchKeySize < aCtx->minWordSize )
 	{
 		return 0;
@@ -253,13 +464,33 @@ uint8_t dzrcobs_dictionary_search( const sDICT_ctx *aCtx,
 
 	const size_t compareKeySize = aSearchKeySize + 1; // this is just to fake a dummy header byte
 
+#if DZRCOBS_DICT_ACCELERATOR
+	// Word sizes that have a word starting with this byte
+	const uint8_t tiers = aCtx->accel.firstByteTiers[aSearchKey[0]];
+
+	if( tiers == 0 )
+	{
+		return 0;
+	}
+#endif
+
 	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
 	{
 		const sDICT_wordentry *wordEntry = &aCtx->wordSizeTable[i];
 
 		if( ( wordEntry->nEntries > 0 ) && ( compareKeySize >= wordEntry->strideSize ) )
 		{
+#if DZRCOBS_DICT_ACCELERATOR
+			if( ( ( tiers >> i ) & 1 ) == 0 )
+			{
+				continue;
+			}
+
+			const uint8_t idxFound = aCtx->accel.isHashed ? dzrcobs_dictionary_accel_search( aCtx, aSearchKey, wordEntry )
+																										: DZRCOBS_Dictionary_SearchKeyOnEntry( aSearchKey, wordEntry );
+#else
 			const uint8_t idxFound = DZRCOBS_Dictionary_SearchKeyOnEntry( aSearchKey, wordEntry );
+#endif
 
 			if( idxFound != 0 )
 			{
@@ -273,6 +504,36 @@ uint8_t dzrcobs_dictionary_search( const sDICT_ctx *aCtx,
 	return 0;
 }
 
+uint8_t dzrcobs_dictionary_search_size( const sDICT_ctx *aCtx, const uint8_t *aSearchKey, size_t aWordSize )
+{
+	DZRCOBS_ASSERT( aCtx != NULL );
+	DZRCOBS_ASSERT( aSearchKey != NULL );
+
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *wordEntry = &aCtx->wordSizeTable[i];
+
+		if( ( wordEntry->nEntries == 0 ) || ( wordEntry->strideSize != ( aWordSize + 1 ) ) )
+		{
+			continue;
+		}
+
+#if DZRCOBS_DICT_ACCELERATOR
+		if( ( ( aCtx->accel.firstByteTiers[aSearchKey[0]] >> i ) & 1 ) == 0 )
+		{
+			return 0;
+		}
+
+		return aCtx->accel.isHashed ? dzrcobs_dictionary_accel_search( aCtx, aSearchKey, wordEntry )
+																: DZRCOBS_Dictionary_SearchKeyOnEntry( aSearchKey, wordEntry );
+#else
+		return DZRCOBS_Dictionary_SearchKeyOnEntry( aSearchKey, wordEntry );
+#endif
+	}
+
+	return 0;
+}
+
 const uint8_t *dzrcobs_dictionary_get( const sDICT_ctx *aCtx, uint8_t aIndex, uint8_t *aOutWordSize )
 {
 	DZRCOBS_ASSERT( aCtx != NULL );
@@ -0,0 +1,145 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_framer.c
+///	@brief Splits a continuous byte stream in 0x00 delimited frames
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzrcobs/dzrcobs_framer.h>
+#include <string.h>
+#include "dzrcobs_assert.h"
+#include "dzrcobs_simd.h"
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+eDZRCOBS_framer_ret dzrcobs_framer_init( sDZRCOBS_framer *aCtx, uint8_t *aBuf, size_t aBufSize )
+{
+	if( ( !aCtx ) || ( !aBuf ) || ( aBufSize == 0 ) )
+	{
+		return DZRCOBS_FRAMER_RET_ERR_BAD_ARG;
+	}
+
+	aCtx->pBuf				 = aBuf;
+	aCtx->bufSize			 = aBufSize;
+	aCtx->bufLen			 = 0;
+	aCtx->pChunk			 = NULL;
+	aCtx->chunkLen		 = 0;
+	aCtx->isDiscarding = false;
+
+	return DZRCOBS_FRAMER_RET_NEED_DATA;
+}
+
+eDZRCOBS_framer_ret dzrcobs_framer_feed( sDZRCOBS_framer *aCtx, const uint8_t *aChunk, size_t aChunkLen )
+{
+	if( ( !aCtx ) || ( ( !aChunk ) && ( aChunkLen > 0 ) ) )
+	{
+		return DZRCOBS_FRAMER_RET_ERR_BAD_ARG;
+	}
+
+	if( aCtx->chunkLen > 0 )
+	{
+		return DZRCOBS_FRAMER_RET_ERR_BUSY;
+	}
+
+	aCtx->pChunk	 = aChunk;
+	aCtx->chunkLen = aChunkLen;
+
+	return DZRCOBS_FRAMER_RET_NEED_DATA;
+}
+
+eDZRCOBS_framer_ret dzrcobs_framer_pop( sDZRCOBS_framer *aCtx, const uint8_t **aOutFrame, size_t *aOutFrameLen )
+{
+	if( ( !aCtx ) || ( !aOutFrame ) || ( !aOutFrameLen ) )
+	{
+		return DZRCOBS_FRAMER_RET_ERR_BAD_ARG;
+	}
+
+	DZRCOBS_ASSERT( aCtx->bufLen <= aCtx->bufSize );
+
+	while( aCtx->chunkLen > 0 )
+	{
+		const uint8_t *pFrameBytes = aCtx->pChunk;
+		const size_t frameBytesLen = dzrcobs_simd_find_zero( pFrameBytes, aCtx->chunkLen );
+		const bool hasDelimiter		 = frameBytesLen < aCtx->chunkLen;
+
+		// Consume the frame bytes and its delimiter, if it is on this chunk
+		const size_t consumed = frameBytesLen + ( hasDelimiter ? 1 : 0 );
+
+		aCtx->pChunk += consumed;
+		aCtx->chunkLen -= consumed;
+
+		if( aCtx->isDiscarding )
+		{
+			aCtx->isDiscarding = !hasDelimiter;
+			continue;
+		}
+
+		if( ( aCtx->bufLen + frameBytesLen ) > aCtx->bufSize )
+		{
+			aCtx->bufLen			 = 0;
+			aCtx->isDiscarding = !hasDelimiter;
+
+			return DZRCOBS_FRAMER_RET_ERR_OVERSIZE;
+		}
+
+		if( !hasDelimiter )
+		{
+			// The frame continues on the next chunk
+			memcpy( aCtx->pBuf + aCtx->bufLen, pFrameBytes, frameBytesLen );
+			aCtx->bufLen += frameBytesLen;
+
+			break;
+		}
+
+		if( aCtx->bufLen == 0 )
+		{
+			if( frameBytesLen == 0 )
+			{
+				continue;
+			}
+
+			// All the frame is on the chunk, no copy needed
+			*aOutFrame		= pFrameBytes;
+			*aOutFrameLen = frameBytesLen;
+
+			return DZRCOBS_FRAMER_RET_FRAME;
+		}
+
+		memcpy( aCtx->pBuf + aCtx->bufLen, pFrameBytes, frameBytesLen );
+
+		*aOutFrame		= aCtx->pBuf;
+		*aOutFrameLen = aCtx->bufLen + frameBytesLen;
+
+		aCtx->bufLen = 0;
+
+		return DZRCOBS_FRAMER_RET_FRAME;
+	}
+
+	return DZRCOBS_FRAMER_RET_NEED_DATA;
+}
+
+void dzrcobs_framer_resync( sDZRCOBS_framer *aCtx )
+{
+	if( !aCtx )
+	{
+		return;
+	}
+
+	aCtx->bufLen			 = 0;
+	aCtx->isDiscarding = true;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,638 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_simd.c
+///	@brief Vectorized scan kernels, with SSSE3 / AVX2 / AVX-512 and scalar (SWAR)
+///        versions, chosen at runtime from the CPU features. With
+///        DZRCOBS_CRC_TABLE 3 the CRC backend is chosen with them (crc8.h)
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include "dzrcobs_simd.h"
+#include <string.h>
+#include "crc8.h"
+#include "dzrcobs_assert.h"
+
+#if DZRCOBS_SIMD_DISPATCH
+#include <immintrin.h>
+#include <stdlib.h>
+#elif DZRCOBS_SIMD >= DZRCOBS_SIMD_AVX2
+#include <immintrin.h>
+#elif DZRCOBS_SIMD == DZRCOBS_SIMD_SSE2
+#include <emmintrin.h>
+#if defined( __SSSE3__ )
+#include <tmmintrin.h>
+#endif
+#endif
+
+#if( DZRCOBS_SIMD_DISPATCH || ( DZRCOBS_SIMD != DZRCOBS_SIMD_SCALAR ) ) && defined( _MSC_VER ) && !defined( __clang__ )
+#include <intrin.h>
+#endif
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+#define DZRCOBS_SWAR_ONES ( 0x0101010101010101ULL )
+#define DZRCOBS_SWAR_HIGHS ( 0x8080808080808080ULL )
+
+// Non zero if any of the 8 bytes of v is 0x00
+#define DZRCOBS_SWAR_HAS_ZERO( v ) ( ( ( v ) - DZRCOBS_SWAR_ONES ) & ~( v ) & DZRCOBS_SWAR_HIGHS )
+
+// Kernel variants that are built. The runtime dispatch builds all of them,
+// each one for its own instruction set, so the library baseline stays the
+// compiler default. Else only the variants up to DZRCOBS_SIMD are built.
+#if DZRCOBS_SIMD_DISPATCH
+#define DZRCOBS_SIMD_HAS_128 1
+#define DZRCOBS_SIMD_HAS_SHUFFLE 1
+#define DZRCOBS_SIMD_HAS_256 1
+#define DZRCOBS_SIMD_HAS_512 1
+#else
+#define DZRCOBS_SIMD_HAS_128 ( DZRCOBS_SIMD >= DZRCOBS_SIMD_SSE2 )
+// Byte shuffle (pshufb) is SSSE3, it is not part of the SSE2 baseline
+#if( DZRCOBS_SIMD >= DZRCOBS_SIMD_AVX2 ) || ( ( DZRCOBS_SIMD == DZRCOBS_SIMD_SSE2 ) && defined( __SSSE3__ ) )
+#define DZRCOBS_SIMD_HAS_SHUFFLE 1
+#else
+#define DZRCOBS_SIMD_HAS_SHUFFLE 0
+#endif
+#define DZRCOBS_SIMD_HAS_256 ( DZRCOBS_SIMD >= DZRCOBS_SIMD_AVX2 )
+#define DZRCOBS_SIMD_HAS_512 ( DZRCOBS_SIMD >= DZRCOBS_SIMD_AVX512 )
+#endif
+
+#if DZRCOBS_SIMD_DISPATCH && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define DZRCOBS_TARGET_SSSE3 __attribute__( ( target( "ssse3" ) ) )
+#define DZRCOBS_TARGET_AVX2 __attribute__( ( target( "avx2" ) ) )
+#define DZRCOBS_TARGET_AVX512 __attribute__( ( target( "avx2,avx512f,avx512bw" ) ) )
+#else
+// MSVC builds the intrinsics of any instruction set
+#define DZRCOBS_TARGET_SSSE3
+#define DZRCOBS_TARGET_AVX2
+#define DZRCOBS_TARGET_AVX512
+#endif
+
+#if DZRCOBS_SIMD_DISPATCH
+typedef size_t ( *dzrcobs_simd_find_zero_funcPtr )( const uint8_t *aBuf, size_t aSize );
+typedef size_t ( *dzrcobs_simd_find_dict_candidate_funcPtr )( const uint8_t aPairNibbleMasks[4][16],
+																															const uint8_t *aBuf,
+																															size_t aSize );
+
+#if DZRCOBS_CRC_DISPATCH
+typedef uint8_t ( *dzrcobs_simd_crc8_block_funcPtr )( uint8_t aCrc, const uint8_t *aBuf, size_t aSize );
+#endif
+
+typedef struct s_DZRCOBS_simd_kernels
+{
+	dzrcobs_simd_find_zero_funcPtr findZero;
+	dzrcobs_simd_find_dict_candidate_funcPtr findDictCandidate;
+} sDZRCOBS_simd_kernels;
+#endif
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+#if DZRCOBS_SIMD_HAS_128
+static inline unsigned dzrcobs_simd_ctz32( uint32_t aMask )
+{
+	DZRCOBS_ASSERT( aMask != 0 );
+
+#if defined( _MSC_VER ) && !defined( __clang__ )
+	unsigned long idx;
+	_BitScanForward( &idx, aMask );
+	return (unsigned)idx;
+#else
+	return (unsigned)__builtin_ctz( aMask );
+#endif
+}
+#endif
+
+#if DZRCOBS_SIMD_HAS_512
+static inline unsigned dzrcobs_simd_ctz64( uint64_t aMask )
+{
+	DZRCOBS_ASSERT( aMask != 0 );
+
+	const uint32_t low = (uint32_t)aMask;
+
+	return ( low != 0 ) ? dzrcobs_simd_ctz32( low ) : ( 32U + dzrcobs_simd_ctz32( (uint32_t)( aMask >> 32 ) ) );
+}
+#endif
+
+static size_t dzrcobs_simd_find_zero_scalar( const uint8_t *aBuf, size_t aSize )
+{
+	size_t idx = 0;
+
+	// 8 bytes per iteration, only the word that has a zero is walked byte a byte
+	while( ( idx + sizeof( uint64_t ) ) <= aSize )
+	{
+		uint64_t word;
+		memcpy( &word, aBuf + idx, sizeof( uint64_t ) );
+
+		if( DZRCOBS_SWAR_HAS_ZERO( word ) )
+		{
+			break;
+		}
+
+		idx += sizeof( uint64_t );
+	}
+
+	while( ( idx < aSize ) && ( aBuf[idx] != 0 ) )
+	{
+		idx++;
+	}
+
+	return idx;
+}
+
+// Each variant scans its vector size and leaves the tail to the previous one
+
+#if DZRCOBS_SIMD_HAS_128
+DZRCOBS_TARGET_SSSE3 static size_t dzrcobs_simd_find_zero_ssse3( const uint8_t *aBuf, size_t aSize )
+{
+	const __m128i zero128 = _mm_setzero_si128();
+	size_t idx						= 0;
+
+	while( ( idx + sizeof( __m128i ) ) <= aSize )
+	{
+		const __m128i block = _mm_loadu_si128( (const __m128i *)( aBuf + idx ) );
+		const uint32_t mask = (uint32_t)_mm_movemask_epi8( _mm_cmpeq_epi8( block, zero128 ) );
+
+		if( mask != 0 )
+		{
+			return idx + dzrcobs_simd_ctz32( mask );
+		}
+
+		idx += sizeof( __m128i );
+	}
+
+	return idx + dzrcobs_simd_find_zero_scalar( aBuf + idx, aSize - idx );
+}
+#endif
+
+#if DZRCOBS_SIMD_HAS_256
+DZRCOBS_TARGET_AVX2 static size_t dzrcobs_simd_find_zero_avx2( const uint8_t *aBuf, size_t aSize )
+{
+	const __m256i zero256 = _mm256_setzero_si256();
+	size_t idx						= 0;
+
+	while( ( idx + sizeof( __m256i ) ) <= aSize )
+	{
+		const __m256i block = _mm256_loadu_si256( (const __m256i *)( aBuf + idx ) );
+		const uint32_t mask = (uint32_t)_mm256_movemask_epi8( _mm256_cmpeq_epi8( block, zero256 ) );
+
+		if( mask != 0 )
+		{
+			return idx + dzrcobs_simd_ctz32( mask );
+		}
+
+		idx += sizeof( __m256i );
+	}
+
+	return idx + dzrcobs_simd_find_zero_ssse3( aBuf + idx, aSize - idx );
+}
+#endif
+
+#if DZRCOBS_SIMD_HAS_512
+DZRCOBS_TARGET_AVX512 static size_t dzrcobs_simd_find_zero_avx512( const uint8_t *aBuf, size_t aSize )
+{
+	const __m512i zero512 = _mm512_setzero_si512();
+	size_t idx						= 0;
+
+	while( ( idx + sizeof( __m512i ) ) <= aSize )
+	{
+		const __m512i block = _mm512_loadu_si512( (const void *)( aBuf + idx ) );
+		const uint64_t mask = (uint64_t)_mm512_cmpeq_epi8_mask( block, zero512 );
+
+		if( mask != 0 )
+		{
+			return idx + dzrcobs_simd_ctz64( mask );
+		}
+
+		idx += sizeof( __m512i );
+	}
+
+	return idx + dzrcobs_simd_find_zero_avx2( aBuf + idx, aSize - idx );
+}
+#endif
+
+// Each position also reads the next byte, so vectors stop one byte before the end
+
+static size_t dzrcobs_simd_find_dict_candidate_scalar( const uint8_t aPairNibbleMasks[4][16],
+																											 const uint8_t *aBuf,
+																											 size_t aSize )
+{
+	size_t idx = 0;
+
+	while( ( idx + 1 ) < aSize )
+	{
+		const uint8_t byte0 = aBuf[idx];
+		const uint8_t byte1 = aBuf[idx + 1];
+
+		if( aPairNibbleMasks[0][byte0 & 0x0F] & aPairNibbleMasks[1][byte0 >> 4] & aPairNibbleMasks[2][byte1 & 0x0F] &
+				aPairNibbleMasks[3][byte1 >> 4] )
+		{
+			return idx;
+		}
+
+		idx++;
+	}
+
+	return aSize;
+}
+
+#if DZRCOBS_SIMD_HAS_SHUFFLE
+// Candidate bitmask of 16 positions, bit set where all four nibble lookups share a bucket
+DZRCOBS_TARGET_SSSE3 static inline uint32_t dzrcobs_simd_dict_candidates16( const __m128i aMasks[4], const uint8_t *aBuf )
+{
+	const __m128i nibble = _mm_set1_epi8( 0x0F );
+	const __m128i byte0	 = _mm_loadu_si128( (const __m128i *)aBuf );
+	const __m128i byte1	 = _mm_loadu_si128( (const __m128i *)( aBuf + 1 ) );
+
+	__m128i buckets = _mm_shuffle_epi8( aMasks[0], _mm_and_si128( byte0, nibble ) );
+	buckets = _mm_and_si128( buckets, _mm_shuffle_epi8( aMasks[1], _mm_and_si128( _mm_srli_epi16( byte0, 4 ), nibble ) ) );
+	buckets = _mm_and_si128( buckets, _mm_shuffle_epi8( aMasks[2], _mm_and_si128( byte1, nibble ) ) );
+	buckets = _mm_and_si128( buckets, _mm_shuffle_epi8( aMasks[3], _mm_and_si128( _mm_srli_epi16( byte1, 4 ), nibble ) ) );
+
+	return (uint32_t)_mm_movemask_epi8( _mm_cmpeq_epi8( buckets, _mm_setzero_si128() ) ) ^ 0xFFFFU;
+}
+
+DZRCOBS_TARGET_SSSE3 static size_t dzrcobs_simd_find_dict_candidate_ssse3( const uint8_t aPairNibbleMasks[4][16],
+																																					 const uint8_t *aBuf,
+																																					 size_t aSize )
+{
+	__m128i masks128[4];
+	size_t idx = 0;
+
+	for( size_t i = 0; i < 4; i++ )
+	{
+		masks128[i] = _mm_loadu_si128( (const __m128i *)aPairNibbleMasks[i] );
+	}
+
+	while( ( idx + sizeof( __m128i ) + 1 ) <= aSize )
+	{
+		const uint32_t candidates = dzrcobs_simd_dict_candidates16( masks128, aBuf + idx );
+
+		if( candidates != 0 )
+		{
+			return idx + dzrcobs_simd_ctz32( candidates );
+		}
+
+		idx += sizeof( __m128i );
+	}
+
+	return idx + dzrcobs_simd_find_dict_candidate_scalar( aPairNibbleMasks, aBuf + idx, aSize - idx );
+}
+#endif
+
+#if DZRCOBS_SIMD_HAS_256
+DZRCOBS_TARGET_AVX2 static inline uint32_t dzrcobs_simd_dict_candidates32( const __m256i aMasks[4], const uint8_t *aBuf )
+{
+	const __m256i nibble = _mm256_set1_epi8( 0x0F );
+	const __m256i byte0	 = _mm256_loadu_si256( (const __m256i *)aBuf );
+	const __m256i byte1	 = _mm256_loadu_si256( (const __m256i *)( aBuf + 1 ) );
+
+	__m256i buckets = _mm256_shuffle_epi8( aMasks[0], _mm256_and_si256( byte0, nibble ) );
+	buckets =
+	 _mm256_and_si256( buckets, _mm256_shuffle_epi8( aMasks[1], _mm256_and_si256( _mm256_srli_epi16( byte0, 4 ), nibble ) ) );
+	buckets = _mm256_and_si256( buckets, _mm256_shuffle_epi8( aMasks[2], _mm256_and_si256( byte1, nibble ) ) );
+	buckets =
+	 _mm256_and_si256( buckets, _mm256_shuffle_epi8( aMasks[3], _mm256_and_si256( _mm256_srli_epi16( byte1, 4 ), nibble ) ) );
+
+	return ~(uint32_t)_mm256_movemask_epi8( _mm256_cmpeq_epi8( buckets, _mm256_setzero_si256() ) );
+}
+
+DZRCOBS_TARGET_AVX2 static size_t dzrcobs_simd_find_dict_candidate_avx2( const uint8_t aPairNibbleMasks[4][16],
+																																				 const uint8_t *aBuf,
+																																				 size_t aSize )
+{
+	__m256i masks256[4];
+	size_t idx = 0;
+
+	for( size_t i = 0; i < 4; i++ )
+	{
+		masks256[i] = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i *)aPairNibbleMasks[i] ) );
+	}
+
+	while( ( idx + sizeof( __m256i ) + 1 ) <= aSize )
+	{
+		const uint32_t candidates = dzrcobs_simd_dict_candidates32( masks256, aBuf + idx );
+
+		if( candidates != 0 )
+		{
+			return idx + dzrcobs_simd_ctz32( candidates );
+		}
+
+		idx += sizeof( __m256i );
+	}
+
+	return idx + dzrcobs_simd_find_dict_candidate_ssse3( aPairNibbleMasks, aBuf + idx, aSize - idx );
+}
+#endif
+
+#if DZRCOBS_SIMD_HAS_512
+DZRCOBS_TARGET_AVX512 static inline uint64_t dzrcobs_simd_dict_candidates64( const __m512i aMasks[4], const uint8_t *aBuf )
+{
+	const __m512i nibble = _mm512_set1_epi8( 0x0F );
+	const __m512i byte0	 = _mm512_loadu_si512( (const void *)aBuf );
+	const __m512i byte1	 = _mm512_loadu_si512( (const void *)( aBuf + 1 ) );
+
+	__m512i buckets = _mm512_shuffle_epi8( aMasks[0], _mm512_and_si512( byte0, nibble ) );
+	buckets =
+	 _mm512_and_si512( buckets, _mm512_shuffle_epi8( aMasks[1], _mm512_and_si512( _mm512_srli_epi16( byte0, 4 ), nibble ) ) );
+	buckets = _mm512_and_si512( buckets, _mm512_shuffle_epi8( aMasks[2], _mm512_and_si512( byte1, nibble ) ) );
+	buckets =
+	 _mm512_and_si512( buckets, _mm512_shuffle_epi8( aMasks[3], _mm512_and_si512( _mm512_srli_epi16( byte1, 4 ), nibble ) ) );
+
+	// Bit set on the non zero bytes
+	return (uint64_t)_mm512_test_epi8_mask( buckets, buckets );
+}
+
+DZRCOBS_TARGET_AVX512 static size_t dzrcobs_simd_find_dict_candidate_avx512( const uint8_t aPairNibbleMasks[4][16],
+																																						 const uint8_t *aBuf,
+																																						 size_t aSize )
+{
+	__m512i masks512[4];
+	size_t idx = 0;
+
+	for( size_t i = 0; i < 4; i++ )
+	{
+		masks512[i] = _mm512_broadcast_i32x4( _mm_loadu_si128( (const __m128i *)aPairNibbleMasks[i] ) );
+	}
+
+	while( ( idx + sizeof( __m512i ) + 1 ) <= aSize )
+	{
+		const uint64_t candidates = dzrcobs_simd_dict_candidates64( masks512, aBuf + idx );
+
+		if( candidates != 0 )
+		{
+			return idx + dzrcobs_simd_ctz64( candidates );
+		}
+
+		idx += sizeof( __m512i );
+	}
+
+	return idx + dzrcobs_simd_find_dict_candidate_avx2( aPairNibbleMasks, aBuf + idx, aSize - idx );
+}
+#endif
+
+#if DZRCOBS_SIMD_DISPATCH
+
+static const sDZRCOBS_simd_kernels s_DZRCOBS_SimdKernelsOfLevel[DZRCOBS_SIMD_LEVEL_N] = {
+	{ dzrcobs_simd_find_zero_scalar, dzrcobs_simd_find_dict_candidate_scalar },
+	{ dzrcobs_simd_find_zero_ssse3, dzrcobs_simd_find_dict_candidate_ssse3 },
+	{ dzrcobs_simd_find_zero_avx2, dzrcobs_simd_find_dict_candidate_avx2 },
+	{ dzrcobs_simd_find_zero_avx512, dzrcobs_simd_find_dict_candidate_avx512 },
+};
+
+// The scalar kernels are valid on any CPU until dzrcobs_simd_init resolves the
+// level, at load time, before main and any thread that encodes or decodes. After
+// that they are only changed by dzrcobs_simd_set_level.
+static sDZRCOBS_simd_kernels s_DZRCOBS_SimdKernels = { dzrcobs_simd_find_zero_scalar,
+																											 dzrcobs_simd_find_dict_candidate_scalar };
+static eDZRCOBS_simd_level s_DZRCOBS_SimdLevel		 = DZRCOBS_SIMD_LEVEL_SCALAR;
+
+#if DZRCOBS_CRC_DISPATCH
+// The vector levels use the carry-less multiply CRC, when the CPU has it
+static dzrcobs_simd_crc8_block_funcPtr s_DZRCOBS_SimdCrc8Block = dzrcobs_crc8_block_slicing8;
+#endif
+
+// Best level of the CPU, also checks that the OS saves the vector registers
+static eDZRCOBS_simd_level dzrcobs_simd_cpu_level( void )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512bw" ) )
+	{
+		return DZRCOBS_SIMD_LEVEL_AVX512;
+	}
+
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		return DZRCOBS_SIMD_LEVEL_AVX2;
+	}
+
+	if( __builtin_cpu_supports( "ssse3" ) )
+	{
+		return DZRCOBS_SIMD_LEVEL_SSSE3;
+	}
+
+	return DZRCOBS_SIMD_LEVEL_SCALAR;
+#else
+	int regs[4];
+
+	__cpuid( regs, 0 );
+	const int maxLeaf = regs[0];
+
+	__cpuid( regs, 1 );
+	const uint32_t ecx1 = (uint32_t)regs[2];
+
+	uint32_t ebx7 = 0;
+
+	if( maxLeaf >= 7 )
+	{
+		__cpuidex( regs, 7, 0 );
+		ebx7 = (uint32_t)regs[1];
+	}
+
+	// XCR0: bits 1, 2 XMM and YMM registers, bits 5, 6, 7 AVX-512 registers
+	const uint64_t xcr0 = ( ecx1 & ( 1U << 27 ) ) ? _xgetbv( 0 ) : 0;
+	const bool hasAvx		= ( ( ecx1 & ( 1U << 28 ) ) != 0 ) && ( ( xcr0 & 0x06U ) == 0x06U );
+
+	if( hasAvx && ( ( xcr0 & 0xE6U ) == 0xE6U ) && ( ebx7 & ( 1U << 16 ) ) && ( ebx7 & ( 1U << 30 ) ) )
+	{
+		return DZRCOBS_SIMD_LEVEL_AVX512;
+	}
+
+	if( hasAvx && ( ebx7 & ( 1U << 5 ) ) )
+	{
+		return DZRCOBS_SIMD_LEVEL_AVX2;
+	}
+
+	if( ecx1 & ( 1U << 9 ) )
+	{
+		return DZRCOBS_SIMD_LEVEL_SSSE3;
+	}
+
+	return DZRCOBS_SIMD_LEVEL_SCALAR;
+#endif
+}
+
+#if DZRCOBS_CRC_DISPATCH
+static bool dzrcobs_simd_cpu_has_clmul( void )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports( "pclmul" );
+#else
+	int regs[4];
+
+	__cpuid( regs, 1 );
+
+	return ( (uint32_t)regs[2] & ( 1U << 1 ) ) != 0;
+#endif
+}
+#endif
+
+static void dzrcobs_simd_use_level( eDZRCOBS_simd_level aLevel )
+{
+	s_DZRCOBS_SimdKernels = s_DZRCOBS_SimdKernelsOfLevel[aLevel];
+	s_DZRCOBS_SimdLevel		= aLevel;
+
+#if DZRCOBS_CRC_DISPATCH
+	const bool useClmul			= ( aLevel != DZRCOBS_SIMD_LEVEL_SCALAR ) && dzrcobs_simd_cpu_has_clmul();
+	s_DZRCOBS_SimdCrc8Block = useClmul ? dzrcobs_crc8_block_clmul : dzrcobs_crc8_block_slicing8;
+#endif
+}
+
+static void dzrcobs_simd_resolve( void )
+{
+	eDZRCOBS_simd_level level = dzrcobs_simd_cpu_level();
+
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#pragma warning( suppress : 4996 )
+#endif
+	const char *pEnvLevel = getenv( DZRCOBS_SIMD_ENV );
+
+	if( pEnvLevel != NULL )
+	{
+		// Only lowers the level, unknown names are ignored
+		for( int i = DZRCOBS_SIMD_LEVEL_SCALAR; i < (int)level; i++ )
+		{
+			if( strcmp( pEnvLevel, dzrcobs_simd_level_name( (eDZRCOBS_simd_level)i ) ) == 0 )
+			{
+				level = (eDZRCOBS_simd_level)i;
+				break;
+			}
+		}
+	}
+
+	dzrcobs_simd_use_level( level );
+}
+
+// Resolves the level at load time, as a static constructor
+#if defined( __GNUC__ ) || defined( __clang__ )
+__attribute__( ( constructor ) ) static void dzrcobs_simd_init( void )
+{
+	dzrcobs_simd_resolve();
+}
+#else
+static void __cdecl dzrcobs_simd_init( void )
+{
+	dzrcobs_simd_resolve();
+}
+
+// The CRT calls the functions on .CRT$XCU before main, the linker must keep it
+#pragma section( ".CRT$XCU", read )
+__declspec( allocate( ".CRT$XCU" ) ) void( __cdecl *G_DZRCOBS_SimdInit )( void ) = dzrcobs_simd_init;
+#if defined( _M_IX86 )
+#pragma comment( linker, "/include:_G_DZRCOBS_SimdInit" )
+#else
+#pragma comment( linker, "/include:G_DZRCOBS_SimdInit" )
+#endif
+#endif
+
+#endif
+
+size_t dzrcobs_simd_find_zero( const uint8_t *aBuf, size_t aSize )
+{
+	DZRCOBS_ASSERT( ( aBuf != NULL ) || ( aSize == 0 ) );
+
+#if DZRCOBS_SIMD_DISPATCH
+	return s_DZRCOBS_SimdKernels.findZero( aBuf, aSize );
+#elif DZRCOBS_SIMD_HAS_512
+	return dzrcobs_simd_find_zero_avx512( aBuf, aSize );
+#elif DZRCOBS_SIMD_HAS_256
+	return dzrcobs_simd_find_zero_avx2( aBuf, aSize );
+#elif DZRCOBS_SIMD_HAS_128
+	return dzrcobs_simd_find_zero_ssse3( aBuf, aSize );
+#else
+	return dzrcobs_simd_find_zero_scalar( aBuf, aSize );
+#endif
+}
+
+size_t dzrcobs_simd_find_dict_candidate( const uint8_t aPairNibbleMasks[4][16], const uint8_t *aBuf, size_t aSize )
+{
+	DZRCOBS_ASSERT( aPairNibbleMasks != NULL );
+	DZRCOBS_ASSERT( ( aBuf != NULL ) || ( aSize == 0 ) );
+
+#if DZRCOBS_SIMD_DISPATCH
+	return s_DZRCOBS_SimdKernels.findDictCandidate( aPairNibbleMasks, aBuf, aSize );
+#elif DZRCOBS_SIMD_HAS_512
+	return dzrcobs_simd_find_dict_candidate_avx512( aPairNibbleMasks, aBuf, aSize );
+#elif DZRCOBS_SIMD_HAS_256
+	return dzrcobs_simd_find_dict_candidate_avx2( aPairNibbleMasks, aBuf, aSize );
+#elif DZRCOBS_SIMD_HAS_SHUFFLE
+	return dzrcobs_simd_find_dict_candidate_ssse3( aPairNibbleMasks, aBuf, aSize );
+#else
+	return dzrcobs_simd_find_dict_candidate_scalar( aPairNibbleMasks, aBuf, aSize );
+#endif
+}
+
+#if DZRCOBS_CRC_DISPATCH
+uint8_t dzrcobs_simd_crc8_block( uint8_t aCrc, const uint8_t *aBuf, size_t aSize )
+{
+	DZRCOBS_ASSERT( ( aBuf != NULL ) || ( aSize == 0 ) );
+
+	return s_DZRCOBS_SimdCrc8Block( aCrc, aBuf, aSize );
+}
+#endif
+
+eDZRCOBS_simd_level dzrcobs_simd_get_level( void )
+{
+#if DZRCOBS_SIMD_DISPATCH
+	return s_DZRCOBS_SimdLevel;
+#else
+	return (eDZRCOBS_simd_level)DZRCOBS_SIMD;
+#endif
+}
+
+bool dzrcobs_simd_is_supported( eDZRCOBS_simd_level aLevel )
+{
+#if DZRCOBS_SIMD_DISPATCH
+	return ( aLevel >= DZRCOBS_SIMD_LEVEL_SCALAR ) && ( aLevel <= dzrcobs_simd_cpu_level() );
+#else
+	return aLevel == (eDZRCOBS_simd_level)DZRCOBS_SIMD;
+#endif
+}
+
+bool dzrcobs_simd_set_level( eDZRCOBS_simd_level aLevel )
+{
+	if( !dzrcobs_simd_is_supported( aLevel ) )
+	{
+		return false;
+	}
+
+#if DZRCOBS_SIMD_DISPATCH
+	dzrcobs_simd_use_level( aLevel );
+#endif
+
+	return true;
+}
+
+const char *dzrcobs_simd_level_name( eDZRCOBS_simd_level aLevel )
+{
+	switch( aLevel )
+	{
+	case DZRCOBS_SIMD_LEVEL_SCALAR:
+		return "scalar";
+	case DZRCOBS_SIMD_LEVEL_SSSE3:
+		return "ssse3";
+	case DZRCOBS_SIMD_LEVEL_AVX2:
+		return "avx2";
+	case DZRCOBS_SIMD_LEVEL_AVX512:
+		return "avx512";
+	default:
+		return "";
+	}
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
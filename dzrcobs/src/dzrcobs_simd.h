@@ -0,0 +1,166 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_simd.h
+///	@brief Vectorized scan kernels used by the encoders and decoders
+///
+///	@par  Plataform Target:	Any
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZRCOBS_SIMD_H_
+#define _DZRCOBS_SIMD_H_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// clang-format off
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format on
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Select the instruction set used by the kernels at build time.
+// Define DZRCOBS_SIMD to 0 to force the portable scalar implementation.
+// Defining DZRCOBS_SIMD also disables the runtime dispatch.
+#ifndef DZRCOBS_SIMD_DISPATCH
+#if !defined( DZRCOBS_SIMD ) && \
+ ( defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 ) ) && \
+ ( defined( __GNUC__ ) || defined( __clang__ ) || defined( _MSC_VER ) )
+#define DZRCOBS_SIMD_DISPATCH 1
+#else
+#define DZRCOBS_SIMD_DISPATCH 0
+#endif
+#endif
+
+#ifndef DZRCOBS_SIMD
+#if defined( __AVX512BW__ )
+#define DZRCOBS_SIMD 3
+#elif defined( __AVX2__ )
+#define DZRCOBS_SIMD 2
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#define DZRCOBS_SIMD 1
+#else
+#define DZRCOBS_SIMD 0
+#endif
+#endif
+
+#define DZRCOBS_SIMD_SCALAR ( 0 )
+#define DZRCOBS_SIMD_SSE2 ( 1 )
+#define DZRCOBS_SIMD_AVX2 ( 2 )
+#define DZRCOBS_SIMD_AVX512 ( 3 )
+
+// Environment variable that overrides the level chosen by the runtime
+// dispatch, one of the dzrcobs_simd_level_name names (eg: DZRCOBS_SIMD=ssse3)
+#define DZRCOBS_SIMD_ENV "DZRCOBS_SIMD"
+
+/// Kernel implementations. With DZRCOBS_SIMD_DISPATCH all the x86 ones are
+/// built and the best one the CPU supports is used, else only DZRCOBS_SIMD.
+/// Without the dispatch, DZRCOBS_SIMD 1 only needs SSE2: the dictionary scan
+/// uses the SSSE3 shuffle when the build has it (eg: -mssse3), else SWAR.
+typedef enum e_DZRCOBS_simd_level
+{
+	DZRCOBS_SIMD_LEVEL_SCALAR = DZRCOBS_SIMD_SCALAR, ///< Portable, 8 bytes a time (SWAR)
+	DZRCOBS_SIMD_LEVEL_SSSE3	= DZRCOBS_SIMD_SSE2,	 ///< 16 bytes, SSE2 and the SSSE3 byte shuffle (pshufb)
+	DZRCOBS_SIMD_LEVEL_AVX2		= DZRCOBS_SIMD_AVX2,	 ///< 32 bytes
+	DZRCOBS_SIMD_LEVEL_AVX512 = DZRCOBS_SIMD_AVX512, ///< 64 bytes, AVX-512BW
+	DZRCOBS_SIMD_LEVEL_N,
+} eDZRCOBS_simd_level;
+
+// Shorter runs are faster with a byte loop than with a kernel call
+#ifndef DZRCOBS_SIMD_RUN_MIN
+#define DZRCOBS_SIMD_RUN_MIN ( 32 )
+#endif
+
+#ifndef DZRCOBS_CACHE_LINE_SIZE
+#define DZRCOBS_CACHE_LINE_SIZE ( 64 )
+#endif
+
+// Hint to load a cache line that is going to be read soon
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define DZRCOBS_PREFETCH( addr ) __builtin_prefetch( ( addr ) )
+#else
+#define DZRCOBS_PREFETCH( addr )
+#endif
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Finds the first zero byte of a buffer
+ *
+ * @param aBuf Buffer to scan
+ * @param aSize Number of bytes to scan
+ * @return size_t Index of the first 0x00, aSize if there is none
+ */
+size_t dzrcobs_simd_find_zero( const uint8_t *aBuf, size_t aSize );
+
+/**
+ * @brief Finds the first position that may start a dictionary word.
+ *        Position p is a candidate if, for some bucket, the nibbles of
+ *        aBuf[p] and aBuf[p + 1] are all set on aPairNibbleMasks.
+ *        The last position is never a candidate (words have 2 bytes or more).
+ *
+ * @param aPairNibbleMasks Masks built by dzrcobs_dictionary_init (sDICT_accel)
+ * @param aBuf Buffer to scan
+ * @param aSize Number of bytes to scan
+ * @return size_t Index of the first candidate, aSize if there is none
+ */
+size_t dzrcobs_simd_find_dict_candidate( const uint8_t aPairNibbleMasks[4][16], const uint8_t *aBuf, size_t aSize );
+
+/**
+ * @brief The kernel implementation in use. With DZRCOBS_SIMD_DISPATCH it is
+ *        resolved at load time (a static constructor): the best level
+ *        supported by the CPU, lowered by the DZRCOBS_SIMD_ENV environment
+ *        variable.
+ *
+ * @return eDZRCOBS_simd_level Level in use
+ */
+eDZRCOBS_simd_level dzrcobs_simd_get_level( void );
+
+/**
+ * @brief Checks if a level can be used on this build and CPU
+ *
+ * @param aLevel Level to check
+ * @return true if dzrcobs_simd_set_level accepts it
+ */
+bool dzrcobs_simd_is_supported( eDZRCOBS_simd_level aLevel );
+
+/**
+ * @brief Changes the kernel implementation (eg: to compare them on tests and
+ *        benchmarks), also the CRC backend with DZRCOBS_CRC_DISPATCH (crc8.h).
+ *        Not thread safe: it must not be called while other threads are
+ *        encoding or decoding.
+ *
+ * @param aLevel Level to use
+ * @return true on success, false if the level is not supported
+ */
+bool dzrcobs_simd_set_level( eDZRCOBS_simd_level aLevel );
+
+/**
+ * @brief Name of a level, as used by DZRCOBS_SIMD_ENV
+ *
+ * @param aLevel Level
+ * @return const char* "scalar", "ssse3", "avx2", "avx512" or "" if invalid
+ */
+const char *dzrcobs_simd_level_name( eDZRCOBS_simd_level aLevel );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
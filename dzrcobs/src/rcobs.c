@@ -18,6 +18,8 @@
 // /////////////////////////////////////////////////////////////////////////////
 #include <dzrcobs/rcobs.h>
 #include <stdbool.h>
+#include <string.h>
+#include "dzrcobs_simd.h"
 
 // Definitions
 // /////////////////////////////////////////////////////////////////////////////
@@ -155,12 +157,22 @@ eRCOBS_ret rcobs_decode( const uint8_t *aSrcBufEncoded,
 	}
 
 	const uint8_t *pBeginEncoded = aSrcBufEncoded;
-	const uint8_t *pReadEncoded	 = aSrcBufEncoded + aSrcBufEncodedLen - 1;
+	const uint8_t *pLastEncoded	 = aSrcBufEncoded + aSrcBufEncodedLen - 1;
+	const uint8_t *pReadEncoded	 = pLastEncoded;
 
 	const uint8_t *pBeginDecoded	= aDstBufDecoded;
 	uint8_t *pWriteDecodedInitial = aDstBufDecoded + aDstBufDecodedSize;
 	uint8_t *pWriteDecoded				= pWriteDecodedInitial; // starts out of buffer, will be decremented latter
 
+	// In-place, the decoded data must not end before the encoded data, it would overwrite the bytes not read yet
+	const bool isInPlace = ( (uintptr_t)pBeginEncoded < (uintptr_t)pWriteDecodedInitial ) &&
+												 ( (uintptr_t)pBeginDecoded < (uintptr_t)( pLastEncoded + 1 ) );
+
+	if( isInPlace && ( (uintptr_t)pWriteDecodedInitial < (uintptr_t)( pLastEncoded + 1 ) ) )
+	{
+		return RCOBS_RET_ERR_BAD_ARG;
+	}
+
 #ifdef IS_DEBUG_BUILD
 	size_t totalWrite = 0;
 	size_t totalRead	= 0;
@@ -176,9 +188,14 @@ eRCOBS_ret rcobs_decode( const uint8_t *aSrcBufEncoded,
 		}
 
 		if( ( code != RCOBS_CODE_JUMP ) &&						// Only adds if the new code is not skipping
-				( pWriteDecoded != pWriteDecodedInitial ) // Only adds if this is not the first run
+				( pReadEncoded != pLastEncoded ) // Only adds if this is not the first run (it may be empty)
 		)
 		{
+			if( pWriteDecoded == pBeginDecoded )
+			{
+				return RCOBS_RET_ERR_OVERFLOW;
+			}
+
 			pWriteDecoded--;
 			*pWriteDecoded = 0;
 
@@ -199,27 +216,48 @@ eRCOBS_ret rcobs_decode( const uint8_t *aSrcBufEncoded,
 		totalRead++;
 #endif
 
-		while( code )
+		if( (size_t)( pReadEncoded + 1 - pBeginEncoded ) < code )
 		{
-			code--;
-
-			const uint8_t byte = *pReadEncoded--;
+			return RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
 
 #ifdef IS_DEBUG_BUILD
-			totalRead++;
+		totalRead += code;
+		totalWrite += code;
 #endif
 
-			if( byte == 0 )
+		if( code >= DZRCOBS_SIMD_RUN_MIN )
+		{
+			// The run is stored in the same order, so it is a forward copy
+			const uint8_t *pRun = pReadEncoded + 1 - code;
+
+			if( dzrcobs_simd_find_zero( pRun, code ) != code )
 			{
 				return RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
 			}
 
-			pWriteDecoded--;
-			*pWriteDecoded = byte;
+			// In-place the run may overlap its destiny
+			pWriteDecoded -= code;
+			memmove( pWriteDecoded, pRun, code );
 
-#ifdef IS_DEBUG_BUILD
-			totalWrite++;
-#endif
+			pReadEncoded -= code;
+		}
+		else
+		{
+			while( code )
+			{
+				code--;
+
+				const uint8_t byte = *pReadEncoded--;
+
+				if( byte == 0 )
+				{
+					return RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+				}
+
+				pWriteDecoded--;
+				*pWriteDecoded = byte;
+			}
 		}
 	}
 
@@ -230,5 +268,84 @@ eRCOBS_ret rcobs_decode( const uint8_t *aSrcBufEncoded,
 	return RCOBS_RET_SUCCESS;
 }
 
+eRCOBS_ret rcobs_decoded_size( const uint8_t *aSrcBufEncoded, size_t aSrcBufEncodedLen, size_t *aOutDecodedLen )
+{
+	if( ( !aSrcBufEncoded ) || ( !aOutDecodedLen ) || ( aSrcBufEncodedLen < 2 ) )
+	{
+		return RCOBS_RET_ERR_BAD_ARG;
+	}
+
+	const uint8_t *pBeginEncoded = aSrcBufEncoded;
+	const uint8_t *pLastEncoded	 = aSrcBufEncoded + aSrcBufEncodedLen - 1;
+	const uint8_t *pReadEncoded	 = pLastEncoded;
+
+	size_t decodedLen = 0;
+
+	// Same walk as rcobs_decode, runs are skipped instead of copied
+	while( pReadEncoded >= pBeginEncoded )
+	{
+		const uint8_t code = *pReadEncoded--;
+
+		if( code == 0 )
+		{
+			return RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
+
+		if( ( code != RCOBS_CODE_JUMP ) && ( pReadEncoded + 1 != pLastEncoded ) )
+		{
+			decodedLen++;
+		}
+
+		if( (size_t)( pReadEncoded + 1 - pBeginEncoded ) < (size_t)( code - 1 ) )
+		{
+			return RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD;
+		}
+
+		pReadEncoded -= code - 1;
+		decodedLen += code - 1U;
+	}
+
+	*aOutDecodedLen = decodedLen;
+
+	return RCOBS_RET_SUCCESS;
+}
+
+eRCOBS_ret rcobs_decode_left_aligned( const uint8_t *aSrcBufEncoded,
+																			size_t aSrcBufEncodedLen,
+																			uint8_t *aDstBufDecoded,
+																			size_t aDstBufDecodedSize,
+																			size_t *aOutDecodedLen )
+{
+	if( ( !aSrcBufEncoded ) || ( !aDstBufDecoded ) || ( !aOutDecodedLen ) || ( aDstBufDecodedSize == 0 ) ||
+			( aSrcBufEncodedLen < 2 ) )
+	{
+		return RCOBS_RET_ERR_BAD_ARG;
+	}
+
+	size_t decodedLen = 0;
+
+	const eRCOBS_ret ret = rcobs_decoded_size( aSrcBufEncoded, aSrcBufEncodedLen, &decodedLen );
+
+	if( ret != RCOBS_RET_SUCCESS )
+	{
+		return ret;
+	}
+
+	if( decodedLen > aDstBufDecodedSize )
+	{
+		return RCOBS_RET_ERR_OVERFLOW;
+	}
+
+	// Right aligned on a destiny of the exact size is left aligned
+	uint8_t *decodedPos = NULL;
+
+	return rcobs_decode( aSrcBufEncoded,
+											 aSrcBufEncodedLen,
+											 aDstBufDecoded,
+											 ( decodedLen > 0 ) ? decodedLen : aDstBufDecodedSize,
+											 aOutDecodedLen,
+											 &decodedPos );
+}
+
 // EOF
 // /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,274 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_dzrcobs_constexpr.cpp
+///	@brief Tests the constexpr encoders against the C encoders
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <../src/crc8.h>
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_constexpr.h>
+#include <dzrcobs/rcobs.h>
+#include <vector>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define TEST_USERBITS ( 0x15 )
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+static constexpr char s_TEST_Dictionary[] =
+	DICT_ADD_WORD(2, "\x00\x00")
+	DICT_ADD_WORD(2, "OK")
+	DICT_ADD_WORD(2, "ab")
+	DICT_ADD_WORD(3, "\x01\x00\x02")
+	DICT_ADD_WORD(3, "ACK")
+	DICT_ADD_WORD(3, "abc")
+	DICT_ADD_WORD(4, "\x00\x00\x00\x01")
+	DICT_ADD_WORD(4, "PING")
+	DICT_ADD_WORD(5, "HELLO")
+	DICT_ADD_WORD(5, "\xFF\xFF\x00\xFF\xFF")
+;
+
+TEST_GROUP( DZRCOBS_CONSTEXPR ){
+	void setup()
+	{
+		eDICT_ret ret = dzrcobs_dictionary_init( &m_dictCtx, s_TEST_Dictionary, sizeof( s_TEST_Dictionary ) );
+		CHECK_EQUAL( DICT_RET_SUCCESS, ret );
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx m_dictCtx;
+};
+// NOLINTEND
+// clang-format on
+
+// Encodes a whole frame with the C encoder
+static std::vector<uint8_t> c_encode( const sDICT_ctx *aDictCtx,
+																			eDZRCOBS_encoding aEncoding,
+																			const std::vector<uint8_t> &aData,
+																			uint8_t aUser6bits )
+{
+	std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( aData.size() ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+	sDZRCOBS_ctx ctx;
+	size_t encodedLen = 0;
+
+	dzrcobs_encode_set_dictionary( &ctx, aDictCtx, DZRCOBS_USING_DICT_2 );
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, aEncoding, encoded.data(), encoded.size() ) );
+	ctx.user6bits = aUser6bits;
+	if( !aData.empty() )
+	{
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, aData.data(), aData.size() ) );
+	}
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	encoded.resize( encodedLen );
+
+	return encoded;
+}
+
+// Data with runs of zeros, long non zero runs (jump codes) and dictionary words
+static std::vector<uint8_t> random_data( size_t aSize )
+{
+	static const uint8_t pieces[][5] = { { 'O', 'K' },
+																			 { 'A', 'C', 'K' },
+																			 { 'a', 'b', 'c' },
+																			 { 0x00, 0x00, 0x00, 0x01 },
+																			 { 0xFF, 0xFF, 0x00, 0xFF, 0xFF } };
+	static const size_t piecesSize[] = { 2, 3, 3, 4, 5 };
+
+	std::vector<uint8_t> data;
+
+	while( data.size() < aSize )
+	{
+		const int kind = rand() % 4;
+
+		if( kind == 0 )
+		{
+			const size_t piece = (size_t)rand() % 5;
+			data.insert( data.end(), pieces[piece], pieces[piece] + piecesSize[piece] );
+		}
+		else if( kind == 1 )
+		{
+			data.push_back( 0x00 );
+		}
+		else
+		{
+			data.push_back( (uint8_t)( ( rand() % 255 ) + 1 ) );
+		}
+	}
+
+	data.resize( aSize );
+
+	return data;
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// Frames built at compile time
+static constexpr std::array<uint8_t, 4> s_TEST_Heartbeat = { 0x01, 0x00, 0x02, 0x00 };
+static constexpr std::array<uint8_t, 9> s_TEST_Ack			 = { 'A', 'C', 'K', 0x00, 'O', 'K', 0x00, 0x00, 0x07 };
+
+static constexpr auto s_TEST_HeartbeatRcobs = dzrcobs::rcobs_frame<s_TEST_Heartbeat>;
+static constexpr auto s_TEST_HeartbeatPlain = dzrcobs::plain_frame<s_TEST_Heartbeat, TEST_USERBITS>;
+static constexpr auto s_TEST_AckDict =
+ dzrcobs::dictionary_frame<s_TEST_Ack, dzrcobs::sDZRCOBS_dictionary_string{ s_TEST_Dictionary }, DZRCOBS_USING_DICT_2, TEST_USERBITS>;
+
+static_assert( dzrcobs::crc8( DZRCOBS_CRC_INIT_VAL, (uint8_t)0x00 ) == 0x4A );
+static_assert( std::is_same_v<decltype( s_TEST_HeartbeatRcobs ), const std::array<uint8_t, 5>> );
+static_assert( s_TEST_HeartbeatRcobs[4] == 0x01 );
+static_assert( std::is_same_v<decltype( s_TEST_AckDict ), const std::array<uint8_t, 8>> );
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CONSTEXPR, CRC8MatchesTable )
+// NOLINTEND
+{
+	for( unsigned crc = 0; crc < 256; crc++ )
+	{
+		for( unsigned byte = 0; byte < 256; byte++ )
+		{
+			CHECK_EQUAL( DZRCOBS_CRC( crc, byte ), dzrcobs::crc8( (uint8_t)crc, (uint8_t)byte ) );
+		}
+	}
+
+	const std::vector<uint8_t> data = random_data( 1000 );
+
+	CHECK_EQUAL( DZRCOBS_CRC_BLOCK( DZRCOBS_CRC_INIT_VAL, data.data(), data.size() ),
+							 dzrcobs::crc8( DZRCOBS_CRC_INIT_VAL, std::span<const uint8_t>( data ) ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CONSTEXPR, CompileTimeFrames )
+// NOLINTEND
+{
+	const std::vector<uint8_t> heartbeat( s_TEST_Heartbeat.begin(), s_TEST_Heartbeat.end() );
+	const std::vector<uint8_t> ack( s_TEST_Ack.begin(), s_TEST_Ack.end() );
+
+	// rcobs
+	std::vector<uint8_t> encoded( RCOBS_MAX_ENCODED_SIZE( heartbeat.size() ) );
+	sRCOBS_ctx rcobsCtx;
+	size_t encodedLen = 0;
+
+	CHECK_EQUAL( RCOBS_RET_SUCCESS, rcobs_encode_inc_begin( &rcobsCtx, encoded.data(), encoded.size() ) );
+	CHECK_EQUAL( RCOBS_RET_SUCCESS, rcobs_encode_inc( &rcobsCtx, heartbeat.data(), heartbeat.size() ) );
+	CHECK_EQUAL( RCOBS_RET_SUCCESS, rcobs_encode_inc_end( &rcobsCtx, &encodedLen ) );
+
+	CHECK_EQUAL( encodedLen, s_TEST_HeartbeatRcobs.size() );
+	MEMCMP_EQUAL( encoded.data(), s_TEST_HeartbeatRcobs.data(), encodedLen );
+
+	// dzrcobs
+	const std::vector<uint8_t> plain = c_encode( &m_dictCtx, DZRCOBS_PLAIN, heartbeat, TEST_USERBITS );
+
+	CHECK_EQUAL( plain.size(), s_TEST_HeartbeatPlain.size() );
+	MEMCMP_EQUAL( plain.data(), s_TEST_HeartbeatPlain.data(), plain.size() );
+
+	const std::vector<uint8_t> dict = c_encode( &m_dictCtx, DZRCOBS_USING_DICT_2, ack, TEST_USERBITS );
+
+	CHECK_EQUAL( dict.size(), s_TEST_AckDict.size() );
+	MEMCMP_EQUAL( dict.data(), s_TEST_AckDict.data(), dict.size() );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CONSTEXPR, EncodersMatchC )
+// NOLINTEND
+{
+	// Up to a few jump codes of each encoding
+	for( size_t dataSize = 0; dataSize < 600; dataSize++ )
+	{
+		const std::vector<uint8_t> data = random_data( dataSize );
+		const uint8_t user6bits					= (uint8_t)( ( rand() % 63 ) + 1 );
+
+		std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( dataSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+		// rcobs
+		// rcobs_encode_inc_begin needs at least 2 bytes
+		std::vector<uint8_t> rcobsEncoded( RCOBS_MAX_ENCODED_SIZE( dataSize ) + 1 );
+		sRCOBS_ctx rcobsCtx;
+		size_t rcobsLen = 0;
+
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, rcobs_encode_inc_begin( &rcobsCtx, rcobsEncoded.data(), rcobsEncoded.size() ) );
+		if( !data.empty() )
+		{
+			CHECK_EQUAL( RCOBS_RET_SUCCESS, rcobs_encode_inc( &rcobsCtx, data.data(), data.size() ) );
+		}
+
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, rcobs_encode_inc_end( &rcobsCtx, &rcobsLen ) );
+
+		CHECK_EQUAL( rcobsLen, dzrcobs::rcobs_encode( data, encoded ) );
+		MEMCMP_EQUAL( rcobsEncoded.data(), encoded.data(), rcobsLen );
+
+		// plain
+		const std::vector<uint8_t> plain = c_encode( &m_dictCtx, DZRCOBS_PLAIN, data, user6bits );
+
+		CHECK_EQUAL( plain.size(), dzrcobs::encode_plain( data, user6bits, encoded ) );
+		MEMCMP_EQUAL( plain.data(), encoded.data(), plain.size() );
+
+		// dictionary
+		const std::vector<uint8_t> dict = c_encode( &m_dictCtx, DZRCOBS_USING_DICT_2, data, user6bits );
+
+		CHECK_EQUAL( dict.size(),
+								 dzrcobs::encode_dictionary( data, s_TEST_Dictionary, DZRCOBS_USING_DICT_2, user6bits, encoded ) );
+		MEMCMP_EQUAL( dict.data(), encoded.data(), dict.size() );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CONSTEXPR, InvalidArgs )
+// NOLINTEND
+{
+	const std::vector<uint8_t> data = { 0x01, 0x02, 0x00, 0x03 };
+	std::vector<uint8_t> encoded( 16 );
+
+	// User bits
+	CHECK_EQUAL( 0, dzrcobs::encode_plain( data, 0, encoded ) );
+	CHECK_EQUAL( 0, dzrcobs::encode_plain( data, 64, encoded ) );
+	CHECK_EQUAL( 0, dzrcobs::encode_dictionary( data, s_TEST_Dictionary, DZRCOBS_USING_DICT_1, 64, encoded ) );
+
+	// Encoding
+	CHECK_EQUAL( 0, dzrcobs::encode_dictionary( data, s_TEST_Dictionary, DZRCOBS_PLAIN, 1, encoded ) );
+	CHECK_EQUAL( 0, dzrcobs::encode_dictionary( data, s_TEST_Dictionary, DZRCOBS_RESERVED, 1, encoded ) );
+
+	// Dictionary
+	static const char notSorted[] = DICT_ADD_WORD( 3, "abc" ) DICT_ADD_WORD( 2, "ab" );
+	static const char noWords[]		= "";
+
+	CHECK_EQUAL( 0, dzrcobs::encode_dictionary( data, notSorted, DZRCOBS_USING_DICT_1, 1, encoded ) );
+	CHECK_EQUAL( 0, dzrcobs::encode_dictionary( data, noWords, DZRCOBS_USING_DICT_1, 1, encoded ) );
+
+	// Destiny too small
+	CHECK_EQUAL( 0, dzrcobs::rcobs_encode( data, std::span<uint8_t>( encoded.data(), 4 ) ) );
+	CHECK_EQUAL( 5, dzrcobs::rcobs_encode( data, std::span<uint8_t>( encoded.data(), 5 ) ) );
+	CHECK_EQUAL( 0, dzrcobs::encode_plain( data, 1, std::span<uint8_t>( encoded.data(), 6 ) ) );
+	CHECK_EQUAL( 7, dzrcobs::encode_plain( data, 1, std::span<uint8_t>( encoded.data(), 7 ) ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,7 @@
 #include <CppUTest/TestHarness.h>
 #include <CppUTest/UtestMacros.h>
 #include <cstdint>
+#include <cstdlib>
 
 // Definitions
 // /////////////////////////////////////////////////////////////////////////////
@@ -68,5 +69,80 @@ TEST( DZRCOBS_CRC, CRC8_0x00_0xFF_0x00_0xFF )
 	CHECK_EQUAL( 0x00, crc );
 }
 
+// NOLINTBEGIN
+TEST( DZRCOBS_CRC, CRC8_Block_Equals_Bytewise )
+// NOLINTEND
+{
+	uint8_t data[131];
+
+	for( size_t i = 0; i < sizeof( data ); i++ )
+	{
+		data[i] = (uint8_t)( rand() & 0xFF );
+	}
+
+	// All sizes and misalignments, so the multi-byte loop and its tail are covered
+	for( size_t offset = 0; offset < 8; offset++ )
+	{
+		for( size_t size = 0; size <= ( sizeof( data ) - offset ); size++ )
+		{
+			uint8_t crcBytewise = DZRCOBS_CRC_INIT_VAL;
+
+			for( size_t i = 0; i < size; i++ )
+			{
+				crcBytewise = DZRCOBS_CRC( crcBytewise, data[offset + i] );
+			}
+
+			CHECK_EQUAL( crcBytewise, DZRCOBS_CRC_BLOCK( DZRCOBS_CRC_INIT_VAL, data + offset, size ) );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CRC, CRC8_Block_Every_Level )
+// NOLINTEND
+{
+	// The SIMD level also chooses the CRC backend (DZRCOBS_CRC_DISPATCH)
+	const eDZRCOBS_simd_level initialLevel = dzrcobs_simd_get_level();
+	uint8_t data[67];
+
+	for( size_t i = 0; i < sizeof( data ); i++ )
+	{
+		data[i] = (uint8_t)( rand() & 0xFF );
+	}
+
+	for( int level = DZRCOBS_SIMD_LEVEL_SCALAR; level < DZRCOBS_SIMD_LEVEL_N; level++ )
+	{
+		if( !dzrcobs_simd_set_level( (eDZRCOBS_simd_level)level ) )
+		{
+			continue;
+		}
+
+		for( size_t size = 0; size <= sizeof( data ); size++ )
+		{
+			uint8_t crcBytewise = DZRCOBS_CRC_INIT_VAL;
+
+			for( size_t i = 0; i < size; i++ )
+			{
+				crcBytewise = DZRCOBS_CRC( crcBytewise, data[i] );
+			}
+
+			CHECK_EQUAL( crcBytewise, DZRCOBS_CRC_BLOCK( DZRCOBS_CRC_INIT_VAL, data, size ) );
+			CHECK_EQUAL( crcBytewise, dzrcobs_crc8_block( DZRCOBS_CRC_INIT_VAL, data, size ) );
+		}
+	}
+
+	CHECK_TRUE( dzrcobs_simd_set_level( initialLevel ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CRC, CRC8_Block_Known_Value )
+// NOLINTEND
+{
+	static const uint8_t data[] = { 0x00, 0xFF, 0x00, 0xFF, 0x9A };
+
+	CHECK_EQUAL( 0x9A, DZRCOBS_CRC_BLOCK( DZRCOBS_CRC_INIT_VAL, data, 4 ) );
+	CHECK_EQUAL( 0x00, DZRCOBS_CRC_BLOCK( DZRCOBS_CRC_INIT_VAL, data, 5 ) );
+}
+
 // EOF
 // /////////////////////////////////////////////////////////////////////////////
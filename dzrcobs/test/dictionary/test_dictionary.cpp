@@ -19,8 +19,14 @@
 
 #include <CppUTest/TestHarness.h>
 #include <CppUTest/UtestMacros.h>
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <dzrcobs/dzrcobs_dictionary.h>
+#include <set>
+#include <string>
+#include <vector>
 
 // Definitions
 // /////////////////////////////////////////////////////////////////////////////
@@ -98,6 +104,37 @@ TEST( DICTIONARY, InternalDictionaryValidation )
 	CHECK_EQUAL( DICT_IS_VALID, ret );
 }
 
+// NOLINTBEGIN
+TEST( DICTIONARY, ValidationOddWordCounts )
+// NOLINTEND
+{
+	// Word sizes with an odd number of words, then more than one word
+	// clang-format off
+	static const char dictionary[] =
+		DICT_ADD_WORD(2, "\x01\x00")
+		DICT_ADD_WORD(2, "\x02\x00")
+		DICT_ADD_WORD(2, "\x03\x00")
+		DICT_ADD_WORD(3, "\x00\x00\x00")
+		DICT_ADD_WORD(3, "\x00\x00\x01")
+		DICT_ADD_WORD(4, "\x01\x00\x00\x00")
+		DICT_ADD_WORD(5, "\x01\x00\x00\x00\x00")
+		DICT_ADD_WORD(5, "\x02\x00\x00\x00\x00")
+	;
+	// clang-format on
+
+	CHECK_EQUAL( DICT_IS_VALID, dzrcobs_dictionary_isvalid( dictionary, sizeof( dictionary ) ) );
+
+	// clang-format off
+	static const char notSorted[] =
+		DICT_ADD_WORD(2, "\x01\x00")
+		DICT_ADD_WORD(3, "\x00\x00\x01")
+		DICT_ADD_WORD(3, "\x00\x00\x00")
+	;
+	// clang-format on
+
+	CHECK_EQUAL( DICT_INVALID_NOT_SORTED, dzrcobs_dictionary_isvalid( notSorted, sizeof( notSorted ) ) );
+}
+
 // NOLINTBEGIN
 TEST( DICTIONARY, SearchKeyOnEntry )
 {
@@ -170,5 +207,172 @@ TEST( DICTIONARY, SearchKey )
 
 // NOLINTEND
 
+// NOLINTBEGIN
+TEST( DICTIONARY, SearchKeyOnLastWordSize )
+{
+	// All the words of the last word size must be found, not only its first one
+	static const char dictionary[] =
+		DICT_ADD_WORD(2, "ab")
+		DICT_ADD_WORD(3, "abc")
+		DICT_ADD_WORD(4, "abcd")
+		DICT_ADD_WORD(5, "[0000")
+		DICT_ADD_WORD(5, "temp=")
+		DICT_ADD_WORD(5, "xyzzy");
+
+	sDICT_ctx dictCtx;
+	eDICT_ret dictRet = dzrcobs_dictionary_init( &dictCtx, dictionary, sizeof( dictionary ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dictRet );
+
+	for( int pass = 0; pass < 2; pass++ )
+	{
+		size_t keySizeFound = 0;
+
+		CHECK_EQUAL( 4, dzrcobs_dictionary_search( &dictCtx, (const uint8_t *)"[0000", 5, &keySizeFound ) );
+		CHECK_EQUAL( 5, keySizeFound );
+		CHECK_EQUAL( 5, dzrcobs_dictionary_search( &dictCtx, (const uint8_t *)"temp=1", 6, &keySizeFound ) );
+		CHECK_EQUAL( 5, keySizeFound );
+		CHECK_EQUAL( 6, dzrcobs_dictionary_search( &dictCtx, (const uint8_t *)"xyzzy", 5, &keySizeFound ) );
+		CHECK_EQUAL( 5, keySizeFound );
+
+#if DZRCOBS_DICT_ACCELERATOR
+		// Again, on the fallback without the perfect hash
+		dictCtx.accel.isHashed = 0;
+#endif
+	}
+}
+
+// NOLINTEND
+
+// Reference search, binary search on each word size in dictionary order
+static uint8_t reference_search( const sDICT_ctx *aCtx, const uint8_t *aKey, size_t aKeySize, size_t *aOutKeySizeFound )
+{
+	for( uint8_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry *wordEntry = &aCtx->wordSizeTable[i];
+
+		if( ( wordEntry->nEntries > 0 ) && ( aKeySize >= (size_t)( wordEntry->strideSize - 1 ) ) )
+		{
+			const uint8_t idxFound = DZRCOBS_Dictionary_SearchKeyOnEntry( aKey, wordEntry );
+
+			if( idxFound != 0 )
+			{
+				*aOutKeySizeFound = wordEntry->strideSize - 1;
+				return idxFound;
+			}
+		}
+	}
+
+	return 0;
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY, SearchKeyMatchesBinarySearch )
+{
+	// Full dictionary, 126 words over all the word sizes, from a small alphabet so words share prefixes
+	std::string dictionary;
+	std::vector<std::string> words;
+
+	for( size_t wordSize = 2; wordSize <= 5; wordSize++ )
+	{
+		std::set<std::string> tierWords;
+
+		while( tierWords.size() < ( ( wordSize == 2 ) ? 30 : 32 ) )
+		{
+			std::string word;
+
+			for( size_t i = 0; i < wordSize; i++ )
+			{
+				word += (char)( "\x00\x01\x02\x20\x30\xFF"[rand() % 6] );
+			}
+
+			tierWords.insert( word );
+		}
+
+		for( const std::string &word : tierWords )
+		{
+			dictionary += (char)( '0' + wordSize );
+			dictionary += word;
+			words.push_back( word );
+		}
+	}
+
+	dictionary += '\0';
+
+	sDICT_ctx dictCtx;
+	eDICT_ret dictRet = dzrcobs_dictionary_init( &dictCtx, dictionary.data(), dictionary.size() );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dictRet );
+
+#if DZRCOBS_DICT_ACCELERATOR
+	CHECK_EQUAL( 1, dictCtx.accel.isHashed );
+#endif
+
+	for( int pass = 0; pass < 2; pass++ )
+	{
+		for( int n = 0; n < 20000; n++ )
+		{
+			uint8_t key[5];
+			const size_t keySize = 1 + ( rand() % sizeof( key ) );
+
+			if( n & 1 )
+			{
+				const std::string &word = words[rand() % words.size()];
+				memcpy( key, word.data(), std::min( keySize, word.size() ) );
+			}
+			else
+			{
+				for( size_t i = 0; i < keySize; i++ )
+				{
+					key[i] = (uint8_t)( "\x00\x01\x02\x20\x30\xFF\x55"[rand() % 7] );
+				}
+			}
+
+			size_t keySizeFound					 = 0;
+			size_t referenceKeySizeFound = 0;
+
+			const uint8_t idx					 = dzrcobs_dictionary_search( &dictCtx, key, keySize, &keySizeFound );
+			const uint8_t referenceIdx = reference_search( &dictCtx, key, keySize, &referenceKeySizeFound );
+
+			CHECK_EQUAL( referenceIdx, idx );
+
+			if( idx != 0 )
+			{
+				CHECK_EQUAL( referenceKeySizeFound, keySizeFound );
+			}
+		}
+
+#if DZRCOBS_DICT_ACCELERATOR
+		// Again, on the fallback without the perfect hash
+		dictCtx.accel.isHashed = 0;
+#endif
+	}
+}
+
+// NOLINTEND
+
+#if DZRCOBS_DICT_ACCELERATOR
+
+// NOLINTBEGIN
+TEST( DICTIONARY, FlatWordsMatchGet )
+{
+	for( uint8_t idx = 0; idx < DICT_MAX_WORDS; idx++ )
+	{
+		uint8_t wordSize		= 0;
+		const uint8_t *word = dzrcobs_dictionary_get( &m_dictCtx, idx, &wordSize );
+
+		if( word == NULL )
+		{
+			CHECK_EQUAL( 0, m_dictCtx.accel.flatWordSize[idx] );
+			continue;
+		}
+
+		CHECK_EQUAL( wordSize, m_dictCtx.accel.flatWordSize[idx] );
+		CHECK_EQUAL( 0, memcmp( word, &m_dictCtx.accel.flatWords[idx][DICT_FLAT_WORD_SIZE - wordSize], wordSize ) );
+	}
+}
+
+// NOLINTEND
+
+#endif
+
 // EOF
 // /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,279 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_dictionary_generated.cpp
+///	@brief Tests the dictionary generated by dzrcobs_add_dictionary
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_decode.h>
+#include <dzrcobs/dzrcobs_dictionary.h>
+#include <vector>
+#include "test_dictionary_words_generated.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+extern "C"
+{
+extern const char G_TEST_DictionaryWords[];
+extern const size_t G_TEST_DictionaryWords_size;
+}
+
+#define TEST_MAX_KEY_SIZE ( DICT_MAX_WORD_SIZE + 1 )
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DICTIONARY_GENERATED ){
+	void setup()
+	{
+		// The same dictionary, parsed at runtime
+		eDICT_ret ret = dzrcobs_dictionary_init( &m_dictCtx, G_TEST_DictionaryWords, G_TEST_DictionaryWords_size );
+		CHECK_EQUAL( DICT_RET_SUCCESS, ret );
+	}
+
+	void teardown()
+	{
+
+	}
+
+	// Same result on the runtime search, the generated search and the generated context
+	void check_search( const uint8_t *aKey, size_t aKeySize )
+	{
+		size_t expectedSize	 = 0;
+		size_t generatedSize = 0;
+		size_t ctxSize			 = 0;
+
+		const uint8_t expectedIdx	 = dzrcobs_dictionary_search( &m_dictCtx, aKey, aKeySize, &expectedSize );
+		const uint8_t generatedIdx = G_TEST_DictionaryWordsCtx_search( aKey, aKeySize, &generatedSize );
+		const uint8_t ctxIdx			 = dzrcobs_dictionary_search( &G_TEST_DictionaryWordsCtx, aKey, aKeySize, &ctxSize );
+
+		CHECK_EQUAL( expectedIdx, generatedIdx );
+		CHECK_EQUAL( expectedIdx, ctxIdx );
+
+		if( expectedIdx != 0 )
+		{
+			CHECK_EQUAL( expectedSize, generatedSize );
+			CHECK_EQUAL( expectedSize, ctxSize );
+		}
+	}
+
+	sDICT_ctx m_dictCtx;
+};
+// NOLINTEND
+// clang-format on
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DICTIONARY_GENERATED, ContextMatchesInit )
+// NOLINTEND
+{
+	const sDICT_ctx &generated = G_TEST_DictionaryWordsCtx;
+
+	CHECK_TRUE( generated.searchFunc == G_TEST_DictionaryWordsCtx_search );
+	CHECK_TRUE( m_dictCtx.searchFunc == nullptr );
+
+	CHECK_EQUAL( m_dictCtx.minWordSize, generated.minWordSize );
+	CHECK_EQUAL( m_dictCtx.maxWordSize, generated.maxWordSize );
+
+	for( size_t i = 0; i < DICT_MAX_DIFFERENTWORDSIZES; i++ )
+	{
+		const sDICT_wordentry &expected = m_dictCtx.wordSizeTable[i];
+		const sDICT_wordentry &entry		= generated.wordSizeTable[i];
+
+		CHECK_EQUAL( expected.nEntries, entry.nEntries );
+		CHECK_EQUAL( expected.lastIndex, entry.lastIndex );
+		CHECK_EQUAL( expected.globalIndex, entry.globalIndex );
+		CHECK_EQUAL( expected.strideSize, entry.strideSize );
+		CHECK_EQUAL( expected.dictionaryBegin == nullptr, entry.dictionaryBegin == nullptr );
+
+		if( expected.dictionaryBegin != nullptr )
+		{
+			MEMCMP_EQUAL( expected.dictionaryBegin, entry.dictionaryBegin, (size_t)expected.nEntries * expected.strideSize );
+		}
+	}
+
+#if DZRCOBS_DICT_ACCELERATOR
+	MEMCMP_EQUAL( &m_dictCtx.accel, &generated.accel, sizeof( sDICT_accel ) );
+#endif
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY_GENERATED, GetMatchesInit )
+// NOLINTEND
+{
+	for( unsigned idx = 0; idx < DICT_MAX_WORDS; idx++ )
+	{
+		uint8_t expectedSize = 0;
+		uint8_t wordSize		 = 0;
+
+		const uint8_t *pExpected = dzrcobs_dictionary_get( &m_dictCtx, (uint8_t)idx, &expectedSize );
+		const uint8_t *pWord		 = dzrcobs_dictionary_get( &G_TEST_DictionaryWordsCtx, (uint8_t)idx, &wordSize );
+
+		CHECK_EQUAL( pExpected == nullptr, pWord == nullptr );
+
+		if( pExpected != nullptr )
+		{
+			CHECK_EQUAL( expectedSize, wordSize );
+			MEMCMP_EQUAL( pExpected, pWord, wordSize );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY_GENERATED, SearchMatchesRuntime )
+// NOLINTEND
+{
+	uint8_t key[TEST_MAX_KEY_SIZE];
+
+	// All the keys of up to 2 bytes
+	for( unsigned i = 0; i < 65536; i++ )
+	{
+		key[0] = (uint8_t)( i & 0xFF );
+		key[1] = (uint8_t)( i >> 8 );
+
+		for( size_t keySize = 0; keySize <= 2; keySize++ )
+		{
+			check_search( key, keySize );
+		}
+	}
+
+	// Each word and its prefixes, with each byte changed to all the values
+	for( unsigned idx = 0; idx < DICT_MAX_WORDS; idx++ )
+	{
+		uint8_t wordSize		 = 0;
+		const uint8_t *pWord = dzrcobs_dictionary_get( &m_dictCtx, (uint8_t)idx, &wordSize );
+
+		if( pWord == nullptr )
+		{
+			continue;
+		}
+
+		memset( key, 'x', sizeof( key ) );
+		memcpy( key, pWord, wordSize );
+
+		for( size_t pos = 0; pos < TEST_MAX_KEY_SIZE; pos++ )
+		{
+			const uint8_t original = key[pos];
+
+			for( unsigned value = 0; value < 256; value++ )
+			{
+				key[pos] = (uint8_t)value;
+
+				for( size_t keySize = 0; keySize <= TEST_MAX_KEY_SIZE; keySize++ )
+				{
+					check_search( key, keySize );
+				}
+			}
+
+			key[pos] = original;
+		}
+	}
+
+	// Random keys, from the bytes of the words so they share prefixes
+	std::vector<uint8_t> alphabet;
+
+	for( size_t i = 0; i < G_TEST_DictionaryWords_size; i++ )
+	{
+		alphabet.push_back( (uint8_t)G_TEST_DictionaryWords[i] );
+	}
+
+	for( size_t i = 0; i < 100000; i++ )
+	{
+		const size_t keySize = (size_t)rand() % ( TEST_MAX_KEY_SIZE + 1 );
+
+		for( size_t j = 0; j < keySize; j++ )
+		{
+			key[j] = alphabet[(size_t)rand() % alphabet.size()];
+		}
+
+		check_search( key, keySize );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DICTIONARY_GENERATED, EncodeDecode )
+// NOLINTEND
+{
+	// Words and random bytes
+	std::vector<uint8_t> decodedData;
+
+	for( size_t i = 0; i < 3000; i++ )
+	{
+		uint8_t wordSize		 = 0;
+		const uint8_t *pWord = dzrcobs_dictionary_get( &m_dictCtx, (uint8_t)( rand() % 20 ), &wordSize );
+
+		if( ( pWord != nullptr ) && ( ( rand() % 2 ) == 0 ) )
+		{
+			decodedData.insert( decodedData.end(), pWord, pWord + wordSize );
+		}
+		else
+		{
+			decodedData.push_back( (uint8_t)rand() );
+		}
+	}
+
+	const sDICT_ctx *dictCtxs[] = { &m_dictCtx, &G_TEST_DictionaryWordsCtx };
+	std::vector<uint8_t> encoded[2];
+	size_t encodedLen[2] = { 0, 0 };
+
+	for( size_t i = 0; i < 2; i++ )
+	{
+		sDZRCOBS_ctx ctx;
+
+		encoded[i].assign( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( decodedData.size() ) + DZRCOBS_FRAME_HEADER_SIZE, 0 );
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_set_dictionary( &ctx, dictCtxs[i], DZRCOBS_USING_DICT_1 ) );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+								 dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encoded[i].data(), encoded[i].size() ) );
+		ctx.user6bits = 1;
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData.data(), decodedData.size() ) );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen[i] ) );
+	}
+
+	CHECK_EQUAL( encodedLen[0], encodedLen[1] );
+	MEMCMP_EQUAL( encoded[0].data(), encoded[1].data(), encodedLen[0] );
+
+	// Decoded with the generated context
+	std::vector<uint8_t> decoded( decodedData.size() + 1 );
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= encoded[1].data();
+	decodeCtx.srcBufEncodedLen	= encodedLen[1];
+	decodeCtx.dstBufDecoded			= decoded.data();
+	decodeCtx.dstBufDecodedSize = decoded.size();
+	decodeCtx.pDict[0]					= &G_TEST_DictionaryWordsCtx;
+	decodeCtx.pDict[1]					= nullptr;
+
+	size_t decodedLen			= 0;
+	uint8_t *decodedPos		= nullptr;
+	uint8_t user6bitsRead = 0;
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+	CHECK_EQUAL( decodedData.size(), decodedLen );
+	MEMCMP_EQUAL( decodedData.data(), decodedPos, decodedLen );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,54 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_dictionary_words.c
+///	@brief Dictionary used to test dzrcobs_add_dictionary
+///
+/// Built on the test at runtime and also generated by dzrcobs_dict_gen, the
+/// two must be the same. It has escapes, and words that start with a shorter
+/// word (so dzrcobs_dictionary_search never finds them).
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzrcobs/dzrcobs_dictionary.h>
+
+// clang-format off
+// NOLINTBEGIN
+
+/* Not a word: DICT_ADD_WORD(2, "zz") */
+const char G_TEST_DictionaryWords[] =
+	DICT_ADD_WORD(2, "\x00\x00")
+	DICT_ADD_WORD(2, "\x0D\x0A")
+	DICT_ADD_WORD(2, "\"\\")
+	DICT_ADD_WORD(2, "ab")
+	DICT_ADD_WORD(2, "th")
+	DICT_ADD_WORD(3, "\x00\x00\x01") // after "\x00\x00"
+	DICT_ADD_WORD(3, "a\tb")
+	DICT_ADD_WORD(3, "cat")
+	DICT_ADD_WORD(3, "\xFF\x00\x7F")
+	DICT_ADD_WORD(4, "\x12\x34\x56\x78")
+	DICT_ADD_WORD(4, "done")
+	DICT_ADD_WORD(4, "temp")
+	DICT_ADD_WORD(5, "\101BCDE")
+	DICT_ADD_WORD(5, "hello")
+	DICT_ADD_WORD(5, "tempo") // after "temp"
+	DICT_ADD_WORD(5, "xyz" "zy")
+;
+
+// NOLINTEND
+// clang-format on
+
+const size_t G_TEST_DictionaryWords_size = sizeof( G_TEST_DictionaryWords );
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
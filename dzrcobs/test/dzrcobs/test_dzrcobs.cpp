@@ -16,6 +16,7 @@
 
 // Includes
 // /////////////////////////////////////////////////////////////////////////////
+#include <../src/crc8.h>
 #include <CppUTest/TestHarness.h>
 #include <CppUTest/UtestMacros.h>
 #include <algorithm>
@@ -24,6 +25,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <random>
+#include <vector>
 #include <dzrcobs/dzrcobs.h>
 #include <dzrcobs/dzrcobs_decode.h>
 
@@ -83,6 +86,50 @@ void debug_dump_buffer( const uint8_t *aBuffer, size_t aBufferSize )
 	printf( "}\n" );
 }
 
+// Byte at a time plain encoder, used as reference for the optimized encoder
+static size_t reference_encode_plain( const uint8_t *aSrc, size_t aSrcSize, uint8_t aUser6bits, uint8_t *aDst )
+{
+	uint8_t *dst		= aDst;
+	uint8_t code		= 1;
+	uint8_t crc			= DZRCOBS_CRC_INIT_VAL;
+
+	for( size_t i = 0; i < aSrcSize; i++ )
+	{
+		const uint8_t byte = aSrc[i];
+
+		if( byte == 0 )
+		{
+			crc		 = DZRCOBS_CRC( crc, code );
+			*dst++ = code;
+			code	 = 1;
+		}
+		else
+		{
+			crc		 = DZRCOBS_CRC( crc, byte );
+			*dst++ = byte;
+			code++;
+
+			if( code == DZRCOBS_CODE_JUMP_PLAIN )
+			{
+				crc		 = DZRCOBS_CRC( crc, code );
+				*dst++ = code;
+				code	 = 1;
+			}
+		}
+	}
+
+	crc		 = DZRCOBS_CRC( crc, code );
+	*dst++ = code;
+
+	const uint8_t encodingByte = (uint8_t)( aUser6bits << 2 ) | DZRCOBS_PLAIN;
+
+	crc		 = DZRCOBS_CRC( crc, encodingByte );
+	*dst++ = encodingByte;
+	*dst++ = ( crc == 0x00 ) ? DZRCOBS_CRC_VALUE_WHEN_CRC_IS_ZERO : crc;
+
+	return (size_t)( dst - aDst );
+}
+
 // Test data
 // /////////////////////////////////////////////////////////////////////////////
 
@@ -469,6 +516,126 @@ TEST( DZRCOBS, DecodeInvalidArgs )
 	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
 }
 
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeUntrustedCodes )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	uint8_t encoded[8];
+	uint8_t decoded[8];
+
+	// Frames with a valid CRC, as a corrupted frame may still have
+	auto decodeFrame = [&]( const std::vector<uint8_t> &aCodes, eDZRCOBS_encoding aEncoding, size_t aDstSize ) -> eDZRCOBS_ret
+	{
+		const size_t codesLen = aCodes.size();
+		memcpy( encoded, aCodes.data(), codesLen );
+
+		encoded[codesLen] = (uint8_t)( ( TEST_USERBITS << 2 ) | aEncoding );
+
+		const uint8_t crc			= dzrcobs_crc8_block( DZRCOBS_CRC_INIT_VAL, encoded, codesLen + 1 );
+		encoded[codesLen + 1] = ( crc == 0 ) ? DZRCOBS_CRC_VALUE_WHEN_CRC_IS_ZERO : crc;
+
+		sDZRCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= encoded;
+		decodeCtx.srcBufEncodedLen	= codesLen + DZRCOBS_FRAME_HEADER_SIZE;
+		decodeCtx.dstBufDecoded			= decoded;
+		decodeCtx.dstBufDecodedSize = aDstSize;
+		decodeCtx.pDict[0]					= &dictCtx;
+		decodeCtx.pDict[1]					= nullptr;
+
+		size_t decodedLen							= 0;
+		uint8_t *decodedPos						= nullptr;
+		uint8_t user6bitDataRightAlgn = 0;
+
+		return dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitDataRightAlgn );
+	};
+
+	// A run of 2 bytes with only 1 before it
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, decodeFrame( { 'A', 0x03 }, DZRCOBS_PLAIN, sizeof( decoded ) ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD,
+							 decodeFrame( { 'A', 0x03 | DZRCOBS_NEXTCODE_IS_ZERO }, DZRCOBS_USING_DICT_1, sizeof( decoded ) ) );
+
+	// The last two tokens are never encoded
+	CHECK_EQUAL( DZRCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY,
+							 decodeFrame( { 0x80 + 126 }, DZRCOBS_USING_DICT_1, sizeof( decoded ) ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_WORD_NOT_FOUND_ON_DICTIONARY,
+							 decodeFrame( { 0x80 + 127 }, DZRCOBS_USING_DICT_1, sizeof( decoded ) ) );
+
+	// Two zeros, on room for one
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, decodeFrame( { 0x01, 0x01, 0x01 }, DZRCOBS_PLAIN, 2 ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, decodeFrame( { 0x01, 0x01, 0x01 }, DZRCOBS_PLAIN, 1 ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeRunEmbeddedZero )
+// NOLINTEND
+{
+	uint8_t encoded[DZRCOBS_CODE_JUMP_PLAIN + DZRCOBS_FRAME_HEADER_SIZE];
+	uint8_t decoded[DZRCOBS_CODE_JUMP_PLAIN];
+
+	// Sets the encoding byte and the CRC of a frame with aDataLen bytes of encoded data
+	auto finishFrame = [&encoded]( size_t aDataLen ) -> size_t
+	{
+		encoded[aDataLen] = ( TEST_USERBITS << 2 ) | DZRCOBS_PLAIN;
+
+		const uint8_t crc			= dzrcobs_crc8_block( DZRCOBS_CRC_INIT_VAL, encoded, aDataLen + 1 );
+		encoded[aDataLen + 1] = ( crc == 0 ) ? DZRCOBS_CRC_VALUE_WHEN_CRC_IS_ZERO : crc;
+
+		return aDataLen + DZRCOBS_FRAME_HEADER_SIZE;
+	};
+
+	// A single run of every length, with a zero at every position of the run
+	for( size_t runSize = 1; runSize < ( DZRCOBS_CODE_JUMP_PLAIN - 1 ); runSize++ )
+	{
+		for( size_t i = 0; i < runSize; i++ )
+		{
+			encoded[i] = (uint8_t)( i + 1 );
+		}
+
+		encoded[runSize] = (uint8_t)( runSize + 1 );
+
+		sDZRCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= encoded;
+		decodeCtx.srcBufEncodedLen	= finishFrame( runSize + 1 );
+		decodeCtx.dstBufDecoded			= decoded;
+		decodeCtx.dstBufDecodedSize = sizeof( decoded );
+
+		size_t decodedLen							= 0;
+		uint8_t *decodedPos						= nullptr;
+		uint8_t user6bitDataRightAlgn = 0;
+
+		eDZRCOBS_ret ret = dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitDataRightAlgn );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( runSize, decodedLen );
+		CHECK_EQUAL( 0, memcmp( encoded, decodedPos, runSize ) );
+
+		for( size_t zeroPos = 0; zeroPos < runSize; zeroPos++ )
+		{
+			const uint8_t byte = encoded[zeroPos];
+			encoded[zeroPos]	 = 0;
+
+			decodeCtx.srcBufEncodedLen = finishFrame( runSize + 1 );
+
+			ret = dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitDataRightAlgn );
+			CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, ret );
+
+			encoded[zeroPos] = byte;
+		}
+
+		// The code is longer than the encoded data
+		encoded[runSize - 1] = (uint8_t)( runSize + 1 );
+
+		decodeCtx.srcBufEncodedLen = finishFrame( runSize );
+
+		ret = dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitDataRightAlgn );
+		CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, ret );
+	}
+}
+
 // NOLINTBEGIN
 TEST( DZRCOBS, EncodeBeginInvalidArgs )
 // NOLINTEND
@@ -737,6 +904,62 @@ TEST( DZRCOBS, EncodeDecodeLongRandomPlain )
 	CHECK_EQUAL( 0, memcmp( decodedData, decodedPos, decodedLen ) );
 }
 
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodePlainMatchesReference )
+// NOLINTEND
+{
+	static constexpr size_t maxDataSize = 700;
+
+	// Zero density from none to very sparse, to exercise long runs and the jump code
+	static const unsigned zeroOneIn[] = { 0, 2, 16, 64, 127, 200, 1000 };
+
+	std::vector<uint8_t> decodedData( maxDataSize );
+	std::vector<uint8_t> expected( DZRCOBS_MAX_ENCODED_SIZE( maxDataSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+	std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE( maxDataSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+	for( const unsigned oneIn : zeroOneIn )
+	{
+		for( size_t dataSize = 1; dataSize <= maxDataSize; dataSize += 7 )
+		{
+			for( size_t i = 0; i < dataSize; i++ )
+			{
+				const bool isZero = ( oneIn != 0 ) && ( ( (unsigned)rand() % oneIn ) == 0 );
+				decodedData[i]		= isZero ? 0x00 : (uint8_t)( ( rand() % 255 ) + 1 );
+			}
+
+			const size_t expectedLen = reference_encode_plain( decodedData.data(), dataSize, TEST_USERBITS, expected.data() );
+
+			// Feed on a single call and split in two calls
+			for( size_t split = 0; split <= dataSize; split += ( dataSize / 3 ) + 1 )
+			{
+				sDZRCOBS_ctx ctx;
+
+				eDZRCOBS_ret ret = dzrcobs_encode_inc_begin( &ctx,
+																										 DZRCOBS_PLAIN,
+																										 encoded.data(),
+																										 DZRCOBS_MAX_ENCODED_SIZE( dataSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+				CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+
+				ctx.user6bits = TEST_USERBITS;
+
+				ret = dzrcobs_encode_inc( &ctx, decodedData.data(), split );
+				CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+
+				ret = dzrcobs_encode_inc( &ctx, decodedData.data() + split, dataSize - split );
+				CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+
+				size_t encodedLen = 0;
+
+				ret = dzrcobs_encode_inc_end( &ctx, &encodedLen );
+				CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+
+				CHECK_EQUAL( expectedLen, encodedLen );
+				CHECK_EQUAL( 0, memcmp( expected.data(), encoded.data(), expectedLen ) );
+			}
+		}
+	}
+}
+
 // NOLINTBEGIN
 TEST( DZRCOBS, EncodeDecodeLongRandomDictionary )
 // NOLINTEND
@@ -813,5 +1036,1742 @@ TEST( DZRCOBS, EncodeDecodeLongRandomDictionary )
 	CHECK_EQUAL( 0, memcmp( decodedData, decodedPos, decodedLen ) );
 }
 
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeInPlacePlain )
+// NOLINTEND
+{
+	uint8_t decodedData[600];
+
+	for( size_t decodedDataSize = 1; decodedDataSize <= sizeof( decodedData ); decodedDataSize += 7 )
+	{
+		for( size_t i = 0; i < decodedDataSize; i++ )
+		{
+			decodedData[i] = ( ( rand() % 64 ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+		}
+
+		const size_t encodedLen = reference_encode_plain( decodedData, decodedDataSize, TEST_USERBITS, buffer );
+
+		sDZRCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= buffer;
+		decodeCtx.srcBufEncodedLen	= encodedLen;
+		decodeCtx.dstBufDecoded			= buffer;
+		decodeCtx.dstBufDecodedSize = encodedLen;
+
+		size_t headroom = 1;
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode_inplace_headroom( &decodeCtx, &headroom ) );
+		CHECK_EQUAL( 0, headroom );
+
+		size_t decodedLen			= 0;
+		uint8_t *decodedPos		= nullptr;
+		uint8_t user6bitsRead = 0;
+
+		eDZRCOBS_ret ret = dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead );
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( TEST_USERBITS, user6bitsRead );
+		CHECK_EQUAL( decodedDataSize, decodedLen );
+		CHECK_EQUAL( 0, memcmp( decodedData, decodedPos, decodedLen ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeInPlaceDictionary )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static const uint8_t words[][5] = {
+		{ 0x01, 0x01 }, { 0x02, 0x00, 0x02 }, { 0x03, 0x00, 0x00, 0x03 }, { 0x04, 0x00, 0x00, 0x00, 0x04 } };
+
+	uint8_t decodedData[300];
+	uint8_t encoded[DZRCOBS_MAX_ENCODED_SIZE( sizeof( decodedData ) ) + DZRCOBS_FRAME_HEADER_SIZE];
+
+	size_t framesWithHeadroom = 0;
+
+	for( size_t test = 0; test < 64; test++ )
+	{
+		// Words and random bytes, more words on latter tests
+		size_t decodedDataSize = 0;
+
+		while( decodedDataSize < ( sizeof( decodedData ) - 5 ) )
+		{
+			if( ( (size_t)rand() % 64 ) < test )
+			{
+				const size_t word = (size_t)rand() % 4;
+				memcpy( decodedData + decodedDataSize, words[word], word + 2 );
+				decodedDataSize += word + 2;
+			}
+			else
+			{
+				decodedData[decodedDataSize++] = (uint8_t)rand();
+			}
+		}
+
+		sDZRCOBS_ctx ctx;
+		size_t encodedLen = 0;
+
+		dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encoded, sizeof( encoded ) ) );
+		ctx.user6bits = TEST_USERBITS;
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData, decodedDataSize ) );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+		sDZRCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded		 = encoded;
+		decodeCtx.srcBufEncodedLen = encodedLen;
+		decodeCtx.pDict[0]				 = &dictCtx;
+		decodeCtx.pDict[1]				 = nullptr;
+
+		size_t headroom = 0;
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode_inplace_headroom( &decodeCtx, &headroom ) );
+		CHECK_COMPARE( headroom + encodedLen, >=, decodedDataSize );
+		CHECK_COMPARE( headroom + encodedLen, <=, UTEST_ENCODED_DECODED_DATA_MAX_SIZE );
+
+		framesWithHeadroom += ( headroom > 0 ) ? 1 : 0;
+
+		size_t decodedLen			= 0;
+		uint8_t *decodedPos		= nullptr;
+		uint8_t user6bitsRead = 0;
+
+		// One byte less than the headroom must fail, without reading overwritten codes
+		if( headroom > 0 )
+		{
+			memcpy( buffer, encoded, encodedLen );
+
+			decodeCtx.srcBufEncoded			= buffer;
+			decodeCtx.dstBufDecoded			= buffer;
+			decodeCtx.dstBufDecodedSize = encodedLen + headroom - 1;
+
+			CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+		}
+
+		memcpy( buffer, encoded, encodedLen );
+
+		decodeCtx.srcBufEncoded			= buffer;
+		decodeCtx.dstBufDecoded			= buffer;
+		decodeCtx.dstBufDecodedSize = encodedLen + headroom;
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+		CHECK_EQUAL( TEST_USERBITS, user6bitsRead );
+		CHECK_EQUAL( decodedDataSize, decodedLen );
+		CHECK_EQUAL( 0, memcmp( decodedData, decodedPos, decodedLen ) );
+	}
+
+	CHECK_COMPARE( framesWithHeadroom, >, 0 );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeInPlaceExactHeadroom )
+// NOLINTEND
+{
+	// Only words, each token decodes to 5 bytes, so the headroom is most of the
+	// decoded size. The destiny is the frame and the headroom after it.
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static const uint8_t word[] = { 0x04, 0x00, 0x00, 0x00, 0x04 };
+
+	uint8_t decodedData[40 * sizeof( word )];
+	uint8_t encoded[DZRCOBS_MAX_ENCODED_SIZE( sizeof( decodedData ) ) + DZRCOBS_FRAME_HEADER_SIZE];
+
+	for( size_t i = 0; i < sizeof( decodedData ); i += sizeof( word ) )
+	{
+		memcpy( &decodedData[i], word, sizeof( word ) );
+	}
+
+	sDZRCOBS_ctx ctx;
+	size_t encodedLen = 0;
+
+	dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encoded, sizeof( encoded ) ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData, sizeof( decodedData ) ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded		 = encoded;
+	decodeCtx.srcBufEncodedLen = encodedLen;
+	decodeCtx.pDict[0]				 = &dictCtx;
+	decodeCtx.pDict[1]				 = nullptr;
+
+	size_t headroom = 0;
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode_inplace_headroom( &decodeCtx, &headroom ) );
+	CHECK_COMPARE( headroom, >, 0 );
+	CHECK_COMPARE( encodedLen + headroom, >=, sizeof( decodedData ) );
+
+	size_t decodedLen			= 0;
+	uint8_t *decodedPos		= nullptr;
+	uint8_t user6bitsRead = 0;
+
+	for( const size_t dstSize : { encodedLen + headroom - 1, encodedLen + headroom } )
+	{
+		memset( buffer, UTEST_GUARD_BYTE, UTEST_ENCODED_DECODED_DATA_MAX_SIZE );
+		memcpy( buffer, encoded, encodedLen );
+
+		decodeCtx.srcBufEncoded			= buffer;
+		decodeCtx.dstBufDecoded			= buffer;
+		decodeCtx.dstBufDecodedSize = dstSize;
+
+		const eDZRCOBS_ret ret = dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead );
+
+		// Nothing is written after the destiny
+		for( size_t i = dstSize; i < ( dstSize + UTEST_GUARD_SIZE ); i++ )
+		{
+			CHECK_EQUAL( UTEST_GUARD_BYTE, buffer[i] );
+		}
+
+		if( dstSize < ( encodedLen + headroom ) )
+		{
+			CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, ret );
+			continue;
+		}
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( TEST_USERBITS, user6bitsRead );
+		CHECK_EQUAL( sizeof( decodedData ), decodedLen );
+		POINTERS_EQUAL( buffer + dstSize - decodedLen, decodedPos );
+		CHECK_EQUAL( 0, memcmp( decodedData, decodedPos, decodedLen ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeInPlaceEndsBeforeFrame )
+// NOLINTEND
+{
+	uint8_t decodedData[64];
+	uint8_t frame[DZRCOBS_MAX_ENCODED_SIZE( sizeof( decodedData ) ) + DZRCOBS_FRAME_HEADER_SIZE];
+
+	for( size_t i = 0; i < sizeof( decodedData ); i++ )
+	{
+		decodedData[i] = (uint8_t)( i % 7 );
+	}
+
+	static constexpr size_t frameOffset = 8;
+
+	const size_t encodedLen = reference_encode_plain( decodedData, sizeof( decodedData ), TEST_USERBITS, frame );
+	memcpy( buffer + frameOffset, frame, encodedLen );
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded		 = buffer + frameOffset;
+	decodeCtx.srcBufEncodedLen = encodedLen;
+	decodeCtx.dstBufDecoded		 = buffer;
+	decodeCtx.pDict[0]				 = nullptr;
+	decodeCtx.pDict[1]				 = nullptr;
+
+	size_t decodedLen			= 0;
+	uint8_t *decodedPos		= nullptr;
+	uint8_t user6bitsRead = 0;
+
+	// The destiny overlaps the frame but ends before it, so it is rejected and nothing is written
+	for( const size_t dstSize : { frameOffset + 1, frameOffset + ( encodedLen / 2 ), frameOffset + encodedLen - 1 } )
+	{
+		decodeCtx.dstBufDecodedSize = dstSize;
+
+		CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+		CHECK_EQUAL( 0, memcmp( buffer + frameOffset, frame, encodedLen ) );
+	}
+
+	// Ending with the frame is in-place
+	decodeCtx.dstBufDecodedSize = frameOffset + encodedLen;
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+	CHECK_EQUAL( sizeof( decodedData ), decodedLen );
+	CHECK_EQUAL( 0, memcmp( decodedData, decodedPos, decodedLen ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeLeftAligned )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	uint8_t decodedData[300];
+	uint8_t encoded[DZRCOBS_MAX_ENCODED_SIZE( sizeof( decodedData ) ) + DZRCOBS_FRAME_HEADER_SIZE];
+	uint8_t decoded[sizeof( decodedData ) + 16];
+
+	for( size_t test = 0; test < 128; test++ )
+	{
+		const eDZRCOBS_encoding encoding = ( test & 1 ) ? DZRCOBS_USING_DICT_1 : DZRCOBS_PLAIN;
+		const size_t decodedDataSize		 = test * 2;
+
+		for( size_t i = 0; i < decodedDataSize; i++ )
+		{
+			// Small values, to have dictionary words, zeros and long runs
+			decodedData[i] = ( test & 2 ) ? (uint8_t)( rand() & 0x03 ) : (uint8_t)( ( rand() % 255 ) + 1 );
+		}
+
+		sDZRCOBS_ctx ctx;
+		size_t encodedLen = 0;
+
+		dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, encoding, encoded, sizeof( encoded ) ) );
+		ctx.user6bits = TEST_USERBITS;
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData, decodedDataSize ) );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+		sDZRCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= encoded;
+		decodeCtx.srcBufEncodedLen	= encodedLen;
+		decodeCtx.dstBufDecoded			= decoded;
+		decodeCtx.dstBufDecodedSize = sizeof( decoded );
+		decodeCtx.pDict[0]					= &dictCtx;
+		decodeCtx.pDict[1]					= nullptr;
+
+		size_t decodedSize = 0;
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decoded_size( &decodeCtx, &decodedSize ) );
+		CHECK_EQUAL( decodedDataSize, decodedSize );
+
+		memset( decoded, UTEST_GUARD_BYTE, sizeof( decoded ) );
+
+		size_t decodedLen			= 0;
+		uint8_t user6bitsRead = 0;
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode_left_aligned( &decodeCtx, &decodedLen, &user6bitsRead ) );
+		CHECK_EQUAL( TEST_USERBITS, user6bitsRead );
+		CHECK_EQUAL( decodedDataSize, decodedLen );
+		CHECK_EQUAL( 0, memcmp( decodedData, decoded, decodedLen ) );
+		CHECK_EQUAL( UTEST_GUARD_BYTE, decoded[decodedLen] );
+
+		if( decodedDataSize > 0 )
+		{
+			decodeCtx.dstBufDecodedSize = decodedDataSize - 1;
+			CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, dzrcobs_decode_left_aligned( &decodeCtx, &decodedLen, &user6bitsRead ) );
+		}
+
+		// A corrupted frame is reported as dzrcobs_decode does
+		decodeCtx.dstBufDecodedSize = sizeof( decoded );
+		encoded[0] ^= 0x80;
+
+		uint8_t *decodedPos = nullptr;
+		const eDZRCOBS_ret expectedRet = dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead );
+
+		CHECK_EQUAL( expectedRet, dzrcobs_decode_left_aligned( &decodeCtx, &decodedLen, &user6bitsRead ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeDecodeJumpBoundaryPlain )
+// NOLINTEND
+{
+	// Blocks of non zero bytes that end exactly on a jump code, followed by zeros or the end of data
+	static constexpr size_t maxDataSize = ( DZRCOBS_CODE_JUMP_PLAIN * 2 ) + 2;
+
+	std::vector<uint8_t> decodedData( maxDataSize );
+	std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE( maxDataSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+	std::vector<uint8_t> decoded( maxDataSize );
+
+	for( size_t dataSize = DZRCOBS_CODE_JUMP_PLAIN - 2; dataSize <= maxDataSize; dataSize++ )
+	{
+		for( size_t zeroPos = 0; zeroPos <= dataSize; zeroPos++ )
+		{
+			std::fill( decodedData.begin(), decodedData.begin() + dataSize, 0x11 );
+
+			if( zeroPos < dataSize )
+			{
+				decodedData[zeroPos] = 0x00;
+			}
+
+			sDZRCOBS_ctx ctx;
+
+			eDZRCOBS_ret ret = dzrcobs_encode_inc_begin(
+			 &ctx, DZRCOBS_PLAIN, encoded.data(), DZRCOBS_MAX_ENCODED_SIZE( dataSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+
+			ctx.user6bits = TEST_USERBITS;
+
+			ret = dzrcobs_encode_inc( &ctx, decodedData.data(), dataSize );
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+
+			size_t encodedLen = 0;
+
+			ret = dzrcobs_encode_inc_end( &ctx, &encodedLen );
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+
+			sDZRCOBS_decodectx decodeCtx;
+			decodeCtx.srcBufEncoded			= encoded.data();
+			decodeCtx.srcBufEncodedLen	= encodedLen;
+			decodeCtx.dstBufDecoded			= decoded.data();
+			decodeCtx.dstBufDecodedSize = decoded.size();
+
+			size_t decodedLen							= 0;
+			uint8_t *decodedPos						= nullptr;
+			uint8_t user6bitDataRightAlgn = 0;
+
+			ret = dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitDataRightAlgn );
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+			CHECK_EQUAL( dataSize, decodedLen );
+			CHECK_EQUAL( 0, memcmp( decodedData.data(), decodedPos, decodedLen ) );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeDecodeJumpBoundaryDictionary )
+// NOLINTEND
+{
+	// A block that ends exactly on a jump code, between words, zeros or the frame limits
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static const uint8_t word[] = { 0x01, 0x01 };
+	static constexpr size_t blockSize = DZRCOBS_CODE_JUMP - 1;
+
+	// 0: nothing, 1: a word, 2: a zero
+	for( size_t before = 0; before < 3; before++ )
+	{
+		for( size_t after = 0; after < 3; after++ )
+		{
+			std::vector<uint8_t> decodedData;
+
+			if( before == 1 )
+			{
+				decodedData.insert( decodedData.end(), word, word + sizeof( word ) );
+			}
+			else if( before == 2 )
+			{
+				decodedData.push_back( 0x00 );
+			}
+
+			decodedData.insert( decodedData.end(), blockSize, 0x11 );
+
+			if( after == 1 )
+			{
+				decodedData.insert( decodedData.end(), word, word + sizeof( word ) );
+			}
+			else if( after == 2 )
+			{
+				decodedData.push_back( 0x00 );
+			}
+
+			std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( decodedData.size() ) +
+																		DZRCOBS_FRAME_HEADER_SIZE );
+			std::vector<uint8_t> decoded( decodedData.size() );
+
+			sDZRCOBS_ctx ctx;
+			size_t encodedLen = 0;
+
+			dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+									 dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encoded.data(), encoded.size() ) );
+			ctx.user6bits = TEST_USERBITS;
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData.data(), decodedData.size() ) );
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+			sDZRCOBS_decodectx decodeCtx;
+			decodeCtx.srcBufEncoded			= encoded.data();
+			decodeCtx.srcBufEncodedLen	= encodedLen;
+			decodeCtx.dstBufDecoded			= decoded.data();
+			decodeCtx.dstBufDecodedSize = decoded.size();
+			decodeCtx.pDict[0]					= &dictCtx;
+
+			size_t decodedLen			= 0;
+			uint8_t *decodedPos		= nullptr;
+			uint8_t user6bitsRead = 0;
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+			CHECK_EQUAL( decodedData.size(), decodedLen );
+			CHECK_EQUAL( 0, memcmp( decodedData.data(), decodedPos, decodedLen ) );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeBaselineFrames )
+// NOLINTEND
+{
+	// Frames written by the encoder before the empty code after a jump carried
+	// the next-code bits, on the default dictionary (user6bits 5). They have
+	// jumps, words and zeros, and must decode as they always did.
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret =
+	 dzrcobs_dictionary_init( &dictCtx, G_DZRCOBS_DefaultDictionary, G_DZRCOBS_DefaultDictionary_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	// clang-format off
+	static const uint8_t dictionaryData[] = {
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x65, 0x42, 0x3C, 0x5F, 0x83, 0xBC, 0x0B, 0x64, 0x70,
+		0x91, 0x50, 0x41, 0xF0, 0x37, 0x0A, 0x5F, 0x91, 0x4E, 0xD0, 0xA9, 0x36, 0x85, 0x2B, 0x50, 0x4F,
+		0x26, 0x6E, 0x0E, 0x23, 0xD2, 0xC9, 0xC0, 0x18, 0x09, 0x24, 0x05, 0x30, 0x2D, 0xCD, 0x9E, 0x29,
+		0x22, 0xDD, 0x1D, 0x57, 0x52, 0xE0, 0x52, 0x9E, 0x21, 0x66, 0xD2, 0x10, 0x8F, 0x8C, 0x5D, 0xB3,
+		0xF9, 0x69, 0xD4, 0x3B, 0x36, 0x99, 0xB7, 0xA4,
+	};
+	static const uint8_t dictionaryFrame[] = {
+		0x80, 0x80, 0x80, 0x65, 0x42, 0x3C, 0x5F, 0x83, 0xBC, 0x0B, 0x64, 0x70, 0x91, 0x50, 0x41, 0xF0,
+		0x37, 0x0A, 0x5F, 0x91, 0x4E, 0xD0, 0xA9, 0x36, 0x85, 0x2B, 0x50, 0x4F, 0x26, 0x6E, 0x0E, 0x23,
+		0xD2, 0xC9, 0xC0, 0x18, 0x09, 0x24, 0x05, 0x30, 0x2D, 0xCD, 0x9E, 0x29, 0x22, 0xDD, 0x1D, 0x57,
+		0x52, 0xE0, 0x52, 0x9E, 0x21, 0x66, 0xD2, 0x10, 0x8F, 0x8C, 0x5D, 0xB3, 0xF9, 0x69, 0xD4, 0x3B,
+		0x36, 0x3F, 0x99, 0xB7, 0xA4, 0x04, 0x15, 0xDE,
+	};
+	static const uint8_t plainData[] = {
+		0x04, 0x00, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x01, 0x01, 0xAB, 0xCD, 0x38, 0x1C, 0xC2, 0x8E,
+		0x98, 0x13, 0x9F, 0x57, 0x48, 0x8B, 0x85, 0x51, 0x0E, 0x38, 0x86, 0xD4, 0x84, 0x21, 0x9D, 0x9E,
+		0x2B, 0x36, 0x95, 0x87, 0xF1, 0x83, 0xC5, 0x98, 0x62, 0x74, 0x69, 0x04, 0xF4, 0x95, 0xF6, 0xF6,
+		0xA7, 0x99, 0x51, 0x59, 0x8F, 0x40, 0xA9, 0x07, 0x76, 0x33, 0xDA, 0xF8, 0xB8, 0xE1, 0x06, 0xE2,
+		0x1C, 0x9A, 0x6D, 0x77, 0x21, 0x36, 0x79, 0xE7, 0x14, 0xE0, 0xE9, 0x72, 0xE0, 0x4F, 0x6C, 0x8B,
+		0x53, 0x27, 0xE2, 0xE0, 0xCC, 0xF5, 0xE5, 0xAC, 0x93, 0x2F, 0xA9, 0x4F, 0x15, 0x19, 0x35, 0x95,
+		0xB1, 0x0C, 0x10, 0x3C, 0xA6, 0x87, 0x8D, 0xB8, 0xD1, 0x7A, 0x94, 0xB5, 0x34, 0x6A, 0xAA, 0x85,
+		0xF6, 0xF7, 0x69, 0xC6, 0x5C, 0xB8, 0x76, 0xED, 0xE6, 0x89, 0xA7, 0xF9, 0xA1, 0xDA, 0x92, 0xBC,
+		0x51, 0x0C, 0xF7, 0xF5, 0xF7, 0x88, 0x1E, 0x38, 0x6D, 0x1C, 0xEC,
+	};
+	static const uint8_t plainFrame[] = {
+		0x04, 0x02, 0x01, 0x01, 0x04, 0x01, 0x03, 0x01, 0x01, 0x01, 0xAB, 0xCD, 0x38, 0x1C, 0xC2, 0x8E,
+		0x98, 0x13, 0x9F, 0x57, 0x48, 0x8B, 0x85, 0x51, 0x0E, 0x38, 0x86, 0xD4, 0x84, 0x21, 0x9D, 0x9E,
+		0x2B, 0x36, 0x95, 0x87, 0xF1, 0x83, 0xC5, 0x98, 0x62, 0x74, 0x69, 0x04, 0xF4, 0x95, 0xF6, 0xF6,
+		0xA7, 0x99, 0x51, 0x59, 0x8F, 0x40, 0xA9, 0x07, 0x76, 0x33, 0xDA, 0xF8, 0xB8, 0xE1, 0x06, 0xE2,
+		0x1C, 0x9A, 0x6D, 0x77, 0x21, 0x36, 0x79, 0xE7, 0x14, 0xE0, 0xE9, 0x72, 0xE0, 0x4F, 0x6C, 0x8B,
+		0x53, 0x27, 0xE2, 0xE0, 0xCC, 0xF5, 0xE5, 0xAC, 0x93, 0x2F, 0xA9, 0x4F, 0x15, 0x19, 0x35, 0x95,
+		0xB1, 0x0C, 0x10, 0x3C, 0xA6, 0x87, 0x8D, 0xB8, 0xD1, 0x7A, 0x94, 0xB5, 0x34, 0x6A, 0xAA, 0x85,
+		0xF6, 0xF7, 0x69, 0xC6, 0x5C, 0xB8, 0x76, 0xED, 0xE6, 0x89, 0xA7, 0xF9, 0xA1, 0xDA, 0x92, 0xBC,
+		0x51, 0x0C, 0xF7, 0xF5, 0xF7, 0x88, 0x7F, 0x1E, 0x38, 0x6D, 0x1C, 0xEC, 0x06, 0x14, 0x84,
+	};
+	// clang-format on
+
+	const struct
+	{
+		const uint8_t *pData;
+		size_t dataSize;
+		const uint8_t *pFrame;
+		size_t frameSize;
+	} vectors[] = {
+		{ dictionaryData, sizeof( dictionaryData ), dictionaryFrame, sizeof( dictionaryFrame ) },
+		{ plainData, sizeof( plainData ), plainFrame, sizeof( plainFrame ) },
+	};
+
+	for( const auto &vector : vectors )
+	{
+		std::vector<uint8_t> decoded( vector.frameSize );
+
+		sDZRCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= vector.pFrame;
+		decodeCtx.srcBufEncodedLen	= vector.frameSize;
+		decodeCtx.dstBufDecoded			= decoded.data();
+		decodeCtx.dstBufDecodedSize = decoded.size();
+		decodeCtx.pDict[0]					= &dictCtx;
+		decodeCtx.pDict[1]					= nullptr;
+
+		size_t decodedLen			= 0;
+		uint8_t *decodedPos		= nullptr;
+		uint8_t user6bitsRead = 0;
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+		CHECK_EQUAL( vector.dataSize, decodedLen );
+		CHECK_EQUAL( 0, memcmp( vector.pData, decodedPos, decodedLen ) );
+		CHECK_EQUAL( 5, user6bitsRead );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeJumpBoundaryDictionaryFrame )
+// NOLINTEND
+{
+	// A word, then a block that ends on the jump code and on the frame. The empty
+	// code after the jump carries the next-code bits (0x41). Older encoders wrote
+	// 0x01, that decodes with an extra zero before the block.
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret =
+	 dzrcobs_dictionary_init( &dictCtx, G_DZRCOBS_DefaultDictionary, G_DZRCOBS_DefaultDictionary_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static constexpr size_t blockSize = DZRCOBS_CODE_JUMP - 1;
+
+	std::vector<uint8_t> decodedData = { 0x00, 0x00 };
+	decodedData.insert( decodedData.end(), blockSize, 0x11 );
+
+	std::vector<uint8_t> expectedFrame = { 0x80 + 0 };
+	expectedFrame.insert( expectedFrame.end(), blockSize, 0x11 );
+	expectedFrame.push_back( DZRCOBS_CODE_JUMP );
+	expectedFrame.push_back( 0x01 | DZRCOBS_NEXTCODE_IS_DICTIONARY );
+	expectedFrame.push_back( ( 5 << 2 ) | DZRCOBS_USING_DICT_1 );
+	expectedFrame.push_back( 0x9C ); // CRC8
+
+	std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( decodedData.size() ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+	sDZRCOBS_ctx ctx;
+	size_t encodedLen = 0;
+
+	dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+							 dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encoded.data(), encoded.size() ) );
+	ctx.user6bits = 5;
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData.data(), decodedData.size() ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	CHECK_EQUAL( expectedFrame.size(), encodedLen );
+	CHECK_EQUAL( 0, memcmp( expectedFrame.data(), encoded.data(), encodedLen ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeLastWordSizeFrame )
+// NOLINTEND
+{
+	// Words of the last word size after its first one, that no shorter word
+	// prefixes. Older encoders did not find them and wrote literals.
+	static const char dictionary[] =
+		DICT_ADD_WORD(2, "ab")
+		DICT_ADD_WORD(3, "abc")
+		DICT_ADD_WORD(4, "abcd")
+		DICT_ADD_WORD(5, "[0000")
+		DICT_ADD_WORD(5, "temp=")
+		DICT_ADD_WORD(5, "xyzzy");
+
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, dictionary, sizeof( dictionary ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static const uint8_t decodedData[] = { 't', 'e', 'm', 'p', '=', '2', '1', ' ', 'x', 'y', 'z', 'z', 'y' };
+
+	// "temp=" (index 4), 3 literals and their code, "xyzzy" (index 5)
+	static const uint8_t expectedFrame[] = { 0x80 + 4,
+																					 '2',
+																					 '1',
+																					 ' ',
+																					 0x04 | DZRCOBS_NEXTCODE_IS_DICTIONARY,
+																					 0x80 + 5,
+																					 ( TEST_USERBITS << 2 ) | DZRCOBS_USING_DICT_1,
+																					 0x68 }; // CRC8
+
+	uint8_t encoded[DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( sizeof( decodedData ) ) + DZRCOBS_FRAME_HEADER_SIZE];
+
+	sDZRCOBS_ctx ctx;
+	size_t encodedLen = 0;
+
+	dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encoded, sizeof( encoded ) ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData, sizeof( decodedData ) ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	CHECK_EQUAL( sizeof( expectedFrame ), encodedLen );
+	CHECK_EQUAL( 0, memcmp( expectedFrame, encoded, encodedLen ) );
+
+	uint8_t decoded[sizeof( decodedData )];
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= encoded;
+	decodeCtx.srcBufEncodedLen	= encodedLen;
+	decodeCtx.dstBufDecoded			= decoded;
+	decodeCtx.dstBufDecodedSize = sizeof( decoded );
+	decodeCtx.pDict[0]					= &dictCtx;
+	decodeCtx.pDict[1]					= nullptr;
+
+	size_t decodedLen			= 0;
+	uint8_t *decodedPos		= nullptr;
+	uint8_t user6bitsRead = 0;
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+	CHECK_EQUAL( sizeof( decodedData ), decodedLen );
+	CHECK_EQUAL( 0, memcmp( decodedData, decodedPos, decodedLen ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeDictionaryOverflow )
+// NOLINTEND
+{
+	// Literals only, a dictionary block jumps every 62 bytes, so it needs more
+	// than DZRCOBS_MAX_ENCODED_SIZE
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static constexpr size_t dataSize = 8000;
+
+	const std::vector<uint8_t> decodedData( dataSize, 0x11 );
+
+	// The data does not fit on the first one, nor on the plain worst case of
+	// the second one (it may overflow on dzrcobs_encode_inc_end there)
+	const size_t sizes[] = { ( dataSize / 2 ) + DZRCOBS_FRAME_HEADER_SIZE,
+													 DZRCOBS_MAX_ENCODED_SIZE( dataSize ) + DZRCOBS_FRAME_HEADER_SIZE,
+													 DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( dataSize ) + DZRCOBS_FRAME_HEADER_SIZE };
+
+	for( size_t s = 0; s < 3; s++ )
+	{
+		const size_t dstSize = sizes[s];
+
+		std::vector<uint8_t> encoded( dstSize + UTEST_GUARD_SIZE, UTEST_GUARD_BYTE );
+
+		sDZRCOBS_ctx ctx;
+		size_t encodedLen = 0;
+
+		dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encoded.data(), dstSize ) );
+		ctx.user6bits = TEST_USERBITS;
+
+		sDZRCOBS_ctx ctxBefore = ctx;
+
+		eDZRCOBS_ret ret = dzrcobs_encode_inc( &ctx, decodedData.data(), dataSize );
+
+		if( ret == DZRCOBS_RET_SUCCESS )
+		{
+			ctxBefore = ctx;
+			ret				= dzrcobs_encode_inc_end( &ctx, &encodedLen );
+		}
+
+		// Nothing is written after the destiny buffer
+		for( size_t i = 0; i < UTEST_GUARD_SIZE; i++ )
+		{
+			CHECK_EQUAL( UTEST_GUARD_BYTE, encoded[dstSize + i] );
+		}
+
+		if( s < 2 )
+		{
+			CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, ret );
+
+			// The context is as before the call that overflowed
+			CHECK( ctx.pCurDst == ctxBefore.pCurDst );
+			CHECK_EQUAL( ctxBefore.crc, ctx.crc );
+			CHECK_EQUAL( ctxBefore.code, ctx.code );
+			CHECK_EQUAL( ctxBefore.pendingMask, ctx.pendingMask );
+			CHECK_EQUAL( ctxBefore.previousCode, ctx.previousCode );
+
+			CHECK_EQUAL( ctxBefore.carryLen, ctx.carryLen );
+
+			if( s == 0 )
+			{
+				// Nothing was added, so the frame can still be ended
+				CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+				CHECK_EQUAL( DZRCOBS_FRAME_HEADER_SIZE + 1, encodedLen );
+			}
+
+			continue;
+		}
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+
+		std::vector<uint8_t> decoded( dataSize );
+
+		sDZRCOBS_decodectx decodeCtx;
+		decodeCtx.srcBufEncoded			= encoded.data();
+		decodeCtx.srcBufEncodedLen	= encodedLen;
+		decodeCtx.dstBufDecoded			= decoded.data();
+		decodeCtx.dstBufDecodedSize = decoded.size();
+		decodeCtx.pDict[0]					= &dictCtx;
+
+		size_t decodedLen			= 0;
+		uint8_t *decodedPos		= nullptr;
+		uint8_t user6bitsRead = 0;
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+		CHECK_EQUAL( dataSize, decodedLen );
+		CHECK_EQUAL( 0, memcmp( decodedData.data(), decodedPos, decodedLen ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeOverflowKeepsContext )
+// NOLINTEND
+{
+	// The destiny fits the frame of the first part only. Adding the second part
+	// overflows and leaves the context as before, so the frame still ends with
+	// the first part.
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	std::vector<uint8_t> decodedData;
+
+	for( size_t i = 0; i < 30; i++ )
+	{
+		static const uint8_t words[] = { 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x01, 0x01 };
+
+		decodedData.insert( decodedData.end(), std::begin( words ), std::end( words ) );
+		decodedData.insert( decodedData.end(), i % 12, (uint8_t)( 0x21 + i ) );
+	}
+
+	static constexpr size_t firstSize = 200;
+
+	CHECK( decodedData.size() > ( firstSize + 2 * DZRCOBS_ENCODE_LOOKAHEAD ) );
+
+	static const eDZRCOBS_encoding encodings[] = { DZRCOBS_PLAIN, DZRCOBS_USING_DICT_1 };
+
+	for( const eDZRCOBS_encoding encoding : encodings )
+	{
+		std::vector<uint8_t> reference( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( firstSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+		sDZRCOBS_ctx ctx;
+		size_t referenceLen = 0;
+
+		dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, encoding, reference.data(), reference.size() ) );
+		ctx.user6bits = TEST_USERBITS;
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData.data(), firstSize ) );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &referenceLen ) );
+
+		// The plain encoding needs its worst case free before each add
+		const size_t dstSize = ( encoding == DZRCOBS_PLAIN )
+														? ( DZRCOBS_MAX_ENCODED_SIZE( firstSize ) + DZRCOBS_FRAME_HEADER_SIZE )
+														: referenceLen;
+
+		std::vector<uint8_t> encoded( dstSize + UTEST_GUARD_SIZE, UTEST_GUARD_BYTE );
+		size_t encodedLen = 0;
+
+		dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, encoding, encoded.data(), dstSize ) );
+		ctx.user6bits = TEST_USERBITS;
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData.data(), firstSize ) );
+
+		const sDZRCOBS_ctx ctxBefore = ctx;
+
+		CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW,
+								 dzrcobs_encode_inc( &ctx, &decodedData[firstSize], decodedData.size() - firstSize ) );
+
+		POINTERS_EQUAL( ctxBefore.pCurDst, ctx.pCurDst );
+		CHECK_EQUAL( ctxBefore.crc, ctx.crc );
+		CHECK_EQUAL( ctxBefore.code, ctx.code );
+		CHECK_EQUAL( ctxBefore.pendingMask, ctx.pendingMask );
+		CHECK_EQUAL( ctxBefore.previousCode, ctx.previousCode );
+		CHECK_EQUAL( ctxBefore.carryLen, ctx.carryLen );
+		CHECK_EQUAL( 0, memcmp( ctxBefore.carry, ctx.carry, ctx.carryLen ) );
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+		CHECK_EQUAL( referenceLen, encodedLen );
+		CHECK_EQUAL( 0, memcmp( reference.data(), encoded.data(), encodedLen ) );
+
+		for( size_t i = 0; i < UTEST_GUARD_SIZE; i++ )
+		{
+			CHECK_EQUAL( UTEST_GUARD_BYTE, encoded[dstSize + i] );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeDictionaryExactRoom )
+// NOLINTEND
+{
+	// Words only, the frame is much smaller than DZRCOBS_MAX_ENCODED_SIZE
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static const uint8_t word[] = { 0x04, 0x00, 0x00, 0x00, 0x04 };
+
+	static constexpr size_t dataSize	= sizeof( word ) * 100;
+	static constexpr size_t chunkSize = 37;
+
+	std::vector<uint8_t> decodedData( dataSize );
+
+	for( size_t i = 0; i < dataSize; i++ )
+	{
+		decodedData[i] = word[i % sizeof( word )];
+	}
+
+	std::vector<uint8_t> expected( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( dataSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+	sDZRCOBS_ctx ctx;
+	size_t expectedLen = 0;
+
+	dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+							 dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, expected.data(), expected.size() ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData.data(), dataSize ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &expectedLen ) );
+
+	CHECK_COMPARE( expectedLen, <, DZRCOBS_MAX_ENCODED_SIZE( dataSize ) / 2 );
+
+	// A destiny of the frame size is enough, one byte less overflows
+	for( const size_t dstSize : { expectedLen, expectedLen - 1 } )
+	{
+		std::vector<uint8_t> encoded( dstSize + UTEST_GUARD_SIZE, UTEST_GUARD_BYTE );
+
+		size_t encodedLen = 0;
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encoded.data(), dstSize ) );
+		ctx.user6bits = TEST_USERBITS;
+
+		eDZRCOBS_ret ret = DZRCOBS_RET_SUCCESS;
+
+		for( size_t offset = 0; ( offset < dataSize ) && ( ret == DZRCOBS_RET_SUCCESS ); offset += chunkSize )
+		{
+			ret = dzrcobs_encode_inc( &ctx, decodedData.data() + offset, std::min( chunkSize, dataSize - offset ) );
+		}
+
+		if( ret == DZRCOBS_RET_SUCCESS )
+		{
+			ret = dzrcobs_encode_inc_end( &ctx, &encodedLen );
+		}
+
+		for( size_t i = 0; i < UTEST_GUARD_SIZE; i++ )
+		{
+			CHECK_EQUAL( UTEST_GUARD_BYTE, encoded[dstSize + i] );
+		}
+
+		if( dstSize < expectedLen )
+		{
+			CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, ret );
+			continue;
+		}
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( expectedLen, encodedLen );
+		CHECK_EQUAL( 0, memcmp( expected.data(), encoded.data(), encodedLen ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeChunkedMatchesWholeDictionary )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static constexpr size_t dataSize = 600;
+
+	std::vector<uint8_t> decodedData( dataSize );
+	for( size_t i = 0; i < dataSize; i++ )
+	{
+		// Small values, so it has zeros and dictionary words
+		decodedData[i] = (uint8_t)( rand() % 6 );
+	}
+
+	std::vector<uint8_t> encodedWhole( DZRCOBS_MAX_ENCODED_SIZE( dataSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+	std::vector<uint8_t> encodedChunked( encodedWhole.size() );
+
+	sDZRCOBS_ctx ctx;
+	size_t encodedWholeLen = 0;
+
+	dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+							 dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encodedWhole.data(), encodedWhole.size() ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData.data(), dataSize ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedWholeLen ) );
+
+	// Fixed chunk sizes (1 is byte by byte) and 0 for random chunk sizes
+	static const size_t chunkSizes[] = { 1, 2, 3, 4, 5, 7, 63, 64, 0 };
+
+	for( const size_t chunkSize : chunkSizes )
+	{
+		size_t encodedChunkedLen = 0;
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+								 dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encodedChunked.data(), encodedChunked.size() ) );
+		ctx.user6bits = TEST_USERBITS;
+
+		size_t pos = 0;
+		while( pos < dataSize )
+		{
+			size_t len = ( chunkSize > 0 ) ? chunkSize : (size_t)( ( rand() % 9 ) + 1 );
+			len				 = ( len < ( dataSize - pos ) ) ? len : ( dataSize - pos );
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData.data() + pos, len ) );
+			pos += len;
+		}
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedChunkedLen ) );
+
+		CHECK_EQUAL( encodedWholeLen, encodedChunkedLen );
+		CHECK_EQUAL( 0, memcmp( encodedWhole.data(), encodedChunked.data(), encodedWholeLen ) );
+	}
+}
+
+#if DZRCOBS_OPTIMAL_PARSING
+// Encodes a frame with DICT_1 on chunks of aChunkSize (0 for random sizes), 0 on error
+static size_t encode_with_parsing( const sDICT_ctx *aDictCtx,
+																	 const std::vector<uint8_t> &aData,
+																	 eDZRCOBS_parsing aParsing,
+																	 size_t aChunkSize,
+																	 std::vector<uint8_t> &aEncoded )
+{
+	sDZRCOBS_ctx ctx;
+	size_t encodedLen = 0;
+
+	aEncoded.assign( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( aData.size() ) + DZRCOBS_FRAME_HEADER_SIZE, 0 );
+
+	dzrcobs_encode_set_dictionary( &ctx, aDictCtx, DZRCOBS_USING_DICT_1 );
+
+	if( ( dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, aEncoded.data(), aEncoded.size() ) !=
+				DZRCOBS_RET_SUCCESS ) ||
+			( dzrcobs_encode_set_parsing( &ctx, aParsing ) != DZRCOBS_RET_SUCCESS ) )
+	{
+		return 0;
+	}
+
+	ctx.user6bits = TEST_USERBITS;
+
+	for( size_t pos = 0; pos < aData.size(); )
+	{
+		size_t len = ( aChunkSize > 0 ) ? aChunkSize : (size_t)( ( rand() % 30 ) + 1 );
+		len				 = ( len < ( aData.size() - pos ) ) ? len : ( aData.size() - pos );
+
+		if( dzrcobs_encode_inc( &ctx, aData.data() + pos, len ) != DZRCOBS_RET_SUCCESS )
+		{
+			return 0;
+		}
+
+		pos += len;
+	}
+
+	if( dzrcobs_encode_inc_end( &ctx, &encodedLen ) != DZRCOBS_RET_SUCCESS )
+	{
+		return 0;
+	}
+
+	return encodedLen;
+}
+
+// Decodes a DICT_1 frame and checks it against aData
+static bool decode_matches( const sDICT_ctx *aDictCtx,
+														std::vector<uint8_t> &aEncoded,
+														size_t aEncodedLen,
+														const std::vector<uint8_t> &aData )
+{
+	std::vector<uint8_t> decoded( aData.size() + 1 );
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= aEncoded.data();
+	decodeCtx.srcBufEncodedLen	= aEncodedLen;
+	decodeCtx.dstBufDecoded			= decoded.data();
+	decodeCtx.dstBufDecodedSize = decoded.size();
+	decodeCtx.pDict[0]					= aDictCtx;
+	decodeCtx.pDict[1]					= nullptr;
+
+	size_t decodedLen			= 0;
+	uint8_t *decodedPos		= nullptr;
+	uint8_t user6bitsRead = 0;
+
+	return ( dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) == DZRCOBS_RET_SUCCESS ) &&
+				 ( decodedLen == aData.size() ) && ( memcmp( aData.data(), decodedPos, decodedLen ) == 0 );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeOptimalParsing )
+// NOLINTEND
+{
+	// The greedy search takes "ab", then "cde" are literals that need a code
+	// before the next word. The optimal parsing takes "abcde".
+	static const char dictionary[] =
+		DICT_ADD_WORD(2, "ab")
+		DICT_ADD_WORD(3, "xyz")
+		DICT_ADD_WORD(4, "wxyz")
+		DICT_ADD_WORD(5, "abcde");
+
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, dictionary, sizeof( dictionary ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	std::vector<uint8_t> decodedData;
+
+	for( size_t i = 0; i < 10; i++ )
+	{
+		decodedData.insert( decodedData.end(), { 'a', 'b', 'c', 'd', 'e' } );
+	}
+
+	std::vector<uint8_t> encodedGreedy;
+	std::vector<uint8_t> encodedOptimal;
+
+	const size_t greedyLen	= encode_with_parsing( &dictCtx, decodedData, DZRCOBS_PARSING_GREEDY, 7, encodedGreedy );
+	const size_t optimalLen = encode_with_parsing( &dictCtx, decodedData, DZRCOBS_PARSING_OPTIMAL, 7, encodedOptimal );
+
+	// A byte for each word and the frame header
+	CHECK_EQUAL( 10 + DZRCOBS_FRAME_HEADER_SIZE, optimalLen );
+	CHECK_TRUE( greedyLen > optimalLen );
+
+	CHECK_TRUE( decode_matches( &dictCtx, encodedGreedy, greedyLen, decodedData ) );
+	CHECK_TRUE( decode_matches( &dictCtx, encodedOptimal, optimalLen, decodedData ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeOptimalChunkedMatchesWhole )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	// Around the optimal parsing window, and long enough for the jump codes
+	static const size_t dataSizes[] = { 0, 1, 5, DZRCOBS_OPTIMAL_WINDOW - 1, DZRCOBS_OPTIMAL_WINDOW, 100, 600 };
+
+	for( const size_t dataSize : dataSizes )
+	{
+		std::vector<uint8_t> decodedData( dataSize );
+
+		for( size_t i = 0; i < dataSize; i++ )
+		{
+			// Small values, so it has zeros and dictionary words
+			decodedData[i] = (uint8_t)( ( rand() % 4 ) ? ( rand() % 6 ) : ( 0x10 + ( rand() % 64 ) ) );
+		}
+
+		std::vector<uint8_t> encodedGreedy;
+		std::vector<uint8_t> encodedWhole;
+		std::vector<uint8_t> encodedChunked;
+
+		const size_t greedyLen = encode_with_parsing( &dictCtx, decodedData, DZRCOBS_PARSING_GREEDY, 0, encodedGreedy );
+		const size_t wholeLen	 = encode_with_parsing( &dictCtx, decodedData, DZRCOBS_PARSING_OPTIMAL, dataSize, encodedWhole );
+
+		CHECK_TRUE( wholeLen > 0 );
+		CHECK_TRUE( wholeLen <= greedyLen );
+		CHECK_TRUE( decode_matches( &dictCtx, encodedWhole, wholeLen, decodedData ) );
+
+		// Fixed chunk sizes (1 is byte by byte) and 0 for random chunk sizes
+		static const size_t chunkSizes[] = {
+			1, 2, 7, DZRCOBS_OPTIMAL_WINDOW - 1, DZRCOBS_OPTIMAL_WINDOW, DZRCOBS_OPTIMAL_WINDOW + 1, 64, 0
+		};
+
+		for( const size_t chunkSize : chunkSizes )
+		{
+			const size_t chunkedLen =
+			 encode_with_parsing( &dictCtx, decodedData, DZRCOBS_PARSING_OPTIMAL, chunkSize, encodedChunked );
+
+			CHECK_EQUAL( wholeLen, chunkedLen );
+			CHECK_EQUAL( 0, memcmp( encodedWhole.data(), encodedChunked.data(), wholeLen ) );
+		}
+	}
+}
+
+#endif
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeSetParsingInvalidArgs )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	sDZRCOBS_ctx ctx;
+	ctx.encFunc = nullptr;
+
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, dzrcobs_encode_set_parsing( nullptr, DZRCOBS_PARSING_OPTIMAL ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_NOTINITIALIZED, dzrcobs_encode_set_parsing( &ctx, DZRCOBS_PARSING_OPTIMAL ) );
+
+	dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+							 dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE ) );
+	ctx.user6bits = TEST_USERBITS;
+
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, dzrcobs_encode_set_parsing( &ctx, (eDZRCOBS_parsing)2 ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_set_parsing( &ctx, DZRCOBS_PARSING_GREEDY ) );
+
+	// Not after data was added
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, (const uint8_t *)"\x11", 1 ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, dzrcobs_encode_set_parsing( &ctx, DZRCOBS_PARSING_GREEDY ) );
+}
+
+#if !DZRCOBS_OPTIMAL_PARSING
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeSetParsingOptimalNotBuilt )
+// NOLINTEND
+{
+	// DZRCOBS_PARSING_OPTIMAL is rejected, and the frame is encoded greedy as if
+	// dzrcobs_encode_set_parsing was not called
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static const uint8_t decodedData[] = { 0x11, 0x01, 0x01, 0x02, 0x00, 0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x22 };
+
+	uint8_t reference[DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( sizeof( decodedData ) ) + DZRCOBS_FRAME_HEADER_SIZE];
+	uint8_t encoded[sizeof( reference )];
+
+	sDZRCOBS_ctx ctx;
+	size_t referenceLen = 0;
+	size_t encodedLen		= 0;
+
+	dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, reference, sizeof( reference ) ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData, sizeof( decodedData ) ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &referenceLen ) );
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, DZRCOBS_USING_DICT_1, encoded, sizeof( encoded ) ) );
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, dzrcobs_encode_set_parsing( &ctx, DZRCOBS_PARSING_OPTIMAL ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData, sizeof( decodedData ) ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	CHECK_EQUAL( referenceLen, encodedLen );
+	CHECK_EQUAL( 0, memcmp( reference, encoded, encodedLen ) );
+}
+#endif
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeBatch )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static constexpr size_t messagesCount	 = 200;
+	static constexpr size_t maxMessageSize = 130;
+
+	std::vector<std::vector<uint8_t>> messages( messagesCount );
+	std::vector<sDZRCOBS_batch_entry> entries( messagesCount );
+	size_t maxBatchSize = 0;
+
+	for( size_t i = 0; i < messagesCount; i++ )
+	{
+		// Includes empty messages and messages longer than a block
+		messages[i].resize( (size_t)rand() % maxMessageSize );
+
+		for( auto &byte : messages[i] )
+		{
+			byte = ( rand() & 1 ) ? (uint8_t)( rand() % 6 ) : (uint8_t)rand();
+		}
+
+		entries[i].pSrc			 = messages[i].data();
+		entries[i].srcLen		 = messages[i].size();
+		entries[i].user6bits = (uint8_t)( ( i % 63 ) + 1 );
+
+		maxBatchSize += DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( messages[i].size() ) + DZRCOBS_FRAME_HEADER_SIZE + 1;
+	}
+
+	std::vector<uint8_t> batch( maxBatchSize );
+	std::vector<size_t> offsets( messagesCount + 1 );
+	std::vector<uint8_t> single( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( maxMessageSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+	std::vector<uint8_t> decoded( maxMessageSize );
+
+	for( const eDZRCOBS_encoding encoding : { DZRCOBS_PLAIN, DZRCOBS_USING_DICT_1 } )
+	{
+		sDZRCOBS_ctx ctx;
+		size_t framesEncoded = 0;
+
+		dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+
+		eDZRCOBS_ret ret = dzrcobs_encode_batch(
+		 &ctx, encoding, entries.data(), messagesCount, batch.data(), batch.size(), offsets.data(), &framesEncoded );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( messagesCount, framesEncoded );
+		CHECK_EQUAL( 0, offsets[0] );
+
+		for( size_t i = 0; i < messagesCount; i++ )
+		{
+			const uint8_t *pFrame = batch.data() + offsets[i];
+			const size_t frameLen = offsets[i + 1] - offsets[i] - 1;
+
+			// The same bytes as a frame encoded alone, followed by the delimiter
+			size_t singleLen = 0;
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, encoding, single.data(), single.size() ) );
+			ctx.user6bits = entries[i].user6bits;
+			if( !messages[i].empty() )
+			{
+				CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, messages[i].data(), messages[i].size() ) );
+			}
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &singleLen ) );
+
+			CHECK_EQUAL( singleLen, frameLen );
+			CHECK_EQUAL( 0, memcmp( single.data(), pFrame, frameLen ) );
+			CHECK_EQUAL( 0x00, pFrame[frameLen] );
+			CHECK_EQUAL( frameLen, (size_t)( std::find( pFrame, pFrame + frameLen + 1, 0x00 ) - pFrame ) );
+
+			sDZRCOBS_decodectx decodeCtx;
+			decodeCtx.srcBufEncoded			= pFrame;
+			decodeCtx.srcBufEncodedLen	= frameLen;
+			decodeCtx.dstBufDecoded			= decoded.data();
+			decodeCtx.dstBufDecodedSize = decoded.size();
+			decodeCtx.pDict[0]					= &dictCtx;
+			decodeCtx.pDict[1]					= nullptr;
+
+			size_t decodedLen			= 0;
+			uint8_t *decodedPos		= nullptr;
+			uint8_t user6bitsRead = 0;
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+			CHECK_EQUAL( messages[i].size(), decodedLen );
+			CHECK_EQUAL( entries[i].user6bits, user6bitsRead );
+			CHECK_EQUAL( 0, memcmp( messages[i].data(), decodedPos, decodedLen ) );
+		}
+
+		// Not enough room: the frames before the failing one are complete
+		const size_t shortSize = offsets[messagesCount / 2] + 2;
+
+		ret = dzrcobs_encode_batch(
+		 &ctx, encoding, entries.data(), messagesCount, batch.data(), shortSize, offsets.data(), &framesEncoded );
+		CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, ret );
+		CHECK_EQUAL( messagesCount / 2, framesEncoded );
+		CHECK_COMPARE( offsets[framesEncoded], <=, shortSize );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeBatchInvalidArgs )
+// NOLINTEND
+{
+	sDZRCOBS_ctx ctx;
+	uint8_t buf[16];
+	size_t offsets[2];
+	size_t framesEncoded = 0;
+
+	static const uint8_t message[] = { 0x11, 0x00, 0x22 };
+	sDZRCOBS_batch_entry entry			 = { message, sizeof( message ), 1 };
+
+	ctx.pDict[0] = nullptr;
+	ctx.pDict[1] = nullptr;
+
+	eDZRCOBS_ret ret = dzrcobs_encode_batch( nullptr, DZRCOBS_PLAIN, &entry, 1, buf, sizeof( buf ), offsets, &framesEncoded );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	ret = dzrcobs_encode_batch( &ctx, DZRCOBS_PLAIN, &entry, 1, nullptr, sizeof( buf ), offsets, &framesEncoded );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	ret = dzrcobs_encode_batch( &ctx, DZRCOBS_PLAIN, &entry, 1, buf, sizeof( buf ), nullptr, &framesEncoded );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	ret = dzrcobs_encode_batch( &ctx, DZRCOBS_RESERVED, &entry, 1, buf, sizeof( buf ), offsets, &framesEncoded );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	ret = dzrcobs_encode_batch( &ctx, DZRCOBS_USING_DICT_1, &entry, 1, buf, sizeof( buf ), offsets, &framesEncoded );
+	CHECK_EQUAL_TEXT( DZRCOBS_RET_ERR_BAD_ARG, ret, "No dictionary set" );
+
+	entry.user6bits = 0;
+	ret = dzrcobs_encode_batch( &ctx, DZRCOBS_PLAIN, &entry, 1, buf, sizeof( buf ), offsets, &framesEncoded );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	entry.user6bits = 64;
+	ret = dzrcobs_encode_batch( &ctx, DZRCOBS_PLAIN, &entry, 1, buf, sizeof( buf ), offsets, &framesEncoded );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	entry.user6bits = 63;
+	ret = dzrcobs_encode_batch( &ctx, DZRCOBS_PLAIN, &entry, 1, buf, sizeof( buf ), offsets, &framesEncoded );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+	CHECK_EQUAL( 1, framesEncoded );
+
+	ret = dzrcobs_encode_batch( &ctx, DZRCOBS_PLAIN, nullptr, 0, buf, sizeof( buf ), offsets, &framesEncoded );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+	CHECK_EQUAL( 0, framesEncoded );
+	CHECK_EQUAL( 0, offsets[0] );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeBatch )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret dict_ret = dzrcobs_dictionary_init( &dictCtx, s_TEST_Dictionary1, s_TEST_Dictionary1_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dict_ret );
+
+	static constexpr size_t messagesCount	 = 100;
+	static constexpr size_t maxMessageSize = 130;
+	static constexpr size_t corruptedFrame = 37;
+
+	std::vector<std::vector<uint8_t>> messages( messagesCount );
+	std::vector<sDZRCOBS_batch_entry> entries( messagesCount );
+	size_t maxBatchSize = 0;
+	size_t decodedSize	= 0;
+
+	for( size_t i = 0; i < messagesCount; i++ )
+	{
+		messages[i].resize( (size_t)rand() % maxMessageSize );
+
+		for( auto &byte : messages[i] )
+		{
+			byte = ( rand() & 1 ) ? (uint8_t)( rand() % 6 ) : (uint8_t)rand();
+		}
+
+		entries[i].pSrc			 = messages[i].data();
+		entries[i].srcLen		 = messages[i].size();
+		entries[i].user6bits = (uint8_t)( ( i % 63 ) + 1 );
+
+		maxBatchSize += DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( messages[i].size() ) + DZRCOBS_FRAME_HEADER_SIZE + 1;
+		decodedSize += messages[i].size();
+	}
+
+	std::vector<uint8_t> batch( maxBatchSize );
+	std::vector<size_t> offsets( messagesCount + 1 );
+
+	sDZRCOBS_ctx ctx;
+	size_t framesEncoded = 0;
+
+	dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+							 dzrcobs_encode_batch( &ctx,
+																		 DZRCOBS_USING_DICT_1,
+																		 entries.data(),
+																		 messagesCount,
+																		 batch.data(),
+																		 batch.size(),
+																		 offsets.data(),
+																		 &framesEncoded ) );
+
+	// Stream: empty frames at the start, a corrupted frame, and a frame not complete at the end
+	std::vector<uint8_t> stream = { 0x00, 0x00 };
+
+	stream.insert( stream.end(), batch.begin(), batch.begin() + (std::ptrdiff_t)offsets[messagesCount] );
+	uint8_t &corruptedByte = stream[2 + offsets[corruptedFrame]];
+	corruptedByte ^= ( corruptedByte == 0x20 ) ? 0x01 : 0x20; // not a delimiter
+
+	const size_t completeSize = stream.size();
+
+	stream.insert( stream.end(), batch.begin(), batch.begin() + (std::ptrdiff_t)( offsets[1] - 1 ) );
+
+	std::vector<uint8_t> arena( decodedSize );
+	std::vector<sDZRCOBS_batch_result> results( messagesCount + 10 );
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= stream.data();
+	decodeCtx.srcBufEncodedLen	= stream.size();
+	decodeCtx.dstBufDecoded			= arena.data();
+	decodeCtx.dstBufDecodedSize = arena.size();
+	decodeCtx.pDict[0]					= &dictCtx;
+	decodeCtx.pDict[1]					= nullptr;
+
+	size_t resultsCount = 0;
+	size_t consumed			= 0;
+
+	eDZRCOBS_ret ret = dzrcobs_decode_batch( &decodeCtx, results.data(), results.size(), &resultsCount, &consumed );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+	CHECK_EQUAL( messagesCount, resultsCount );
+	CHECK_EQUAL( completeSize, consumed );
+
+	size_t arenaUsed = 0;
+
+	for( size_t i = 0; i < messagesCount; i++ )
+	{
+		CHECK_EQUAL( arenaUsed, results[i].offset );
+
+		if( i == corruptedFrame )
+		{
+			CHECK_EQUAL( DZRCOBS_RET_ERR_CRC, results[i].status );
+			CHECK_EQUAL( 0, results[i].length );
+			continue;
+		}
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, results[i].status );
+		CHECK_EQUAL( messages[i].size(), results[i].length );
+		CHECK_EQUAL( entries[i].user6bits, results[i].user6bits );
+		CHECK_EQUAL( 0, memcmp( messages[i].data(), arena.data() + results[i].offset, results[i].length ) );
+
+		arenaUsed += results[i].length;
+	}
+
+	// Results array smaller than the frames, the batch continues from consumed
+	size_t resultsTotal = 0;
+	size_t pos					= 0;
+
+	while( pos < completeSize )
+	{
+		decodeCtx.srcBufEncoded		 = stream.data() + pos;
+		decodeCtx.srcBufEncodedLen = stream.size() - pos;
+
+		ret = dzrcobs_decode_batch( &decodeCtx, results.data(), 7, &resultsCount, &consumed );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+		CHECK_COMPARE( resultsCount, <=, 7 );
+
+		for( size_t i = 0; i < resultsCount; i++ )
+		{
+			const size_t message = resultsTotal + i;
+
+			if( message != corruptedFrame )
+			{
+				CHECK_EQUAL( DZRCOBS_RET_SUCCESS, results[i].status );
+				CHECK_EQUAL( 0, memcmp( messages[message].data(), arena.data() + results[i].offset, results[i].length ) );
+			}
+		}
+
+		resultsTotal += resultsCount;
+		pos += consumed;
+	}
+
+	CHECK_EQUAL( messagesCount, resultsTotal );
+	CHECK_EQUAL( completeSize, pos );
+
+	// Arena too small: the frames that do not fit fail, the others are decoded
+	decodeCtx.srcBufEncoded			= stream.data();
+	decodeCtx.srcBufEncodedLen	= stream.size();
+	decodeCtx.dstBufDecodedSize = arena.size() / 2;
+
+	ret = dzrcobs_decode_batch( &decodeCtx, results.data(), results.size(), &resultsCount, &consumed );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+	CHECK_EQUAL( messagesCount, resultsCount );
+
+	arenaUsed						 = 0;
+	size_t overflowCount = 0;
+
+	for( size_t i = 0; i < messagesCount; i++ )
+	{
+		if( results[i].status == DZRCOBS_RET_ERR_OVERFLOW )
+		{
+			overflowCount++;
+		}
+		else if( i != corruptedFrame )
+		{
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, results[i].status );
+			CHECK_EQUAL( 0, memcmp( messages[i].data(), arena.data() + results[i].offset, results[i].length ) );
+		}
+
+		arenaUsed += results[i].length;
+	}
+
+	CHECK_COMPARE( arenaUsed, <=, decodeCtx.dstBufDecodedSize );
+	CHECK_COMPARE( overflowCount, >, 0 );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, DecodeBatchInvalidArgs )
+// NOLINTEND
+{
+	uint8_t frames[] = { 0x01, 0x00 };
+	uint8_t arena[4];
+	sDZRCOBS_batch_result results[2];
+	size_t resultsCount = 0;
+	size_t consumed			= 0;
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded			= frames;
+	decodeCtx.srcBufEncodedLen	= sizeof( frames );
+	decodeCtx.dstBufDecoded			= arena;
+	decodeCtx.dstBufDecodedSize = sizeof( arena );
+	decodeCtx.pDict[0]					= nullptr;
+	decodeCtx.pDict[1]					= nullptr;
+
+	eDZRCOBS_ret ret = dzrcobs_decode_batch( nullptr, results, 2, &resultsCount, &consumed );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	ret = dzrcobs_decode_batch( &decodeCtx, nullptr, 2, &resultsCount, &consumed );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	ret = dzrcobs_decode_batch( &decodeCtx, results, 2, nullptr, &consumed );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	ret = dzrcobs_decode_batch( &decodeCtx, results, 2, &resultsCount, nullptr );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+
+	// A frame too short to be valid
+	ret = dzrcobs_decode_batch( &decodeCtx, results, 2, &resultsCount, &consumed );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+	CHECK_EQUAL( 1, resultsCount );
+	CHECK_EQUAL( sizeof( frames ), consumed );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, results[0].status );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeAutoIsTheSmallest )
+// NOLINTEND
+{
+	static const char dictionaryText[] =
+		DICT_ADD_WORD(2, "ab")
+		DICT_ADD_WORD(3, "xyz")
+		DICT_ADD_WORD(4, "wxyz")
+		DICT_ADD_WORD(5, "abcde");
+
+	sDICT_ctx dictCtx[DZRCOBS_DICT_N];
+
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzrcobs_dictionary_init( &dictCtx[0], s_TEST_Dictionary1, s_TEST_Dictionary1_size ) );
+	CHECK_EQUAL( DICT_RET_SUCCESS, dzrcobs_dictionary_init( &dictCtx[1], dictionaryText, sizeof( dictionaryText ) ) );
+
+	static const size_t dataSizes[] = { 0, 1, 2, 61, 62, 63, 125, 126, 127, 252, 300, 1000 };
+
+	size_t takenCount[DZRCOBS_RESERVED] = {};
+
+	// Random (for DZRCOBS_PLAIN), small values (DICT_1), words of the second dictionary (DICT_2)
+	// and long runs without zeros. Own generator, so each kind always favours its encoding.
+	for( int kind = 0; kind < 4; kind++ )
+	{
+		std::minstd_rand random( (uint_fast32_t)( kind + 1 ) );
+
+		for( const size_t dataSize : dataSizes )
+		{
+			std::vector<uint8_t> decodedData( dataSize );
+
+			for( size_t i = 0; i < dataSize; i++ )
+			{
+				switch( kind )
+				{
+				case 0:
+					decodedData[i] = (uint8_t)( random() & 0xFF );
+					break;
+				case 1:
+					decodedData[i] = (uint8_t)( random() % 5 );
+					break;
+				case 2:
+					decodedData[i] = (uint8_t)"abcde\0wxyz\0"[i % 11];
+					break;
+				default:
+					decodedData[i] = (uint8_t)( ( random() % 16 ) + 'a' );
+					break;
+				}
+			}
+
+			sDZRCOBS_ctx ctx;
+			ctx.pDict[0]	= &dictCtx[0];
+			ctx.pDict[1]	= &dictCtx[1];
+			ctx.user6bits = TEST_USERBITS;
+
+			// Each encoding on its own, as a batch of one frame
+			const sDZRCOBS_batch_entry entry = { decodedData.data(), dataSize, TEST_USERBITS };
+
+			std::vector<uint8_t> encodedEach[DZRCOBS_RESERVED];
+			size_t encodedEachLen[DZRCOBS_RESERVED];
+			eDZRCOBS_encoding smallest = DZRCOBS_PLAIN;
+
+			for( int encoding = DZRCOBS_PLAIN; encoding < DZRCOBS_RESERVED; encoding++ )
+			{
+				size_t offsets[2];
+				size_t framesEncoded = 0;
+
+				encodedEach[encoding].assign( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( dataSize ) + DZRCOBS_FRAME_HEADER_SIZE + 1, 0 );
+
+				CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+										 dzrcobs_encode_batch( &ctx,
+																					 (eDZRCOBS_encoding)encoding,
+																					 &entry,
+																					 1,
+																					 encodedEach[encoding].data(),
+																					 encodedEach[encoding].size(),
+																					 offsets,
+																					 &framesEncoded ) );
+
+				encodedEachLen[encoding] = offsets[1] - 1;
+
+				if( encodedEachLen[encoding] < encodedEachLen[smallest] )
+				{
+					smallest = (eDZRCOBS_encoding)encoding;
+				}
+			}
+
+			// The plain worst case is enough
+			std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE( dataSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+			size_t encodedLen						= 0;
+			eDZRCOBS_encoding encoding = DZRCOBS_RESERVED;
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+									 dzrcobs_encode_auto(
+										&ctx, decodedData.data(), dataSize, encoded.data(), encoded.size(), &encodedLen, &encoding ) );
+
+			CHECK_EQUAL( smallest, encoding );
+			CHECK_EQUAL( encodedEachLen[smallest], encodedLen );
+			takenCount[encoding]++;
+			CHECK_EQUAL( 0, memcmp( encodedEach[smallest].data(), encoded.data(), encodedLen ) );
+			CHECK_EQUAL( (uint8_t)( ( TEST_USERBITS << 2 ) | encoding ), encoded[encodedLen - 2] );
+
+			std::vector<uint8_t> decoded( dataSize + 1 );
+
+			sDZRCOBS_decodectx decodeCtx;
+			decodeCtx.srcBufEncoded			= encoded.data();
+			decodeCtx.srcBufEncodedLen	= encodedLen;
+			decodeCtx.dstBufDecoded			= decoded.data();
+			decodeCtx.dstBufDecodedSize = decoded.size();
+			decodeCtx.pDict[0]					= &dictCtx[0];
+			decodeCtx.pDict[1]					= &dictCtx[1];
+
+			size_t decodedLen			= 0;
+			uint8_t *decodedPos		= nullptr;
+			uint8_t user6bitsRead = 0;
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+			CHECK_EQUAL( dataSize, decodedLen );
+			CHECK_EQUAL( TEST_USERBITS, user6bitsRead );
+			CHECK_EQUAL( 0, memcmp( decodedData.data(), decodedPos, decodedLen ) );
+		}
+	}
+
+	for( const size_t count : takenCount )
+	{
+		CHECK_TRUE( count > 0 );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeAutoWithoutDictionary )
+// NOLINTEND
+{
+	uint8_t decodedData[300];
+
+	for( size_t i = 0; i < sizeof( decodedData ); i++ )
+	{
+		decodedData[i] = (uint8_t)( i % 3 );
+	}
+
+	sDZRCOBS_ctx ctx;
+	ctx.pDict[0]	= nullptr;
+	ctx.pDict[1]	= nullptr;
+	ctx.user6bits = TEST_USERBITS;
+
+	size_t encodedLen						= 0;
+	eDZRCOBS_encoding encoding = DZRCOBS_RESERVED;
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+							 dzrcobs_encode_auto( &ctx,
+																		decodedData,
+																		sizeof( decodedData ),
+																		buffer,
+																		UTEST_ENCODED_DECODED_DATA_MAX_SIZE,
+																		&encodedLen,
+																		&encoding ) );
+
+	CHECK_EQUAL( DZRCOBS_PLAIN, encoding );
+
+	uint8_t reference[DZRCOBS_MAX_ENCODED_SIZE( sizeof( decodedData ) ) + DZRCOBS_FRAME_HEADER_SIZE];
+	const size_t referenceLen = reference_encode_plain( decodedData, sizeof( decodedData ), TEST_USERBITS, reference );
+
+	CHECK_EQUAL( referenceLen, encodedLen );
+	CHECK_EQUAL( 0, memcmp( reference, buffer, encodedLen ) );
+
+	// No dzrcobs_encode_inc on it
+	CHECK_EQUAL( DZRCOBS_RET_ERR_NOTINITIALIZED, dzrcobs_encode_inc( &ctx, decodedData, 1 ) );
+
+	// A frame that does not fit
+	CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW,
+							 dzrcobs_encode_auto(
+								&ctx, decodedData, sizeof( decodedData ), buffer, referenceLen - 1, &encodedLen, &encoding ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS, EncodeAutoInvalidArgs )
+// NOLINTEND
+{
+	const uint8_t data[] = { 0x01, 0x02 };
+
+	sDZRCOBS_ctx ctx;
+	ctx.pDict[0]	= nullptr;
+	ctx.pDict[1]	= nullptr;
+	ctx.user6bits = TEST_USERBITS;
+
+	size_t encodedLen						= 0;
+	eDZRCOBS_encoding encoding = DZRCOBS_PLAIN;
+
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_encode_auto( nullptr, data, sizeof( data ), buffer, 16, &encodedLen, &encoding ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_encode_auto( &ctx, nullptr, sizeof( data ), buffer, 16, &encodedLen, &encoding ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_encode_auto( &ctx, data, sizeof( data ), nullptr, 16, &encodedLen, &encoding ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, dzrcobs_encode_auto( &ctx, data, sizeof( data ), buffer, 16, nullptr, &encoding ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_encode_auto( &ctx, data, sizeof( data ), buffer, 16, &encodedLen, nullptr ) );
+
+	ctx.user6bits = 0;
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_encode_auto( &ctx, data, sizeof( data ), buffer, 16, &encodedLen, &encoding ) );
+
+	ctx.user6bits = 64;
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_encode_auto( &ctx, data, sizeof( data ), buffer, 16, &encodedLen, &encoding ) );
+
+	// An empty frame
+	ctx.user6bits = TEST_USERBITS;
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_auto( &ctx, nullptr, 0, buffer, 16, &encodedLen, &encoding ) );
+	CHECK_EQUAL( 1 + DZRCOBS_FRAME_HEADER_SIZE, encodedLen );
+}
+
 // EOF
 // /////////////////////////////////////////////////////////////////////////////
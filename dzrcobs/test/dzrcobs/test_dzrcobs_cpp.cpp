@@ -0,0 +1,318 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_dzrcobs_cpp.cpp
+///	@brief Tests the C++ encoder and decoder against the C API
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_cpp.h>
+#include <dzrcobs/dzrcobs_decode.h>
+#include <vector>
+#include "test_dictionary_words_generated.h"
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define TEST_USERBITS ( 0x2A )
+
+// Default dictionary, set by dzrcobs_dictionary_init on the test setup
+static sDICT_ctx s_TEST_DefaultDictCtx;
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZRCOBS_CPP ){
+	void setup()
+	{
+		eDICT_ret ret = dzrcobs_dictionary_init( &s_TEST_DefaultDictCtx, G_DZRCOBS_DefaultDictionary, G_DZRCOBS_DefaultDictionary_size );
+		CHECK_EQUAL( DICT_RET_SUCCESS, ret );
+	}
+
+	void teardown()
+	{
+	}
+};
+// NOLINTEND
+// clang-format on
+
+// Encodes a whole frame with the C API, DICT_1 is the default dictionary and
+// DICT_2 the generated one
+static std::vector<uint8_t> c_encode( eDZRCOBS_encoding aEncoding,
+																			eDZRCOBS_parsing aParsing,
+																			const std::vector<uint8_t> &aData )
+{
+	std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( aData.size() ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+	sDZRCOBS_ctx ctx;
+	size_t encodedLen = 0;
+
+	ctx.pDict[0] = &s_TEST_DefaultDictCtx;
+	ctx.pDict[1] = &G_TEST_DictionaryWordsCtx;
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, aEncoding, encoded.data(), encoded.size() ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_set_parsing( &ctx, aParsing ) );
+	ctx.user6bits = TEST_USERBITS;
+
+	if( !aData.empty() )
+	{
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, aData.data(), aData.size() ) );
+	}
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+	encoded.resize( encodedLen );
+
+	return encoded;
+}
+
+// Data with zeros, text and words of both dictionaries
+static std::vector<uint8_t> random_data( size_t aSize )
+{
+	static const char *pieces[] = { "the ", "hello", "temp", "cat", "\r\n", "done" };
+
+	std::vector<uint8_t> data;
+
+	while( data.size() < aSize )
+	{
+		const int kind = rand() % 4;
+
+		if( kind == 0 )
+		{
+			const char *piece = pieces[(size_t)rand() % ( sizeof( pieces ) / sizeof( pieces[0] ) )];
+			data.insert( data.end(), piece, piece + strlen( piece ) );
+		}
+		else if( kind == 1 )
+		{
+			data.push_back( 0x00 );
+		}
+		else
+		{
+			data.push_back( (uint8_t)rand() );
+		}
+	}
+
+	data.resize( aSize );
+
+	return data;
+}
+
+// Encodes with the C++ encoder, on random chunks, and checks it against the C API
+template <eDZRCOBS_encoding Encoding, const sDICT_ctx *Dict> static void check_encoder( eDZRCOBS_parsing aParsing )
+{
+	dzrcobs::Encoder<Encoding, Dict> encoder;
+
+	for( size_t dataSize = 0; dataSize < 400; dataSize += 7 )
+	{
+		const std::vector<uint8_t> data			= random_data( dataSize );
+		const std::vector<uint8_t> expected = c_encode( Encoding, aParsing, data );
+
+		std::vector<uint8_t> encoded( encoder.max_encoded_size( dataSize ) );
+		size_t encodedLen = 0;
+
+		// Whole frame
+		if( aParsing == DZRCOBS_PARSING_GREEDY )
+		{
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, encoder.encode( data, encoded, TEST_USERBITS, encodedLen ) );
+			CHECK_EQUAL( expected.size(), encodedLen );
+			MEMCMP_EQUAL( expected.data(), encoded.data(), encodedLen );
+		}
+
+		// Chunks, through the C context for the parsing
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, encoder.begin( encoded, TEST_USERBITS ) );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_set_parsing( &encoder.ctx(), aParsing ) );
+
+		for( size_t pos = 0; pos < dataSize; )
+		{
+			size_t len = (size_t)( rand() % 40 );
+			len				 = ( len < ( dataSize - pos ) ) ? len : ( dataSize - pos );
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, encoder.add( dzrcobs::span<const uint8_t>( data.data() + pos, len ) ) );
+
+			pos += len;
+		}
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, encoder.end( encodedLen ) );
+		CHECK_EQUAL( expected.size(), encodedLen );
+		MEMCMP_EQUAL( expected.data(), encoded.data(), encodedLen );
+	}
+}
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CPP, EncoderMatchesC )
+// NOLINTEND
+{
+	check_encoder<DZRCOBS_PLAIN, nullptr>( DZRCOBS_PARSING_GREEDY );
+	check_encoder<DZRCOBS_USING_DICT_1, &s_TEST_DefaultDictCtx>( DZRCOBS_PARSING_GREEDY );
+#if DZRCOBS_OPTIMAL_PARSING
+	check_encoder<DZRCOBS_USING_DICT_1, &s_TEST_DefaultDictCtx>( DZRCOBS_PARSING_OPTIMAL );
+#endif
+	check_encoder<DZRCOBS_USING_DICT_2, &G_TEST_DictionaryWordsCtx>( DZRCOBS_PARSING_GREEDY );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CPP, DecoderRoundTrip )
+// NOLINTEND
+{
+	dzrcobs::Encoder<DZRCOBS_PLAIN> plainEncoder;
+	dzrcobs::Encoder<DZRCOBS_USING_DICT_1, &s_TEST_DefaultDictCtx> dict1Encoder;
+	dzrcobs::Encoder<DZRCOBS_USING_DICT_2, &G_TEST_DictionaryWordsCtx> dict2Encoder;
+
+	dzrcobs::Decoder decoder( &s_TEST_DefaultDictCtx, &G_TEST_DictionaryWordsCtx );
+
+	for( size_t dataSize = 1; dataSize < 300; dataSize += 3 )
+	{
+		const std::vector<uint8_t> data = random_data( dataSize );
+
+		std::vector<uint8_t> encoded( dzrcobs::Encoder<DZRCOBS_USING_DICT_1, &s_TEST_DefaultDictCtx>::max_encoded_size( dataSize ) );
+		std::vector<uint8_t> decoded( dataSize + 8 );
+
+		for( int encoding = 0; encoding < 3; encoding++ )
+		{
+			size_t encodedLen = 0;
+			eDZRCOBS_ret ret	= DZRCOBS_RET_ERR_BAD_ARG;
+
+			ret = ( encoding == 0 ) ? plainEncoder.encode( data, encoded, TEST_USERBITS, encodedLen )
+						: ( encoding == 1 ) ? dict1Encoder.encode( data, encoded, TEST_USERBITS, encodedLen )
+																: dict2Encoder.encode( data, encoded, TEST_USERBITS, encodedLen );
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+
+			const dzrcobs::span<const uint8_t> frame( encoded.data(), encodedLen );
+			dzrcobs::span<uint8_t> out;
+			uint8_t user6bits = 0;
+
+			// Right aligned
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, decoder.decode( frame, decoded, out, user6bits ) );
+			CHECK_EQUAL( TEST_USERBITS, user6bits );
+			CHECK_EQUAL( dataSize, out.size() );
+			CHECK_TRUE( out.end() == ( decoded.data() + decoded.size() ) );
+			MEMCMP_EQUAL( data.data(), out.data(), dataSize );
+
+			// Left aligned
+			user6bits = 0;
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, decoder.decode_left_aligned( frame, decoded, out, user6bits ) );
+			CHECK_EQUAL( TEST_USERBITS, user6bits );
+			CHECK_EQUAL( dataSize, out.size() );
+			CHECK_TRUE( out.data() == decoded.data() );
+			MEMCMP_EQUAL( data.data(), out.data(), dataSize );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CPP, InvalidArgs )
+// NOLINTEND
+{
+	dzrcobs::Encoder<DZRCOBS_PLAIN> plainEncoder;
+	dzrcobs::Encoder<DZRCOBS_USING_DICT_1, &s_TEST_DefaultDictCtx> dictEncoder;
+
+	const std::array<uint8_t, 4> data = { 0x01, 0x02, 0x00, 0x03 };
+	std::array<uint8_t, 16> encoded		= {};
+	size_t encodedLen									= 0;
+
+	// User bits
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, plainEncoder.begin( encoded, 0 ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, plainEncoder.begin( encoded, 64 ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, dictEncoder.begin( encoded, 64 ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dictEncoder.begin( encoded, 0 ) );
+
+	// Destiny
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, plainEncoder.begin( dzrcobs::span<uint8_t>( encoded.data(), 1 ), 1 ) );
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, plainEncoder.begin( dzrcobs::span<uint8_t>( encoded.data(), 6 ), 1 ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, plainEncoder.add( data ) );
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, plainEncoder.begin( dzrcobs::span<uint8_t>( encoded.data(), 7 ), 1 ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, plainEncoder.add( data ) );
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, plainEncoder.end( encodedLen ) );
+	CHECK_EQUAL( 7, encodedLen );
+
+	// Decoder without the dictionary of the frame
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dictEncoder.encode( data, encoded, 1, encodedLen ) );
+
+	dzrcobs::Decoder decoder;
+	std::array<uint8_t, 16> decoded = {};
+	dzrcobs::span<uint8_t> out;
+	uint8_t user6bits = 0;
+
+	CHECK_EQUAL( DZRCOBS_RET_ERR_NO_DICTIONARY_TO_DECODE,
+							 decoder.decode( dzrcobs::span<const uint8_t>( encoded.data(), encodedLen ), decoded, out, user6bits ) );
+	CHECK_TRUE( out.empty() );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_CPP, EncoderDictionaryExactRoom )
+// NOLINTEND
+{
+	dzrcobs::Encoder<DZRCOBS_USING_DICT_2, &G_TEST_DictionaryWordsCtx> encoder;
+
+	// Words only, much smaller than DZRCOBS_MAX_ENCODED_SIZE
+	std::vector<uint8_t> data;
+
+	while( data.size() < 400 )
+	{
+		data.insert( data.end(), { 'd', 'o', 'n', 'e', 'c', 'a', 't' } );
+	}
+
+	const std::vector<uint8_t> expected = c_encode( DZRCOBS_USING_DICT_2, DZRCOBS_PARSING_GREEDY, data );
+
+	CHECK_COMPARE( expected.size(), <, DZRCOBS_MAX_ENCODED_SIZE( data.size() ) / 2 );
+
+	// A destiny of the frame size is enough, one byte less overflows
+	for( const size_t dstSize : { expected.size(), expected.size() - 1 } )
+	{
+		std::vector<uint8_t> encoded( dstSize );
+		size_t encodedLen = 0;
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, encoder.begin( encoded, TEST_USERBITS ) );
+
+		eDZRCOBS_ret ret = DZRCOBS_RET_SUCCESS;
+
+		for( size_t offset = 0; ( offset < data.size() ) && ( ret == DZRCOBS_RET_SUCCESS ); offset += 50 )
+		{
+			ret = encoder.add( dzrcobs::span<const uint8_t>( data.data() + offset, std::min<size_t>( 50, data.size() - offset ) ) );
+		}
+
+		if( ret == DZRCOBS_RET_SUCCESS )
+		{
+			ret = encoder.end( encodedLen );
+		}
+
+		if( dstSize < expected.size() )
+		{
+			CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, ret );
+			continue;
+		}
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( expected.size(), encodedLen );
+		CHECK_EQUAL( 0, memcmp( expected.data(), encoded.data(), encodedLen ) );
+	}
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,335 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_framer.cpp
+///	@brief Tests for the stream frame splitter
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_decode.h>
+#include <dzrcobs/dzrcobs_framer.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_FRAMER_BUFFER_SIZE ( 16 )
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZRCOBS_FRAMER ){
+	void setup()
+	{
+		memset( buffer, 0xA5, sizeof( buffer ) );
+		CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_init( &framer, buffer, sizeof( buffer ) ) );
+	}
+
+	void teardown()
+	{
+	}
+
+	uint8_t buffer[UTEST_FRAMER_BUFFER_SIZE];
+	sDZRCOBS_framer framer;
+};
+// NOLINTEND
+// clang-format on
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZRCOBS_FRAMER, InvalidArgs )
+// NOLINTEND
+{
+	sDZRCOBS_framer other;
+	const uint8_t *frame = nullptr;
+	size_t frameLen			 = 0;
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_BAD_ARG, dzrcobs_framer_init( nullptr, buffer, sizeof( buffer ) ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_BAD_ARG, dzrcobs_framer_init( &other, nullptr, sizeof( buffer ) ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_BAD_ARG, dzrcobs_framer_init( &other, buffer, 0 ) );
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_BAD_ARG, dzrcobs_framer_feed( nullptr, buffer, 1 ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_BAD_ARG, dzrcobs_framer_feed( &framer, nullptr, 1 ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, nullptr, 0 ) );
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_BAD_ARG, dzrcobs_framer_pop( nullptr, &frame, &frameLen ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_BAD_ARG, dzrcobs_framer_pop( &framer, nullptr, &frameLen ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_BAD_ARG, dzrcobs_framer_pop( &framer, &frame, nullptr ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_FRAMER, FeedBusy )
+// NOLINTEND
+{
+	const uint8_t chunk[] = { 0x00, 0x01, 0x02, 0x00 };
+	const uint8_t *frame	= nullptr;
+	size_t frameLen				= 0;
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, chunk, sizeof( chunk ) ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_BUSY, dzrcobs_framer_feed( &framer, chunk, sizeof( chunk ) ) );
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_FRAME, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, chunk, sizeof( chunk ) ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_FRAMER, ZeroCopyFramesInChunk )
+// NOLINTEND
+{
+	const uint8_t chunk[] = { 0x00, 0x11, 0x12, 0x13, 0x00, 0x00, 0x00, 0x21, 0x22, 0x00 };
+	const uint8_t *frame	= nullptr;
+	size_t frameLen				= 0;
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, chunk, sizeof( chunk ) ) );
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_FRAME, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+	CHECK_EQUAL( 3, frameLen );
+	POINTERS_EQUAL( chunk + 1, frame );
+
+	// Empty frames are skipped
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_FRAME, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+	CHECK_EQUAL( 2, frameLen );
+	POINTERS_EQUAL( chunk + 7, frame );
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_FRAMER, FrameSplitAcrossChunks )
+// NOLINTEND
+{
+	const uint8_t stream[] = { 0x11, 0x12, 0x13, 0x14, 0x15, 0x00, 0x21, 0x00 };
+	const uint8_t *frame	 = nullptr;
+	size_t frameLen				 = 0;
+	size_t framesCount		 = 0;
+
+	// One byte at a time
+	for( size_t i = 0; i < sizeof( stream ); i++ )
+	{
+		CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, stream + i, 1 ) );
+
+		eDZRCOBS_framer_ret ret;
+
+		while( ( ret = dzrcobs_framer_pop( &framer, &frame, &frameLen ) ) == DZRCOBS_FRAMER_RET_FRAME )
+		{
+			if( framesCount == 0 )
+			{
+				CHECK_EQUAL( 5, frameLen );
+				CHECK_EQUAL( 0, memcmp( stream, frame, frameLen ) );
+				CHECK_EQUAL( 5, i );
+			}
+			else
+			{
+				CHECK_EQUAL( 1, frameLen );
+				CHECK_EQUAL( 0x21, frame[0] );
+				CHECK_EQUAL( 7, i );
+			}
+
+			POINTERS_EQUAL( buffer, frame );
+			framesCount++;
+		}
+
+		CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, ret );
+	}
+
+	CHECK_EQUAL( 2, framesCount );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_FRAMER, OversizeFrameIsDropped )
+// NOLINTEND
+{
+	uint8_t chunk[UTEST_FRAMER_BUFFER_SIZE * 3];
+	const uint8_t *frame = nullptr;
+	size_t frameLen			 = 0;
+
+	// Oversize frame inside the chunk, followed by a good one
+	memset( chunk, 0x33, sizeof( chunk ) );
+	chunk[UTEST_FRAMER_BUFFER_SIZE + 1] = 0x00;
+	chunk[UTEST_FRAMER_BUFFER_SIZE + 4] = 0x00;
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, chunk, UTEST_FRAMER_BUFFER_SIZE + 5 ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_ERR_OVERSIZE, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_FRAME, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+	CHECK_EQUAL( 2, frameLen );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+
+	// A frame of exactly the buffer size, split, is accepted
+	memset( chunk, 0x44, sizeof( chunk ) );
+	chunk[UTEST_FRAMER_BUFFER_SIZE] = 0x00;
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, chunk, 3 ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, chunk + 3, UTEST_FRAMER_BUFFER_SIZE - 2 ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_FRAME, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+	CHECK_EQUAL( UTEST_FRAMER_BUFFER_SIZE, frameLen );
+	POINTERS_EQUAL( buffer, frame );
+
+	// Oversize frame spread on many chunks is reported once
+	memset( chunk, 0x55, sizeof( chunk ) );
+	chunk[sizeof( chunk ) - 3] = 0x00;
+
+	size_t oversizeCount = 0;
+	size_t framesCount	 = 0;
+
+	for( size_t i = 0; i < sizeof( chunk ); i += 5 )
+	{
+		const size_t len = ( sizeof( chunk ) - i ) < 5 ? ( sizeof( chunk ) - i ) : 5;
+
+		CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, chunk + i, len ) );
+
+		eDZRCOBS_framer_ret ret;
+
+		while( ( ret = dzrcobs_framer_pop( &framer, &frame, &frameLen ) ) != DZRCOBS_FRAMER_RET_NEED_DATA )
+		{
+			oversizeCount += ( ret == DZRCOBS_FRAMER_RET_ERR_OVERSIZE ) ? 1 : 0;
+			framesCount += ( ret == DZRCOBS_FRAMER_RET_FRAME ) ? 1 : 0;
+		}
+	}
+
+	CHECK_EQUAL( 1, oversizeCount );
+	CHECK_EQUAL( 0, framesCount );
+
+	// The trailing bytes are the start of the next frame
+	const uint8_t end = 0x00;
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, &end, 1 ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_FRAME, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+	CHECK_EQUAL( 2, frameLen );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_FRAMER, Resync )
+// NOLINTEND
+{
+	const uint8_t partial[] = { 0x11, 0x12 };
+	const uint8_t chunk[]		= { 0x13, 0x14, 0x00, 0x21, 0x00 };
+	const uint8_t *frame		= nullptr;
+	size_t frameLen					= 0;
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, partial, sizeof( partial ) ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+
+	dzrcobs_framer_resync( &framer );
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &framer, chunk, sizeof( chunk ) ) );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_FRAME, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+	CHECK_EQUAL( 1, frameLen );
+	POINTERS_EQUAL( chunk + 3, frame );
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_pop( &framer, &frame, &frameLen ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_FRAMER, EncodedStreamRandomChunks )
+// NOLINTEND
+{
+	static constexpr size_t framesCount		 = 64;
+	static constexpr size_t maxDecodedSize = 300;
+	static constexpr uint8_t userBits			 = 0x2A;
+
+	std::vector<std::vector<uint8_t>> decodedFrames;
+	std::vector<uint8_t> stream;
+
+	for( size_t f = 0; f < framesCount; f++ )
+	{
+		std::vector<uint8_t> decoded( 1 + ( (size_t)rand() % maxDecodedSize ) );
+
+		for( auto &byte : decoded )
+		{
+			// Plenty of zeros, so frames have many codes
+			byte = ( rand() & 3 ) ? (uint8_t)rand() : 0;
+		}
+
+		std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE( decoded.size() ) + DZRCOBS_FRAME_HEADER_SIZE );
+
+		sDZRCOBS_ctx ctx;
+		size_t encodedLen = 0;
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, DZRCOBS_PLAIN, encoded.data(), encoded.size() ) );
+		ctx.user6bits = userBits;
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decoded.data(), decoded.size() ) );
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+		stream.insert( stream.end(), encoded.begin(), encoded.begin() + (std::ptrdiff_t)encodedLen );
+		stream.push_back( 0x00 );
+
+		decodedFrames.push_back( decoded );
+	}
+
+	std::vector<uint8_t> frameBuffer( DZRCOBS_MAX_ENCODED_SIZE( maxDecodedSize ) + DZRCOBS_FRAME_HEADER_SIZE );
+	std::vector<uint8_t> decodeBuffer( maxDecodedSize );
+
+	sDZRCOBS_framer streamFramer;
+
+	CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA,
+							 dzrcobs_framer_init( &streamFramer, frameBuffer.data(), frameBuffer.size() ) );
+
+	size_t framesReceived = 0;
+	size_t pos						= 0;
+
+	while( pos < stream.size() )
+	{
+		const size_t chunkLen = std::min( stream.size() - pos, 1 + ( (size_t)rand() % 700 ) );
+
+		CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, dzrcobs_framer_feed( &streamFramer, stream.data() + pos, chunkLen ) );
+		pos += chunkLen;
+
+		const uint8_t *frame = nullptr;
+		size_t frameLen			 = 0;
+		eDZRCOBS_framer_ret ret;
+
+		while( ( ret = dzrcobs_framer_pop( &streamFramer, &frame, &frameLen ) ) == DZRCOBS_FRAMER_RET_FRAME )
+		{
+			CHECK_COMPARE( framesReceived, <, framesCount );
+
+			sDZRCOBS_decodectx decodeCtx;
+			decodeCtx.srcBufEncoded			= frame;
+			decodeCtx.srcBufEncodedLen	= frameLen;
+			decodeCtx.dstBufDecoded			= decodeBuffer.data();
+			decodeCtx.dstBufDecodedSize = decodeBuffer.size();
+
+			size_t decodedLen			= 0;
+			uint8_t *decodedPos		= nullptr;
+			uint8_t user6bitsRead = 0;
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_decode( &decodeCtx, &decodedLen, &decodedPos, &user6bitsRead ) );
+			CHECK_EQUAL( userBits, user6bitsRead );
+			CHECK_EQUAL( decodedFrames[framesReceived].size(), decodedLen );
+			CHECK_EQUAL( 0, memcmp( decodedFrames[framesReceived].data(), decodedPos, decodedLen ) );
+
+			framesReceived++;
+		}
+
+		CHECK_EQUAL( DZRCOBS_FRAMER_RET_NEED_DATA, ret );
+	}
+
+	CHECK_EQUAL( framesCount, framesReceived );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <dzrcobs/rcobs.h>
 
 // Definitions
@@ -223,29 +224,248 @@ TEST( RCOBS, DecodeInvalidPayload )
 	size_t decodedLen		= 0;
 	uint8_t *decodedPos = nullptr;
 
+	// A separate destiny, in-place one that ends before the frame is rejected
+	uint8_t decoded[2];
+
 	buffer[UTEST_GUARD_SIZE + 0] = 0;
 	buffer[UTEST_GUARD_SIZE + 1] = 0;
-	ret = rcobs_decode( buffer + UTEST_GUARD_SIZE, 2, buffer + UTEST_GUARD_SIZE, 1, &decodedLen, &decodedPos );
+	ret = rcobs_decode( buffer + UTEST_GUARD_SIZE, 2, decoded, 1, &decodedLen, &decodedPos );
 	CHECK_EQUAL( RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, ret );
 
 	buffer[UTEST_GUARD_SIZE + 0] = 0;
 	buffer[UTEST_GUARD_SIZE + 1] = 1;
-	ret = rcobs_decode( buffer + UTEST_GUARD_SIZE, 2, buffer + UTEST_GUARD_SIZE, 1, &decodedLen, &decodedPos );
+	ret = rcobs_decode( buffer + UTEST_GUARD_SIZE, 2, decoded, 1, &decodedLen, &decodedPos );
 	CHECK_EQUAL( RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, ret );
 
 	buffer[UTEST_GUARD_SIZE + 0] = 0;
 	buffer[UTEST_GUARD_SIZE + 1] = 1;
 	buffer[UTEST_GUARD_SIZE + 2] = 3;
-	ret = rcobs_decode( buffer + UTEST_GUARD_SIZE, 3, buffer + UTEST_GUARD_SIZE, 2, &decodedLen, &decodedPos );
+	ret = rcobs_decode( buffer + UTEST_GUARD_SIZE, 3, decoded, 2, &decodedLen, &decodedPos );
 	CHECK_EQUAL( RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, ret );
 
 	buffer[UTEST_GUARD_SIZE + 0] = 1;
 	buffer[UTEST_GUARD_SIZE + 1] = 1;
 	buffer[UTEST_GUARD_SIZE + 2] = 4;
-	ret = rcobs_decode( buffer + UTEST_GUARD_SIZE, 3, buffer + UTEST_GUARD_SIZE, 2, &decodedLen, &decodedPos );
+	ret = rcobs_decode( buffer + UTEST_GUARD_SIZE, 3, decoded, 2, &decodedLen, &decodedPos );
 	CHECK_EQUAL( RCOBS_RET_ERR_OVERFLOW, ret );
 }
 
+// NOLINTBEGIN
+TEST( RCOBS, DecodeRunEmbeddedZero )
+// NOLINTEND
+{
+	eRCOBS_ret ret			= RCOBS_RET_SUCCESS;
+	size_t decodedLen		= 0;
+	uint8_t *decodedPos = nullptr;
+
+	uint8_t encoded[256];
+	uint8_t decoded[256];
+
+	// A single run of every length, with a zero at every position of the run
+	for( size_t runSize = 1; runSize < 255; runSize++ )
+	{
+		for( size_t i = 0; i < runSize; i++ )
+		{
+			encoded[i] = (uint8_t)( ( i % 255 ) + 1 );
+		}
+
+		encoded[runSize] = (uint8_t)( runSize + 1 );
+
+		ret = rcobs_decode( encoded, runSize + 1, decoded, sizeof( decoded ), &decodedLen, &decodedPos );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( runSize, decodedLen );
+		CHECK_EQUAL( 0, memcmp( encoded, decodedPos, runSize ) );
+
+		for( size_t zeroPos = 0; zeroPos < runSize; zeroPos++ )
+		{
+			const uint8_t byte = encoded[zeroPos];
+			encoded[zeroPos]	 = 0;
+
+			ret = rcobs_decode( encoded, runSize + 1, decoded, sizeof( decoded ), &decodedLen, &decodedPos );
+			CHECK_EQUAL( RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, ret );
+
+			encoded[zeroPos] = byte;
+		}
+
+		// The code is longer than the encoded data
+		if( runSize > 1 )
+		{
+			ret = rcobs_decode( encoded + 1, runSize, decoded, sizeof( decoded ), &decodedLen, &decodedPos );
+			CHECK_EQUAL( RCOBS_RET_ERR_BAD_ENCODED_PAYLOAD, ret );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( RCOBS, EncodeDecodeTrailingZero )
+// NOLINTEND
+{
+	// Data that ends with zeros, so the last run is empty
+	static const uint8_t endsWithOneZero[]	 = { 1, 2, 3, 0 };
+	static const uint8_t endsWithTwoZeros[]	 = { 1, 0, 0 };
+	static const uint8_t onlyOneZero[]			 = { 0 };
+	static const uint8_t onlyZeros[]				 = { 0, 0, 0 };
+	static const uint8_t zeroInTheMiddle[]	 = { 1, 0, 2 };
+	static const uint8_t *const datas[]			 = { endsWithOneZero, endsWithTwoZeros, onlyOneZero, onlyZeros, zeroInTheMiddle };
+	static const size_t dataSizes[]					 = { sizeof( endsWithOneZero ), sizeof( endsWithTwoZeros ), sizeof( onlyOneZero ),
+																							 sizeof( onlyZeros ), sizeof( zeroInTheMiddle ) };
+
+	uint8_t decoded[16];
+
+	for( size_t d = 0; d < ( sizeof( datas ) / sizeof( datas[0] ) ); d++ )
+	{
+		sRCOBS_ctx ctx;
+		size_t sizeEncoded	= 0;
+		size_t decodedLen		= 0;
+		uint8_t *decodedPos = nullptr;
+
+		eRCOBS_ret ret = rcobs_encode_inc_begin( &ctx, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+		ret = rcobs_encode_inc( &ctx, datas[d], dataSizes[d] );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+		ret = rcobs_encode_inc_end( &ctx, &sizeEncoded );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+		ret = rcobs_decode( buffer, sizeEncoded, decoded, sizeof( decoded ), &decodedLen, &decodedPos );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( dataSizes[d], decodedLen );
+		CHECK_EQUAL( 0, memcmp( datas[d], decodedPos, decodedLen ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( RCOBS, DecodeInPlace )
+// NOLINTEND
+{
+	eRCOBS_ret ret			= RCOBS_RET_SUCCESS;
+	sRCOBS_ctx ctx;
+	size_t sizeEncoded	= 0;
+	size_t decodedLen		= 0;
+	uint8_t *decodedPos = nullptr;
+
+	uint8_t decodedData[600];
+
+	for( size_t sizeToEncode = 1; sizeToEncode <= sizeof( decodedData ); sizeToEncode += 7 )
+	{
+		for( size_t i = 0; i < sizeToEncode; i++ )
+		{
+			// Long runs, to use the vectorized copy, and some zeros
+			decodedData[i] = ( ( rand() % 64 ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+		}
+
+		ret = rcobs_encode_inc_begin( &ctx, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+		ret = rcobs_encode_inc( &ctx, decodedData, sizeToEncode );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+		ret = rcobs_encode_inc_end( &ctx, &sizeEncoded );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+		ret = rcobs_decode( buffer, sizeEncoded, buffer, sizeEncoded, &decodedLen, &decodedPos );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( sizeToEncode, decodedLen );
+		CHECK_EQUAL( 0, memcmp( decodedData, decodedPos, decodedLen ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( RCOBS, DecodeInPlaceEndsBeforeFrame )
+// NOLINTEND
+{
+	eRCOBS_ret ret			= RCOBS_RET_SUCCESS;
+	sRCOBS_ctx ctx;
+	size_t sizeEncoded	= 0;
+	size_t decodedLen		= 0;
+	uint8_t *decodedPos = nullptr;
+
+	uint8_t decodedData[64];
+	uint8_t encoded[RCOBS_MAX_ENCODED_SIZE( sizeof( decodedData ) )];
+
+	for( size_t i = 0; i < sizeof( decodedData ); i++ )
+	{
+		decodedData[i] = (uint8_t)( i % 7 );
+	}
+
+	ret = rcobs_encode_inc_begin( &ctx, encoded, sizeof( encoded ) );
+	CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+	ret = rcobs_encode_inc( &ctx, decodedData, sizeof( decodedData ) );
+	CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+	ret = rcobs_encode_inc_end( &ctx, &sizeEncoded );
+	CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+	static constexpr size_t frameOffset = 8;
+
+	memcpy( buffer + frameOffset, encoded, sizeEncoded );
+
+	// The destiny overlaps the frame but ends before it, so it is rejected and nothing is written
+	for( const size_t dstSize : { frameOffset + 1, frameOffset + ( sizeEncoded / 2 ), frameOffset + sizeEncoded - 1 } )
+	{
+		ret = rcobs_decode( buffer + frameOffset, sizeEncoded, buffer, dstSize, &decodedLen, &decodedPos );
+		CHECK_EQUAL( RCOBS_RET_ERR_BAD_ARG, ret );
+		CHECK_EQUAL( 0, memcmp( buffer + frameOffset, encoded, sizeEncoded ) );
+	}
+
+	// Ending with the frame is in-place
+	ret = rcobs_decode( buffer + frameOffset, sizeEncoded, buffer, frameOffset + sizeEncoded, &decodedLen, &decodedPos );
+	CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+	CHECK_EQUAL( sizeof( decodedData ), decodedLen );
+	CHECK_EQUAL( 0, memcmp( decodedData, decodedPos, decodedLen ) );
+}
+
+// NOLINTBEGIN
+TEST( RCOBS, DecodeLeftAligned )
+// NOLINTEND
+{
+	eRCOBS_ret ret		 = RCOBS_RET_SUCCESS;
+	sRCOBS_ctx ctx;
+	size_t sizeEncoded = 0;
+	size_t decodedLen	 = 0;
+
+	uint8_t decodedData[600];
+	uint8_t decoded[sizeof( decodedData ) + 1];
+
+	for( size_t sizeToEncode = 1; sizeToEncode <= sizeof( decodedData ); sizeToEncode += 5 )
+	{
+		for( size_t i = 0; i < sizeToEncode; i++ )
+		{
+			decodedData[i] = ( ( rand() % 32 ) == 0 ) ? 0 : (uint8_t)( ( rand() % 255 ) + 1 );
+		}
+
+		ret = rcobs_encode_inc_begin( &ctx, buffer, UTEST_ENCODED_DECODED_DATA_MAX_SIZE );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+		ret = rcobs_encode_inc( &ctx, decodedData, sizeToEncode );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+		ret = rcobs_encode_inc_end( &ctx, &sizeEncoded );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+
+		size_t decodedSize = 0;
+		ret								 = rcobs_decoded_size( buffer, sizeEncoded, &decodedSize );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( sizeToEncode, decodedSize );
+
+		memset( decoded, UTEST_GUARD_BYTE, sizeof( decoded ) );
+
+		ret = rcobs_decode_left_aligned( buffer, sizeEncoded, decoded, sizeof( decoded ), &decodedLen );
+		CHECK_EQUAL( RCOBS_RET_SUCCESS, ret );
+		CHECK_EQUAL( sizeToEncode, decodedLen );
+		CHECK_EQUAL( 0, memcmp( decodedData, decoded, decodedLen ) );
+		CHECK_EQUAL( UTEST_GUARD_BYTE, decoded[decodedLen] );
+
+		if( sizeToEncode > 1 )
+		{
+			ret = rcobs_decode_left_aligned( buffer, sizeEncoded, decoded, sizeToEncode - 1, &decodedLen );
+			CHECK_EQUAL( RCOBS_RET_ERR_OVERFLOW, ret );
+		}
+	}
+}
+
 // NOLINTBEGIN
 TEST( RCOBS, EncodeBeginInvalidArgs )
 // NOLINTEND
@@ -0,0 +1,330 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_simd.cpp
+///	@brief Tests for the vectorized scan kernels
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <../src/dzrcobs_simd.h>
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_dictionary.h>
+#include <vector>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define UTEST_SCAN_BUFFER_SIZE ( 200 )
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZRCOBS_SIMD ){
+	void setup()
+	{
+		memset( buffer, 0xA5, sizeof( buffer ) );
+
+		m_initialLevel = dzrcobs_simd_get_level();
+
+		// The levels of this build and CPU, each test runs the same vectors on all of them
+		for( int level = DZRCOBS_SIMD_LEVEL_SCALAR; level < DZRCOBS_SIMD_LEVEL_N; level++ )
+		{
+			if( dzrcobs_simd_is_supported( (eDZRCOBS_simd_level)level ) )
+			{
+				m_levels.push_back( (eDZRCOBS_simd_level)level );
+			}
+		}
+
+		CHECK_FALSE( m_levels.empty() );
+	}
+
+	void teardown()
+	{
+		CHECK_TRUE( dzrcobs_simd_set_level( m_initialLevel ) );
+	}
+
+	uint8_t buffer[UTEST_SCAN_BUFFER_SIZE];
+	eDZRCOBS_simd_level m_initialLevel;
+	std::vector<eDZRCOBS_simd_level> m_levels;
+};
+// NOLINTEND
+// clang-format on
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZRCOBS_SIMD, Levels )
+// NOLINTEND
+{
+#if DZRCOBS_SIMD_DISPATCH
+	CHECK_TRUE( dzrcobs_simd_is_supported( DZRCOBS_SIMD_LEVEL_SCALAR ) );
+#endif
+	CHECK_TRUE( dzrcobs_simd_is_supported( m_initialLevel ) );
+	CHECK_FALSE( dzrcobs_simd_is_supported( DZRCOBS_SIMD_LEVEL_N ) );
+	CHECK_FALSE( dzrcobs_simd_set_level( DZRCOBS_SIMD_LEVEL_N ) );
+
+	STRCMP_EQUAL( "scalar", dzrcobs_simd_level_name( DZRCOBS_SIMD_LEVEL_SCALAR ) );
+	STRCMP_EQUAL( "ssse3", dzrcobs_simd_level_name( DZRCOBS_SIMD_LEVEL_SSSE3 ) );
+	STRCMP_EQUAL( "avx2", dzrcobs_simd_level_name( DZRCOBS_SIMD_LEVEL_AVX2 ) );
+	STRCMP_EQUAL( "avx512", dzrcobs_simd_level_name( DZRCOBS_SIMD_LEVEL_AVX512 ) );
+	STRCMP_EQUAL( "", dzrcobs_simd_level_name( DZRCOBS_SIMD_LEVEL_N ) );
+
+	for( const eDZRCOBS_simd_level level : m_levels )
+	{
+		CHECK_TRUE( dzrcobs_simd_set_level( level ) );
+		CHECK_EQUAL( level, dzrcobs_simd_get_level() );
+	}
+
+#if DZRCOBS_SIMD_DISPATCH
+	// The dispatch picks the best level, unless it was lowered by the environment
+	// (ctest runs the whole suite once per level, see test/CMakeLists.txt)
+	eDZRCOBS_simd_level expectedLevel = m_levels.back();
+	const char *pEnvLevel							= getenv( DZRCOBS_SIMD_ENV );
+
+	for( const eDZRCOBS_simd_level level : m_levels )
+	{
+		if( ( pEnvLevel != nullptr ) && ( strcmp( pEnvLevel, dzrcobs_simd_level_name( level ) ) == 0 ) )
+		{
+			expectedLevel = level;
+		}
+	}
+
+	CHECK_EQUAL( expectedLevel, m_initialLevel );
+#endif
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_SIMD, FindZeroEmpty )
+// NOLINTEND
+{
+	for( const eDZRCOBS_simd_level level : m_levels )
+	{
+		CHECK_TRUE( dzrcobs_simd_set_level( level ) );
+
+		CHECK_EQUAL( 0, dzrcobs_simd_find_zero( buffer, 0 ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_SIMD, FindZeroNone )
+// NOLINTEND
+{
+	for( const eDZRCOBS_simd_level level : m_levels )
+	{
+		CHECK_TRUE( dzrcobs_simd_set_level( level ) );
+
+		for( size_t size = 0; size <= UTEST_SCAN_BUFFER_SIZE; size++ )
+		{
+			CHECK_EQUAL( size, dzrcobs_simd_find_zero( buffer, size ) );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_SIMD, FindZeroEveryPosition )
+// NOLINTEND
+{
+	for( const eDZRCOBS_simd_level level : m_levels )
+	{
+		CHECK_TRUE( dzrcobs_simd_set_level( level ) );
+
+		// Covers the vector body, the vector tails and every misalignment
+		for( size_t offset = 0; offset < 64; offset++ )
+		{
+			for( size_t zeroPos = offset; zeroPos < UTEST_SCAN_BUFFER_SIZE; zeroPos++ )
+			{
+				buffer[zeroPos] = 0x00;
+
+				CHECK_EQUAL( zeroPos - offset,
+										 dzrcobs_simd_find_zero( buffer + offset, UTEST_SCAN_BUFFER_SIZE - offset ) );
+
+				// The zero is outside of the scanned size
+				CHECK_EQUAL( zeroPos - offset, dzrcobs_simd_find_zero( buffer + offset, zeroPos - offset ) );
+
+				buffer[zeroPos] = 0x80; // high bit set must not be seen as zero
+			}
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_SIMD, FindZeroFirstOfMany )
+// NOLINTEND
+{
+	buffer[70]	= 0x00;
+	buffer[71]	= 0x00;
+	buffer[150] = 0x00;
+
+	for( const eDZRCOBS_simd_level level : m_levels )
+	{
+		CHECK_TRUE( dzrcobs_simd_set_level( level ) );
+
+		CHECK_EQUAL( 70, dzrcobs_simd_find_zero( buffer, UTEST_SCAN_BUFFER_SIZE ) );
+		CHECK_EQUAL( 0, dzrcobs_simd_find_zero( buffer + 71, UTEST_SCAN_BUFFER_SIZE - 71 ) );
+		CHECK_EQUAL( 78, dzrcobs_simd_find_zero( buffer + 72, UTEST_SCAN_BUFFER_SIZE - 72 ) );
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_SIMD, EncodeEveryLevel )
+// NOLINTEND
+{
+	// Long runs without zeros and dictionary words, so the frames go through the kernels
+	std::vector<uint8_t> decodedData;
+
+	for( size_t i = 0; i < 2000; i++ )
+	{
+		const int r = rand() % 64;
+
+		decodedData.push_back( ( r == 0 ) ? 0x00 : ( r == 1 ) ? 0x0D : ( r == 2 ) ? 0x0A : (uint8_t)( 0x80 | rand() ) );
+	}
+
+	const eDZRCOBS_encoding encodings[] = { DZRCOBS_PLAIN, DZRCOBS_USING_DICT_1 };
+	std::vector<uint8_t> expected[2];
+
+	for( const eDZRCOBS_simd_level level : m_levels )
+	{
+		CHECK_TRUE( dzrcobs_simd_set_level( level ) );
+
+		for( size_t e = 0; e < 2; e++ )
+		{
+			sDICT_ctx dictCtx;
+			sDZRCOBS_ctx ctx;
+			std::vector<uint8_t> encoded( DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( decodedData.size() ) + DZRCOBS_FRAME_HEADER_SIZE );
+			size_t encodedLen = 0;
+
+			CHECK_EQUAL( DICT_RET_SUCCESS,
+									 dzrcobs_dictionary_init( &dictCtx, G_DZRCOBS_DefaultDictionary, G_DZRCOBS_DefaultDictionary_size ) );
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 ) );
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_begin( &ctx, encodings[e], encoded.data(), encoded.size() ) );
+			ctx.user6bits = 1;
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc( &ctx, decodedData.data(), decodedData.size() ) );
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, dzrcobs_encode_inc_end( &ctx, &encodedLen ) );
+
+			encoded.resize( encodedLen );
+
+			// Same frame on all the levels
+			if( expected[e].empty() )
+			{
+				expected[e] = encoded;
+			}
+			else
+			{
+				CHECK_EQUAL( expected[e].size(), encoded.size() );
+				MEMCMP_EQUAL( expected[e].data(), encoded.data(), encoded.size() );
+			}
+		}
+	}
+}
+
+#if DZRCOBS_DICT_ACCELERATOR
+
+// NOLINTBEGIN
+TEST( DZRCOBS_SIMD, FindDictCandidateNoFalseNegatives )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret ret = dzrcobs_dictionary_init( &dictCtx, G_DZRCOBS_DefaultDictionary, G_DZRCOBS_DefaultDictionary_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, ret );
+
+	for( int n = 0; n < 200; n++ )
+	{
+		// Mostly bytes of the dictionary words, so there are matches and near matches
+		for( size_t i = 0; i < UTEST_SCAN_BUFFER_SIZE; i++ )
+		{
+			buffer[i] = (uint8_t)( ( rand() % 4 ) ? "\x00\x01\x0D\x0A\x10"[rand() % 5] : rand() );
+		}
+
+		for( size_t offset = 0; offset < 40; offset++ )
+		{
+			const uint8_t *pBuf = buffer + offset;
+			const size_t size		= UTEST_SCAN_BUFFER_SIZE - offset - ( (size_t)rand() % 8 );
+
+			for( const eDZRCOBS_simd_level level : m_levels )
+			{
+				CHECK_TRUE( dzrcobs_simd_set_level( level ) );
+
+				const size_t candidate = dzrcobs_simd_find_dict_candidate( dictCtx.accel.pairNibbleMasks, pBuf, size );
+
+				CHECK( candidate <= size );
+
+				// All positions before the candidate have no word
+				for( size_t i = 0; i < candidate; i++ )
+				{
+					size_t keySizeFound = 0;
+					CHECK_EQUAL( 0, dzrcobs_dictionary_search( &dictCtx, pBuf + i, size - i, &keySizeFound ) );
+				}
+
+				// The candidate satisfies the nibble filter
+				if( candidate < size )
+				{
+					CHECK( ( candidate + 1 ) < size );
+
+					const uint8_t byte0 = pBuf[candidate];
+					const uint8_t byte1 = pBuf[candidate + 1];
+
+					CHECK( ( dictCtx.accel.pairNibbleMasks[0][byte0 & 0x0F] & dictCtx.accel.pairNibbleMasks[1][byte0 >> 4] &
+									 dictCtx.accel.pairNibbleMasks[2][byte1 & 0x0F] & dictCtx.accel.pairNibbleMasks[3][byte1 >> 4] ) != 0 );
+				}
+			}
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_SIMD, FindDictCandidateEveryPosition )
+// NOLINTEND
+{
+	sDICT_ctx dictCtx;
+
+	eDICT_ret ret = dzrcobs_dictionary_init( &dictCtx, G_DZRCOBS_DefaultDictionary, G_DZRCOBS_DefaultDictionary_size );
+	CHECK_EQUAL( DICT_RET_SUCCESS, ret );
+
+	for( const eDZRCOBS_simd_level level : m_levels )
+	{
+		CHECK_TRUE( dzrcobs_simd_set_level( level ) );
+
+		// 0xA5 can not start a word of the default dictionary
+		CHECK_EQUAL( UTEST_SCAN_BUFFER_SIZE,
+								 dzrcobs_simd_find_dict_candidate( dictCtx.accel.pairNibbleMasks, buffer, UTEST_SCAN_BUFFER_SIZE ) );
+
+		for( size_t pos = 0; pos < ( UTEST_SCAN_BUFFER_SIZE - 1 ); pos++ )
+		{
+			buffer[pos]			= 0x0D;
+			buffer[pos + 1] = 0x0A;
+
+			CHECK_EQUAL( pos, dzrcobs_simd_find_dict_candidate( dictCtx.accel.pairNibbleMasks, buffer, UTEST_SCAN_BUFFER_SIZE ) );
+
+			// The word does not fit
+			CHECK_EQUAL( pos + 1, dzrcobs_simd_find_dict_candidate( dictCtx.accel.pairNibbleMasks, buffer, pos + 1 ) );
+
+			buffer[pos]			= 0xA5;
+			buffer[pos + 1] = 0xA5;
+		}
+	}
+}
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
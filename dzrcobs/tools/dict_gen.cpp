@@ -0,0 +1,834 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dict_gen.cpp
+///	@brief dzrcobs_dict_gen, turns a dictionary source into specialized C
+///
+/// Usage: dzrcobs_dict_gen --name <symbol> --source <file.c> --header <file.h> <dictionary file>
+///
+/// The dictionary file is C source with a DICT_ADD_WORD list, as
+/// src/dictionary_default.c or the output of dzrcobs_dict_train. The words are
+/// read from the DICT_ADD_WORD entries, the rest of the file is not used.
+/// The generated source has:
+/// - The dictionary string.
+/// - <symbol>_search, a switch per byte (a trie) with the words, that gives
+///   the same result as dzrcobs_dictionary_search, without loops or memcmp.
+/// - <symbol>, a const sDICT_ctx as dzrcobs_dictionary_init leaves it (with
+///   the accelerator tables, and its flat word table used by the decoder),
+///   with searchFunc set to <symbol>_search. It needs no init and can be on
+///   flash.
+/// It is run by the dzrcobs_add_dictionary CMake function.
+///
+///	@par  Plataform Target:	Host tools
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <dzrcobs/dzrcobs_dictionary.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define GEN_MACRO_NAME "DICT_ADD_WORD"
+#define GEN_BYTES_PER_LINE ( 16 )
+
+typedef struct s_GEN_options
+{
+	const char *pInput;
+	const char *pName;
+	const char *pSource;
+	const char *pHeader;
+} sGEN_options;
+
+typedef struct s_GEN_word
+{
+	std::string bytes;
+	uint8_t index; ///< Global index, 1 based, as returned by dzrcobs_dictionary_search
+} sGEN_word;
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static bool gen_read_file( const char *aPath, std::string *aOutText )
+{
+	FILE *pFile = fopen( aPath, "rb" );
+
+	if( pFile == nullptr )
+	{
+		fprintf( stderr, "Can not open %s\n", aPath );
+		return false;
+	}
+
+	char chunk[4096];
+	size_t readSize = 0;
+
+	aOutText->clear();
+
+	while( ( readSize = fread( chunk, 1, sizeof( chunk ), pFile ) ) > 0 )
+	{
+		aOutText->append( chunk, readSize );
+	}
+
+	const bool isRead = ( ferror( pFile ) == 0 );
+
+	fclose( pFile );
+
+	return isRead;
+}
+
+static bool gen_is_hex( char aChar )
+{
+	return isxdigit( (unsigned char)aChar ) != 0;
+}
+
+static unsigned gen_hex_value( char aChar )
+{
+	return isdigit( (unsigned char)aChar ) ? (unsigned)( aChar - '0' ) : (unsigned)( ( tolower( aChar ) - 'a' ) + 10 );
+}
+
+/**
+ * @brief Parses a C string literal at aText[*aPos] (the opening quote), with
+ *        its escapes, as the compiler does. A hex escape takes all the hex
+ *        digits that follow it.
+ */
+static bool gen_parse_string( const std::string &aText, size_t *aPos, std::string *aOutBytes )
+{
+	size_t pos = *aPos + 1;
+
+	while( ( pos < aText.size() ) && ( aText[pos] != '"' ) )
+	{
+		const char c = aText[pos++];
+
+		if( c == '\n' )
+		{
+			return false;
+		}
+
+		if( c != '\\' )
+		{
+			aOutBytes->push_back( c );
+			continue;
+		}
+
+		if( pos >= aText.size() )
+		{
+			return false;
+		}
+
+		const char escape = aText[pos++];
+		unsigned value		= 0;
+
+		switch( escape )
+		{
+		case 'x':
+			if( ( pos >= aText.size() ) || !gen_is_hex( aText[pos] ) )
+			{
+				return false;
+			}
+
+			while( ( pos < aText.size() ) && gen_is_hex( aText[pos] ) )
+			{
+				value = ( value * 16 ) + gen_hex_value( aText[pos++] );
+
+				if( value > 0xFF )
+				{
+					return false;
+				}
+			}
+			break;
+		case '0':
+		case '1':
+		case '2':
+		case '3':
+		case '4':
+		case '5':
+		case '6':
+		case '7':
+			value = (unsigned)( escape - '0' );
+
+			for( int i = 0; ( i < 2 ) && ( pos < aText.size() ) && ( aText[pos] >= '0' ) && ( aText[pos] <= '7' ); i++ )
+			{
+				value = ( value * 8 ) + (unsigned)( aText[pos++] - '0' );
+			}
+
+			if( value > 0xFF )
+			{
+				return false;
+			}
+			break;
+		case 'a':
+			value = '\a';
+			break;
+		case 'b':
+			value = '\b';
+			break;
+		case 'f':
+			value = '\f';
+			break;
+		case 'n':
+			value = '\n';
+			break;
+		case 'r':
+			value = '\r';
+			break;
+		case 't':
+			value = '\t';
+			break;
+		case 'v':
+			value = '\v';
+			break;
+		case '\\':
+		case '\'':
+		case '"':
+		case '?':
+			value = (unsigned)escape;
+			break;
+		default:
+			return false;
+		}
+
+		aOutBytes->push_back( (char)value );
+	}
+
+	if( pos >= aText.size() )
+	{
+		return false;
+	}
+
+	*aPos = pos + 1;
+
+	return true;
+}
+
+static void gen_skip_spaces( const std::string &aText, size_t *aPos )
+{
+	while( ( *aPos < aText.size() ) && isspace( (unsigned char)aText[*aPos] ) )
+	{
+		( *aPos )++;
+	}
+}
+
+/**
+ * @brief Builds the dictionary string, as the compiler builds it from the
+ *        DICT_ADD_WORD entries of aText (null terminated). The comments and
+ *        other string literals are skipped.
+ */
+static bool gen_parse_dictionary( const std::string &aText, std::string *aOutDictionary )
+{
+	const size_t macroSize = strlen( GEN_MACRO_NAME );
+
+	size_t pos = 0;
+	size_t line = 1;
+
+	aOutDictionary->clear();
+
+	while( pos < aText.size() )
+	{
+		if( aText.compare( pos, 2, "//" ) == 0 )
+		{
+			pos = aText.find( '\n', pos );
+			pos = ( pos == std::string::npos ) ? aText.size() : pos;
+		}
+		else if( aText.compare( pos, 2, "/*" ) == 0 )
+		{
+			const size_t end = aText.find( "*/", pos + 2 );
+
+			for( ; pos < ( ( end == std::string::npos ) ? aText.size() : end + 2 ); pos++ )
+			{
+				line += ( aText[pos] == '\n' ) ? 1U : 0U;
+			}
+		}
+		else if( ( aText[pos] == '"' ) || ( aText[pos] == '\'' ) )
+		{
+			// Other literals, skipped
+			const char quote = aText[pos++];
+
+			while( ( pos < aText.size() ) && ( aText[pos] != quote ) && ( aText[pos] != '\n' ) )
+			{
+				pos += ( aText[pos] == '\\' ) ? 2U : 1U;
+			}
+
+			pos++;
+		}
+		else if( ( aText.compare( pos, macroSize, GEN_MACRO_NAME ) == 0 ) &&
+						 ( ( pos == 0 ) || !( isalnum( (unsigned char)aText[pos - 1] ) || ( aText[pos - 1] == '_' ) ) ) &&
+						 !( isalnum( (unsigned char)aText[pos + macroSize] ) || ( aText[pos + macroSize] == '_' ) ) )
+		{
+			// DICT_ADD_WORD( <size>, "<word>" )
+			pos += macroSize;
+
+			std::string word;
+			size_t wordSize = 0;
+
+			gen_skip_spaces( aText, &pos );
+
+			if( ( pos >= aText.size() ) || ( aText[pos] != '(' ) )
+			{
+				// The macro definition, or a mention of it
+				continue;
+			}
+
+			pos++;
+			gen_skip_spaces( aText, &pos );
+
+			while( ( pos < aText.size() ) && isdigit( (unsigned char)aText[pos] ) )
+			{
+				wordSize = ( wordSize * 10 ) + (size_t)( aText[pos++] - '0' );
+			}
+
+			gen_skip_spaces( aText, &pos );
+
+			if( ( pos >= aText.size() ) || ( aText[pos] != ',' ) )
+			{
+				// As in the macro definition
+				continue;
+			}
+
+			pos++;
+			gen_skip_spaces( aText, &pos );
+
+			// Adjacent literals are joined
+			while( ( pos < aText.size() ) && ( aText[pos] == '"' ) )
+			{
+				if( !gen_parse_string( aText, &pos, &word ) )
+				{
+					fprintf( stderr, "Line %zu: invalid string literal\n", line );
+					return false;
+				}
+
+				gen_skip_spaces( aText, &pos );
+			}
+
+			if( ( pos >= aText.size() ) || ( aText[pos] != ')' ) )
+			{
+				fprintf( stderr, "Line %zu: expected " GEN_MACRO_NAME "( <size>, \"<word>\" )\n", line );
+				return false;
+			}
+
+			pos++;
+
+			if( ( wordSize < 2 ) || ( wordSize > DICT_MAX_WORD_SIZE ) || ( word.size() != wordSize ) )
+			{
+				fprintf( stderr, "Line %zu: the word has %zu bytes, not %zu (2..%d)\n", line, word.size(), wordSize, DICT_MAX_WORD_SIZE );
+				return false;
+			}
+
+			aOutDictionary->push_back( (char)( '0' + wordSize ) );
+			aOutDictionary->append( word );
+		}
+		else
+		{
+			line += ( aText[pos] == '\n' ) ? 1U : 0U;
+			pos++;
+		}
+	}
+
+	// As sizeof() of the array, the null terminator included
+	aOutDictionary->push_back( '\0' );
+
+	return aOutDictionary->size() > 1;
+}
+
+// The words of aCtx, with their index, in the dictionary order
+static std::vector<sGEN_word> gen_words( const sDICT_ctx &aCtx )
+{
+	std::vector<sGEN_word> words;
+
+	for( const sDICT_wordentry &entry : aCtx.wordSizeTable )
+	{
+		for( uint8_t i = 0; i < entry.nEntries; i++ )
+		{
+			const uint8_t *pWord = entry.dictionaryBegin + ( (size_t)i * entry.strideSize ) + 1;
+
+			words.push_back(
+			 { std::string( (const char *)pWord, (size_t)( entry.strideSize - 1 ) ), (uint8_t)( entry.globalIndex + i ) } );
+		}
+	}
+
+	return words;
+}
+
+static void gen_indent( FILE *aFile, size_t aDepth )
+{
+	for( size_t i = 0; i < aDepth; i++ )
+	{
+		fputc( '\t', aFile );
+	}
+}
+
+/**
+ * @brief Writes the trie node of the words that start with aPrefix.
+ *        A word ends at the node of its last byte, and no longer word after
+ *        it can match first, as dzrcobs_dictionary_search tries the shortest
+ *        size first.
+ */
+static void gen_write_node( FILE *aFile,
+														const std::vector<sGEN_word> &aWords,
+														const std::string &aPrefix,
+														uint8_t aMinWordSize,
+														size_t aIndent )
+{
+	const size_t depth = aPrefix.size();
+
+	for( const sGEN_word &word : aWords )
+	{
+		if( word.bytes == aPrefix )
+		{
+			gen_indent( aFile, aIndent );
+			fprintf( aFile, "*aOutKeySizeFound = %zu;\n", depth );
+			gen_indent( aFile, aIndent );
+			fprintf( aFile, "return %u;\n", word.index );
+			return;
+		}
+	}
+
+	// The search key has at least aMinWordSize bytes
+	const bool isSizeChecked = depth >= aMinWordSize;
+
+	if( isSizeChecked )
+	{
+		gen_indent( aFile, aIndent );
+		fprintf( aFile, "if( aSearchKeySize <= %zu )\n", depth );
+		gen_indent( aFile, aIndent );
+		fprintf( aFile, "{\n" );
+		gen_indent( aFile, aIndent + 1 );
+		fprintf( aFile, "return 0;\n" );
+		gen_indent( aFile, aIndent );
+		fprintf( aFile, "}\n\n" );
+	}
+
+	gen_indent( aFile, aIndent );
+	fprintf( aFile, "switch( aSearchKey[%zu] )\n", depth );
+	gen_indent( aFile, aIndent );
+	fprintf( aFile, "{\n" );
+
+	// The words are sorted by size and then by value, so the bytes are taken by value
+	std::vector<bool> isWritten( 256, false );
+
+	for( int byte = 0; byte < 256; byte++ )
+	{
+		std::string child = aPrefix;
+		child.push_back( (char)byte );
+
+		bool hasWords = false;
+
+		for( const sGEN_word &word : aWords )
+		{
+			hasWords = hasWords || ( word.bytes.compare( 0, child.size(), child ) == 0 );
+		}
+
+		if( !hasWords )
+		{
+			continue;
+		}
+
+		gen_indent( aFile, aIndent );
+		fprintf( aFile, "case 0x%02X:\n", byte );
+
+		std::vector<sGEN_word> childWords;
+
+		for( const sGEN_word &word : aWords )
+		{
+			if( word.bytes.compare( 0, child.size(), child ) == 0 )
+			{
+				childWords.push_back( word );
+			}
+		}
+
+		gen_write_node( aFile, childWords, child, aMinWordSize, aIndent + 1 );
+	}
+
+	gen_indent( aFile, aIndent );
+	fprintf( aFile, "default:\n" );
+	gen_indent( aFile, aIndent + 1 );
+	fprintf( aFile, "return 0;\n" );
+	gen_indent( aFile, aIndent );
+	fprintf( aFile, "}\n" );
+}
+
+#if DZRCOBS_DICT_ACCELERATOR
+static void gen_write_bytes( FILE *aFile, const uint8_t *aBytes, size_t aSize, size_t aIndent )
+{
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		if( ( i % GEN_BYTES_PER_LINE ) == 0 )
+		{
+			gen_indent( aFile, aIndent );
+		}
+
+		fprintf( aFile, "0x%02X,", aBytes[i] );
+		fputc( ( ( ( i + 1 ) % GEN_BYTES_PER_LINE ) == 0 ) || ( ( i + 1 ) == aSize ) ? '\n' : ' ', aFile );
+	}
+}
+#endif
+
+// DICT_ADD_WORD format, as dzrcobs_dict_train writes it
+static void gen_write_word( FILE *aFile, const std::string &aWord )
+{
+	bool isText = true;
+
+	for( const char c : aWord )
+	{
+		isText = isText && ( (uint8_t)c >= 0x20 ) && ( (uint8_t)c < 0x7F );
+	}
+
+	fprintf( aFile, "\tDICT_ADD_WORD(%zu, \"", aWord.size() );
+
+	for( const char c : aWord )
+	{
+		if( !isText )
+		{
+			// All as hex, so a hex digit never follows an escape
+			fprintf( aFile, "\\x%02X", (uint8_t)c );
+		}
+		else if( ( c == '"' ) || ( c == '\\' ) || ( c == '?' ) )
+		{
+			fprintf( aFile, "\\%c", c );
+		}
+		else
+		{
+			fputc( c, aFile );
+		}
+	}
+
+	fprintf( aFile, "\")\n" );
+}
+
+static const char *gen_file_name( const char *aPath )
+{
+	const char *pSlash		 = strrchr( aPath, '/' );
+	const char *pBackSlash = strrchr( aPath, '\\' );
+
+	pSlash = ( ( pBackSlash != nullptr ) && ( ( pSlash == nullptr ) || ( pBackSlash > pSlash ) ) ) ? pBackSlash : pSlash;
+
+	return ( pSlash != nullptr ) ? ( pSlash + 1 ) : aPath;
+}
+
+static void gen_write_file_header( FILE *aFile, const char *aFileName, const sGEN_options &aOptions )
+{
+	fprintf( aFile,
+					 "// /////////////////////////////////////////////////////////////////////////////\n"
+					 "///\t@file %s\n"
+					 "///\t@brief Dictionary %s, generated by dzrcobs_dict_gen from %s\n"
+					 "///\n"
+					 "/// Do not edit, it is generated again when %s changes.\n"
+					 "///\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n",
+					 aFileName,
+					 aOptions.pName,
+					 gen_file_name( aOptions.pInput ),
+					 gen_file_name( aOptions.pInput ) );
+}
+
+static bool gen_write_header( const sGEN_options &aOptions )
+{
+	FILE *pFile = fopen( aOptions.pHeader, "w" );
+
+	if( pFile == nullptr )
+	{
+		fprintf( stderr, "Can not create %s\n", aOptions.pHeader );
+		return false;
+	}
+
+	std::string guard = std::string( "_" ) + gen_file_name( aOptions.pHeader ) + "_";
+
+	for( char &c : guard )
+	{
+		c = isalnum( (unsigned char)c ) ? (char)toupper( (unsigned char)c ) : '_';
+	}
+
+	gen_write_file_header( pFile, gen_file_name( aOptions.pHeader ), aOptions );
+
+	fprintf( pFile,
+					 "#ifndef %s\n"
+					 "#define %s\n\n"
+					 "// Includes\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n"
+					 "#include <dzrcobs/dzrcobs_dictionary.h>\n\n"
+					 "// clang-format off\n"
+					 "#ifdef __cplusplus\n"
+					 "extern \"C\" {\n"
+					 "#endif\n"
+					 "// clang-format on\n\n"
+					 "// Declarations\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n\n"
+					 "/// Dictionary context, ready to be used (no dzrcobs_dictionary_init)\n"
+					 "extern const sDICT_ctx %s;\n\n"
+					 "/// dzrcobs_dictionary_search of this dictionary, also used through %s.searchFunc\n"
+					 "uint8_t %s_search( const uint8_t *aSearchKey, size_t aSearchKeySize, size_t *aOutKeySizeFound );\n\n"
+					 "#ifdef __cplusplus\n"
+					 "}\n"
+					 "#endif\n\n"
+					 "#endif\n\n"
+					 "// EOF\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n",
+					 guard.c_str(),
+					 guard.c_str(),
+					 aOptions.pName,
+					 aOptions.pName,
+					 aOptions.pName );
+
+	const bool isWritten = ( ferror( pFile ) == 0 );
+
+	return ( fclose( pFile ) == 0 ) && isWritten;
+}
+
+static bool gen_write_source( const sGEN_options &aOptions, const std::string &aDictionary, const sDICT_ctx &aCtx )
+{
+	FILE *pFile = fopen( aOptions.pSource, "w" );
+
+	if( pFile == nullptr )
+	{
+		fprintf( stderr, "Can not create %s\n", aOptions.pSource );
+		return false;
+	}
+
+	const std::vector<sGEN_word> words = gen_words( aCtx );
+
+	gen_write_file_header( pFile, gen_file_name( aOptions.pSource ), aOptions );
+
+	fprintf( pFile,
+					 "\n// Includes\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n"
+					 "#include \"%s\"\n\n"
+					 "// Definitions\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n\n"
+					 "#if DZRCOBS_DICT_ACCELERATOR != %d\n"
+					 "#error \"Generated for DZRCOBS_DICT_ACCELERATOR %d, it changes sDICT_ctx\"\n"
+					 "#endif\n\n"
+					 "// clang-format off\n\n"
+					 "static const char s_%s_Dictionary[] =\n",
+					 gen_file_name( aOptions.pHeader ),
+					 DZRCOBS_DICT_ACCELERATOR,
+					 DZRCOBS_DICT_ACCELERATOR,
+					 aOptions.pName );
+
+	for( const sGEN_word &word : words )
+	{
+		gen_write_word( pFile, word.bytes );
+	}
+
+	fprintf( pFile,
+					 ";\n\n"
+					 "// Implementation\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n\n"
+					 "uint8_t %s_search( const uint8_t *aSearchKey, size_t aSearchKeySize, size_t *aOutKeySizeFound )\n"
+					 "{\n"
+					 "\tif( aSearchKeySize < %u )\n"
+					 "\t{\n"
+					 "\t\treturn 0;\n"
+					 "\t}\n\n",
+					 aOptions.pName,
+					 aCtx.minWordSize );
+
+	gen_write_node( pFile, words, std::string(), aCtx.minWordSize, 1 );
+
+	fprintf( pFile, "}\n\nconst sDICT_ctx %s = {\n\t.wordSizeTable = {\n", aOptions.pName );
+
+	for( const sDICT_wordentry &entry : aCtx.wordSizeTable )
+	{
+		std::string begin = "NULL";
+
+		if( entry.dictionaryBegin != nullptr )
+		{
+			const size_t offset = (size_t)( (const char *)entry.dictionaryBegin - aDictionary.data() );
+
+			begin = "(const uint8_t *)&s_" + std::string( aOptions.pName ) + "_Dictionary[" + std::to_string( offset ) + "]";
+		}
+
+		fprintf( pFile,
+						 "\t\t{ %s, %u, %u, %u, %u },\n",
+						 begin.c_str(),
+						 entry.nEntries,
+						 entry.lastIndex,
+						 entry.globalIndex,
+						 entry.strideSize );
+	}
+
+	fprintf( pFile,
+					 "\t},\n"
+					 "\t.minWordSize = %u,\n"
+					 "\t.maxWordSize = %u,\n"
+					 "\t.searchFunc = %s_search,\n",
+					 aCtx.minWordSize,
+					 aCtx.maxWordSize,
+					 aOptions.pName );
+
+#if DZRCOBS_DICT_ACCELERATOR
+	const sDICT_accel &accel = aCtx.accel;
+
+	fprintf( pFile, "\t.accel = {\n\t\t.firstByteTiers = {\n" );
+	gen_write_bytes( pFile, accel.firstByteTiers, sizeof( accel.firstByteTiers ), 3 );
+	fprintf( pFile, "\t\t},\n\t\t.displacement = {\n" );
+	gen_write_bytes( pFile, accel.displacement, sizeof( accel.displacement ), 3 );
+	fprintf( pFile, "\t\t},\n\t\t.slots = {\n" );
+	gen_write_bytes( pFile, accel.slots, sizeof( accel.slots ), 3 );
+	fprintf( pFile, "\t\t},\n\t\t.pairNibbleMasks = {\n" );
+
+	for( const auto &masks : accel.pairNibbleMasks )
+	{
+		fprintf( pFile, "\t\t\t{\n" );
+		gen_write_bytes( pFile, masks, sizeof( masks ), 4 );
+		fprintf( pFile, "\t\t\t},\n" );
+	}
+
+	// Only the used indexes, the rest are zero
+	fprintf( pFile, "\t\t},\n\t\t.flatWords = {\n" );
+
+	for( size_t i = 0; i < DICT_MAX_WORDS; i++ )
+	{
+		if( accel.flatWordSize[i] > 0 )
+		{
+			fprintf( pFile, "\t\t\t[%zu] = { ", i );
+
+			for( size_t j = 0; j < DICT_FLAT_WORD_SIZE; j++ )
+			{
+				fprintf( pFile, "0x%02X%s", accel.flatWords[i][j], ( ( j + 1 ) < DICT_FLAT_WORD_SIZE ) ? ", " : " },\n" );
+			}
+		}
+	}
+
+	fprintf( pFile, "\t\t},\n\t\t.flatWordSize = {\n" );
+	gen_write_bytes( pFile, accel.flatWordSize, sizeof( accel.flatWordSize ), 3 );
+	fprintf( pFile, "\t\t},\n\t\t.seed = %u,\n\t\t.isHashed = %u,\n\t},\n", accel.seed, accel.isHashed );
+#endif
+
+	fprintf( pFile,
+					 "};\n\n"
+					 "// clang-format on\n\n"
+					 "// EOF\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n" );
+
+	const bool isWritten = ( ferror( pFile ) == 0 );
+
+	return ( fclose( pFile ) == 0 ) && isWritten;
+}
+
+static void gen_usage( const char *aProgram )
+{
+	fprintf( stderr,
+					 "usage: %s --name <symbol> --source <file.c> --header <file.h> <dictionary file>\n"
+					 "  --name <symbol>    sDICT_ctx symbol, the search function is <symbol>_search\n"
+					 "  --source <file.c>  generated source\n"
+					 "  --header <file.h>  generated header, included by the source\n",
+					 aProgram );
+}
+
+static bool gen_is_identifier( const char *aText )
+{
+	if( ( aText[0] == '\0' ) || isdigit( (unsigned char)aText[0] ) )
+	{
+		return false;
+	}
+
+	for( const char *p = aText; *p != '\0'; p++ )
+	{
+		if( !isalnum( (unsigned char)*p ) && ( *p != '_' ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool gen_parse_options( int argc, char **argv, sGEN_options *aOutOptions )
+{
+	sGEN_options options = { nullptr, nullptr, nullptr, nullptr };
+
+	for( int i = 1; i < argc; i++ )
+	{
+		const bool hasValue = ( i + 1 ) < argc;
+
+		if( ( strcmp( argv[i], "--name" ) == 0 ) && hasValue )
+		{
+			options.pName = argv[++i];
+		}
+		else if( ( strcmp( argv[i], "--source" ) == 0 ) && hasValue )
+		{
+			options.pSource = argv[++i];
+		}
+		else if( ( strcmp( argv[i], "--header" ) == 0 ) && hasValue )
+		{
+			options.pHeader = argv[++i];
+		}
+		else if( ( argv[i][0] == '-' ) || ( options.pInput != nullptr ) )
+		{
+			return false;
+		}
+		else
+		{
+			options.pInput = argv[i];
+		}
+	}
+
+	*aOutOptions = options;
+
+	return ( options.pInput != nullptr ) && ( options.pName != nullptr ) && gen_is_identifier( options.pName ) &&
+				 ( options.pSource != nullptr ) && ( options.pHeader != nullptr );
+}
+
+int main( int argc, char **argv )
+{
+	sGEN_options options;
+
+	if( !gen_parse_options( argc, argv, &options ) )
+	{
+		gen_usage( argv[0] );
+		return 1;
+	}
+
+	std::string text;
+	std::string dictionary;
+
+	if( !gen_read_file( options.pInput, &text ) )
+	{
+		return 1;
+	}
+
+	if( !gen_parse_dictionary( text, &dictionary ) )
+	{
+		fprintf( stderr, "%s: no valid " GEN_MACRO_NAME " list\n", options.pInput );
+		return 1;
+	}
+
+	const eDICTVALID_ret validRet = dzrcobs_dictionary_isvalid( dictionary.data(), dictionary.size() );
+
+	if( validRet != DICT_IS_VALID )
+	{
+		fprintf( stderr, "%s: the dictionary is not valid (eDICTVALID_ret %d)\n", options.pInput, (int)validRet );
+		return 1;
+	}
+
+	// The tables are the ones dzrcobs_dictionary_init builds
+	sDICT_ctx ctx;
+
+	if( dzrcobs_dictionary_init( &ctx, dictionary.data(), dictionary.size() ) != DICT_RET_SUCCESS )
+	{
+		fprintf( stderr, "%s: dzrcobs_dictionary_init failed\n", options.pInput );
+		return 1;
+	}
+
+	if( !gen_write_header( options ) || !gen_write_source( options, dictionary, ctx ) )
+	{
+		return 1;
+	}
+
+	return 0;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
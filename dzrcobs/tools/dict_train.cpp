@@ -0,0 +1,952 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dict_train.cpp
+///	@brief dzrcobs_dict_train, builds a dictionary from sample payloads
+///
+/// Usage: dzrcobs_dict_train [options] <sample files...>
+///
+/// The samples are split in frames (--frame-size) and read once, keeping a
+/// uniform (reservoir) sample of the frames, so any amount of data can be
+/// used. The most frequent 2..5 bytes n-grams of the sample are the
+/// candidates. The words are then selected on it by a (lazy) greedy search, with
+/// the encoded size given by a model of dzrcobs_encode_inc_dictionary: the
+/// shortest word is taken at each position, a word after a literal or a zero
+/// costs an extra code byte, a zero after a word is free, a jump code each 62
+/// literals, the last code and the frame header. The result is checked with
+/// dzrcobs_dictionary_isvalid and the real encoder, and written as a C file of
+/// DICT_ADD_WORD entries.
+///
+///	@par  Plataform Target:	Host tools
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_dictionary.h>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+#define TRAIN_DEFAULT_FRAME_SIZE ( 256 )
+#define TRAIN_DEFAULT_SAMPLE_SIZE ( 4 * 1024 * 1024 )
+#define TRAIN_DEFAULT_NAME "G_DZRCOBS_TrainedDictionary"
+
+#define TRAIN_MIN_WORD_SIZE ( 2 )
+#define TRAIN_MAX_WORD_SIZE ( DICT_MAX_WORD_SIZE )
+
+// Most frequent n-grams of each size that are tried on the selection
+#define TRAIN_CANDIDATES_PER_SIZE ( 128 )
+
+#define TRAIN_READ_CHUNK_SIZE ( 1024 * 1024 )
+#define TRAIN_SELECTION_ROUNDS ( 2 )
+#define TRAIN_USER6BITS ( 1 )
+
+typedef struct s_TRAIN_options
+{
+	std::vector<const char *> inputs;
+	const char *pOutput;
+	const char *pName;
+	size_t frameSize;
+	size_t sampleSize;
+	size_t maxWords;
+} sTRAIN_options;
+
+typedef struct s_TRAIN_candidate
+{
+	uint64_t key;	 ///< Bytes of the word, the first one on the most significant byte
+	size_t size;	 ///< Bytes of the word, 2..5
+	uint64_t count; ///< Occurrences on the sample
+} sTRAIN_candidate;
+
+// Shortest word size on a set of word sizes (bit 0 is 2 bytes)
+static const uint8_t s_TRAIN_ShortestSize[1 << ( TRAIN_MAX_WORD_SIZE - TRAIN_MIN_WORD_SIZE + 1 )] = {
+	0, 2, 3, 2, 4, 2, 3, 2, 5, 2, 3, 2, 4, 2, 3, 2,
+};
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+static inline uint64_t train_pack( const uint8_t *aBytes, size_t aSize )
+{
+	uint64_t key = 0;
+
+	for( size_t i = 0; i < aSize; i++ )
+	{
+		key = ( key << 8 ) | aBytes[i];
+	}
+
+	return key;
+}
+
+/**
+ * @brief The aPerSize most frequent n-grams of each size on the frames.
+ *        An n-gram does not cross frames, and one seen once can not save
+ *        anything so it is not a candidate.
+ */
+static std::vector<sTRAIN_candidate> train_candidates( const std::vector<std::vector<uint8_t>> &aFrames, size_t aPerSize )
+{
+	std::vector<sTRAIN_candidate> all;
+	std::vector<sTRAIN_candidate> sized;
+	std::vector<uint64_t> keys;
+
+	for( size_t size = TRAIN_MIN_WORD_SIZE; size <= TRAIN_MAX_WORD_SIZE; size++ )
+	{
+		keys.clear();
+
+		for( const std::vector<uint8_t> &frame : aFrames )
+		{
+			for( size_t pos = 0; ( pos + size ) <= frame.size(); pos++ )
+			{
+				keys.push_back( train_pack( &frame[pos], size ) );
+			}
+		}
+
+		std::sort( keys.begin(), keys.end() );
+
+		for( size_t i = 0; i < keys.size(); )
+		{
+			size_t end = i + 1;
+
+			while( ( end < keys.size() ) && ( keys[end] == keys[i] ) )
+			{
+				end++;
+			}
+
+			if( ( end - i ) > 1 )
+			{
+				sized.push_back( { keys[i], size, end - i } );
+			}
+
+			i = end;
+		}
+
+		const size_t n = std::min( aPerSize, sized.size() );
+
+		std::partial_sort( sized.begin(),
+											 sized.begin() + (ptrdiff_t)n,
+											 sized.end(),
+											 []( const sTRAIN_candidate &aA, const sTRAIN_candidate &aB ) { return aA.count > aB.count; } );
+
+		all.insert( all.end(), sized.begin(), sized.begin() + (ptrdiff_t)n );
+		sized.clear();
+	}
+
+	return all;
+}
+
+/// Uniform sample of the frames (reservoir), used to select the words
+class cTRAIN_sample
+{
+public:
+	explicit cTRAIN_sample( size_t aSlots ) : m_slots( aSlots ), m_seen( 0 ), m_rng( 0x5EED ) {}
+
+	void offer( const uint8_t *aFrame, size_t aSize )
+	{
+		m_seen++;
+
+		if( m_frames.size() < m_slots )
+		{
+			m_frames.emplace_back( aFrame, aFrame + aSize );
+			return;
+		}
+
+		const uint64_t slot = m_rng() % m_seen;
+
+		if( slot < m_slots )
+		{
+			m_frames[slot].assign( aFrame, aFrame + aSize );
+		}
+	}
+
+	const std::vector<std::vector<uint8_t>> &frames() const
+	{
+		return m_frames;
+	}
+
+private:
+	size_t m_slots;
+	uint64_t m_seen;
+	std::mt19937_64 m_rng;
+	std::vector<std::vector<uint8_t>> m_frames;
+};
+
+/**
+ * @brief Selects the words, from the candidates, that give the smallest
+ *        encoded size of the sample frames.
+ *        A word only changes the cost of the frames where it is found, so
+ *        the gain of a candidate is measured encoding only those frames.
+ */
+class cTRAIN_selector
+{
+public:
+	cTRAIN_selector( const std::vector<std::vector<uint8_t>> &aFrames, const std::vector<sTRAIN_candidate> &aCandidates )
+	 : m_frames( aFrames ), m_candidates( aCandidates ), m_isSelected( aCandidates.size(), 0 ),
+		 m_frameBegin( aFrames.size() + 1, 0 ), m_positionsOf( aCandidates.size() ), m_framesOf( aCandidates.size() ),
+		 m_frameCost( aFrames.size(), 0 ), m_cost( 0 ), m_selectedCount( 0 )
+	{
+		std::unordered_map<uint64_t, uint32_t> index;
+
+		for( size_t i = 0; i < m_candidates.size(); i++ )
+		{
+			index[map_key( m_candidates[i].key, m_candidates[i].size )] = (uint32_t)i;
+		}
+
+		for( size_t f = 0; f < m_frames.size(); f++ )
+		{
+			m_frameBegin[f + 1] = m_frameBegin[f] + m_frames[f].size();
+		}
+
+		m_selectedSizes.assign( m_frameBegin.back(), 0 );
+
+		for( size_t f = 0; f < m_frames.size(); f++ )
+		{
+			const std::vector<uint8_t> &frame = m_frames[f];
+
+			for( size_t pos = 0; pos < frame.size(); pos++ )
+			{
+				for( size_t size = TRAIN_MIN_WORD_SIZE; ( size <= TRAIN_MAX_WORD_SIZE ) && ( ( pos + size ) <= frame.size() );
+						 size++ )
+				{
+					const auto it = index.find( map_key( train_pack( &frame[pos], size ), size ) );
+
+					if( it == index.end() )
+					{
+						continue;
+					}
+
+					m_positionsOf[it->second].push_back( (uint32_t)( m_frameBegin[f] + pos ) );
+
+					std::vector<uint32_t> &framesOf = m_framesOf[it->second];
+
+					if( framesOf.empty() || ( framesOf.back() != f ) )
+					{
+						framesOf.push_back( (uint32_t)f );
+					}
+				}
+			}
+		}
+
+		for( size_t f = 0; f < m_frames.size(); f++ )
+		{
+			m_frameCost[f] = frame_cost( f );
+			m_cost += m_frameCost[f];
+		}
+	}
+
+	void run( size_t aMaxWords )
+	{
+		for( size_t round = 0; round < TRAIN_SELECTION_ROUNDS; round++ )
+		{
+			add_words( aMaxWords );
+
+			if( !remove_words() )
+			{
+				break;
+			}
+		}
+
+		fill_word_sizes( aMaxWords );
+	}
+
+	/// Encoded size of the sample (frames without delimiters) with the selected words
+	size_t cost() const
+	{
+		return m_cost;
+	}
+
+	std::vector<sTRAIN_candidate> selected() const
+	{
+		std::vector<sTRAIN_candidate> words;
+
+		for( size_t i = 0; i < m_candidates.size(); i++ )
+		{
+			if( m_isSelected[i] )
+			{
+				words.push_back( m_candidates[i] );
+			}
+		}
+
+		return words;
+	}
+
+private:
+	typedef enum e_TRAIN_previous
+	{
+		TRAIN_PREVIOUS_ZERO,
+		TRAIN_PREVIOUS_BLOCK,
+		TRAIN_PREVIOUS_DICTIONARY,
+	} eTRAIN_previous;
+
+	typedef struct s_TRAIN_bound
+	{
+		int64_t gain;
+		uint32_t candidate;
+		uint32_t stamp; ///< Words selected when the gain was measured
+
+		bool operator<( const s_TRAIN_bound &aOther ) const
+		{
+			return gain < aOther.gain;
+		}
+	} sTRAIN_bound;
+
+	static uint64_t map_key( uint64_t aKey, size_t aSize )
+	{
+		return aKey | ( (uint64_t)aSize << 48 );
+	}
+
+	static size_t size_bit( size_t aSize )
+	{
+		return (size_t)1 << ( aSize - TRAIN_MIN_WORD_SIZE );
+	}
+
+	// Model of dzrcobs_encode_inc_dictionary, size of the frame (header included)
+	size_t frame_cost( size_t aFrame ) const
+	{
+		const std::vector<uint8_t> &frame = m_frames[aFrame];
+		const uint8_t *pSelectedSizes			= &m_selectedSizes[m_frameBegin[aFrame]];
+
+		eTRAIN_previous previous = TRAIN_PREVIOUS_ZERO;
+		bool isFirst						 = true;
+		size_t code							 = 1;
+		size_t cost							 = 0;
+
+		for( size_t pos = 0; pos < frame.size(); )
+		{
+			const unsigned selectedSizes = pSelectedSizes[pos];
+
+			if( selectedSizes != 0 )
+			{
+				// The shortest word, as dzrcobs_dictionary_search
+				const size_t wordSize = s_TRAIN_ShortestSize[selectedSizes];
+
+				// The block before the word is closed by its code
+				if( previous != TRAIN_PREVIOUS_DICTIONARY )
+				{
+					cost += isFirst ? 0 : 1;
+					code = 1;
+				}
+
+				cost++;
+				previous = TRAIN_PREVIOUS_DICTIONARY;
+				isFirst	 = false;
+				pos += wordSize;
+				continue;
+			}
+
+			if( frame[pos++] == 0x00 )
+			{
+				if( previous != TRAIN_PREVIOUS_DICTIONARY )
+				{
+					cost++;
+					isFirst = false;
+				}
+
+				code		 = 1;
+				previous = TRAIN_PREVIOUS_ZERO;
+			}
+			else
+			{
+				cost++;
+				isFirst	 = false;
+				previous = TRAIN_PREVIOUS_BLOCK;
+
+				if( ++code == DZRCOBS_CODE_JUMP )
+				{
+					cost++;
+					code = 1;
+				}
+			}
+		}
+
+		return cost + ( ( previous != TRAIN_PREVIOUS_DICTIONARY ) ? 1 : 0 ) + DZRCOBS_FRAME_HEADER_SIZE;
+	}
+
+	void set_selected( size_t aCandidate, bool aIsSelected )
+	{
+		if( ( m_isSelected[aCandidate] != 0 ) != aIsSelected )
+		{
+			const uint8_t bit = (uint8_t)size_bit( m_candidates[aCandidate].size );
+
+			for( const uint32_t position : m_positionsOf[aCandidate] )
+			{
+				m_selectedSizes[position] ^= bit;
+			}
+
+			m_isSelected[aCandidate] = aIsSelected ? 1 : 0;
+			m_selectedCount += aIsSelected ? 1 : -1;
+		}
+	}
+
+	// Bytes saved by toggling aCandidate, the frame costs are updated if aCommit
+	int64_t toggle_gain( size_t aCandidate, bool aCommit )
+	{
+		int64_t gain = 0;
+
+		set_selected( aCandidate, !m_isSelected[aCandidate] );
+
+		for( const uint32_t f : m_framesOf[aCandidate] )
+		{
+			const size_t cost = frame_cost( f );
+
+			gain += (int64_t)m_frameCost[f] - (int64_t)cost;
+
+			if( aCommit )
+			{
+				m_frameCost[f] = cost;
+			}
+		}
+
+		if( aCommit )
+		{
+			m_cost = (size_t)( (int64_t)m_cost - gain );
+		}
+		else
+		{
+			set_selected( aCandidate, !m_isSelected[aCandidate] );
+		}
+
+		return gain;
+	}
+
+	// Lazy greedy: the candidates are measured again only when they may be the best
+	void add_words( size_t aMaxWords )
+	{
+		std::priority_queue<sTRAIN_bound> bounds;
+
+		for( size_t i = 0; i < m_candidates.size(); i++ )
+		{
+			if( !m_isSelected[i] && ( m_positionsOf[i].size() > 1 ) )
+			{
+				// A word saves at most its size plus a code byte and a zero after it
+				bounds.push( { (int64_t)( m_positionsOf[i].size() * ( m_candidates[i].size + 1 ) ), (uint32_t)i, UINT32_MAX } );
+			}
+		}
+
+		while( ( m_selectedCount < aMaxWords ) && !bounds.empty() )
+		{
+			sTRAIN_bound top = bounds.top();
+
+			bounds.pop();
+
+			if( top.gain <= 0 )
+			{
+				break;
+			}
+
+			if( top.stamp == m_selectedCount )
+			{
+				toggle_gain( top.candidate, true );
+				continue;
+			}
+
+			top.gain	= toggle_gain( top.candidate, false );
+			top.stamp = (uint32_t)m_selectedCount;
+
+			bounds.push( top );
+		}
+	}
+
+	// Removes the words that do not save anything with the others selected, true if any
+	bool remove_words()
+	{
+		bool removed = false;
+
+		for( size_t i = 0; i < m_candidates.size(); i++ )
+		{
+			if( m_isSelected[i] && ( toggle_gain( i, false ) >= 0 ) )
+			{
+				toggle_gain( i, true );
+				removed = true;
+			}
+		}
+
+		return removed;
+	}
+
+	// The best candidate to toggle with aIsSelected (and of aSize, if not 0)
+	size_t best_toggle( bool aIsSelected, size_t aSize )
+	{
+		size_t best					= m_candidates.size();
+		int64_t bestGain = INT64_MIN;
+
+		for( size_t i = 0; i < m_candidates.size(); i++ )
+		{
+			if( ( ( m_isSelected[i] != 0 ) == aIsSelected ) && ( ( aSize == 0 ) || ( m_candidates[i].size == aSize ) ) )
+			{
+				const int64_t gain = toggle_gain( i, false );
+
+				if( gain > bestGain )
+				{
+					best		 = i;
+					bestGain = gain;
+				}
+			}
+		}
+
+		return best;
+	}
+
+	// dzrcobs_dictionary_init wants the word sizes from 2 up to the longest
+	// one, without missing sizes in between, so the best word of those is added
+	void fill_word_sizes( size_t aMaxWords )
+	{
+		size_t longest = 0;
+
+		for( size_t i = 0; i < m_candidates.size(); i++ )
+		{
+			longest = m_isSelected[i] ? std::max( longest, m_candidates[i].size ) : longest;
+		}
+
+		for( size_t size = TRAIN_MIN_WORD_SIZE; size < longest; size++ )
+		{
+			bool isMissing = true;
+
+			for( size_t i = 0; i < m_candidates.size(); i++ )
+			{
+				isMissing = isMissing && !( m_isSelected[i] && ( m_candidates[i].size == size ) );
+			}
+
+			if( !isMissing )
+			{
+				continue;
+			}
+
+			// A longer word has all its prefixes repeated, so there is a candidate
+			const size_t added = best_toggle( false, size );
+
+			if( added == m_candidates.size() )
+			{
+				continue;
+			}
+
+			toggle_gain( added, true );
+
+			if( m_selectedCount > aMaxWords )
+			{
+				// The one that saves less, not the one just added
+				set_selected( added, false );
+				const size_t removed = best_toggle( true, 0 );
+				set_selected( added, true );
+
+				toggle_gain( removed, true );
+			}
+		}
+	}
+
+	const std::vector<std::vector<uint8_t>> &m_frames;
+	const std::vector<sTRAIN_candidate> &m_candidates;
+	std::vector<uint8_t> m_isSelected;
+	std::vector<size_t> m_frameBegin;		///< Position of the first byte of each frame
+	std::vector<uint8_t> m_selectedSizes; ///< Sizes (one bit each) of the selected words on each position
+	std::vector<std::vector<uint32_t>> m_positionsOf;
+	std::vector<std::vector<uint32_t>> m_framesOf;
+	std::vector<size_t> m_frameCost;
+	size_t m_cost;
+	size_t m_selectedCount;
+};
+
+// DICT_ADD_WORD format: size (as a digit) and the word, by size and then by value
+static std::string train_dictionary_blob( std::vector<sTRAIN_candidate> &aWords )
+{
+	std::sort( aWords.begin(), aWords.end(), []( const sTRAIN_candidate &aA, const sTRAIN_candidate &aB ) {
+		return ( aA.size != aB.size ) ? ( aA.size < aB.size ) : ( aA.key < aB.key );
+	} );
+
+	std::string blob;
+
+	for( const sTRAIN_candidate &word : aWords )
+	{
+		blob.push_back( (char)( '0' + word.size ) );
+
+		for( size_t i = word.size; i > 0; i-- )
+		{
+			blob.push_back( (char)( ( word.key >> ( 8 * ( i - 1 ) ) ) & 0xFF ) );
+		}
+	}
+
+	// As sizeof() of the string literal
+	blob.push_back( '\0' );
+
+	return blob;
+}
+
+// Encoded size of the frames by the real encoder, delimiters not included. 0 on error.
+static size_t train_encoded_size( const std::vector<std::vector<uint8_t>> &aFrames,
+																	eDZRCOBS_encoding aEncoding,
+																	const sDICT_ctx *aDict )
+{
+	std::vector<sDZRCOBS_batch_entry> entries;
+	size_t dstSize = 0;
+
+	for( const std::vector<uint8_t> &frame : aFrames )
+	{
+		entries.push_back( { frame.data(), frame.size(), TRAIN_USER6BITS } );
+		dstSize += DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( frame.size() ) + DZRCOBS_FRAME_HEADER_SIZE + 1;
+	}
+
+	std::vector<uint8_t> dst( dstSize );
+	std::vector<size_t> offsets( entries.size() + 1 );
+	size_t framesEncoded = 0;
+
+	sDZRCOBS_ctx ctx;
+
+	if( aDict != nullptr )
+	{
+		dzrcobs_encode_set_dictionary( &ctx, aDict, aEncoding );
+	}
+
+	if( dzrcobs_encode_batch(
+			 &ctx, aEncoding, entries.data(), entries.size(), dst.data(), dst.size(), offsets.data(), &framesEncoded ) !=
+			DZRCOBS_RET_SUCCESS )
+	{
+		return 0;
+	}
+
+	return offsets[entries.size()] - entries.size();
+}
+
+static void train_write_word( FILE *aFile, const sTRAIN_candidate &aWord )
+{
+	bool isText = true;
+
+	for( size_t i = 0; i < aWord.size; i++ )
+	{
+		const uint8_t byte = (uint8_t)( aWord.key >> ( 8 * ( aWord.size - 1 - i ) ) );
+
+		isText = isText && ( byte >= 0x20 ) && ( byte < 0x7F );
+	}
+
+	fprintf( aFile, "\tDICT_ADD_WORD(%zu, \"", aWord.size );
+
+	for( size_t i = 0; i < aWord.size; i++ )
+	{
+		const uint8_t byte = (uint8_t)( aWord.key >> ( 8 * ( aWord.size - 1 - i ) ) );
+
+		if( !isText )
+		{
+			// All as hex, so a hex digit never follows an escape
+			fprintf( aFile, "\\x%02X", byte );
+		}
+		else if( ( byte == '"' ) || ( byte == '\\' ) || ( byte == '?' ) )
+		{
+			fprintf( aFile, "\\%c", byte );
+		}
+		else
+		{
+			fputc( byte, aFile );
+		}
+	}
+
+	fprintf( aFile, "\")\n" );
+}
+
+static bool train_write_source( const sTRAIN_options &aOptions,
+																const std::vector<sTRAIN_candidate> &aWords,
+																uint64_t aBytesRead,
+																size_t aSampleSize,
+																size_t aPlainSize,
+																size_t aEncodedSize )
+{
+	FILE *pFile = ( aOptions.pOutput != nullptr ) ? fopen( aOptions.pOutput, "w" ) : stdout;
+
+	if( pFile == nullptr )
+	{
+		fprintf( stderr, "Can not create %s\n", aOptions.pOutput );
+		return false;
+	}
+
+	const char *pFileName = ( aOptions.pOutput != nullptr ) ? aOptions.pOutput : "dictionary.c";
+	const char *pSlash		= strrchr( pFileName, '/' );
+
+	fprintf( pFile,
+					 "// /////////////////////////////////////////////////////////////////////////////\n"
+					 "///\t@file %s\n"
+					 "///\t@brief Dictionary trained by dzrcobs_dict_train on %llu bytes of samples.\n"
+					 "/// %zu words. On a sample of %zu bytes, %zu bytes encoded (%zu with DZRCOBS_PLAIN).\n"
+					 "///\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n\n"
+					 "// Includes\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n"
+					 "#include <dzrcobs/dzrcobs_dictionary.h>\n\n"
+					 "// clang-format off\n\n"
+					 "const char %s[] =\n",
+					 ( pSlash != nullptr ) ? ( pSlash + 1 ) : pFileName,
+					 (unsigned long long)aBytesRead,
+					 aWords.size(),
+					 aSampleSize,
+					 aEncodedSize,
+					 aPlainSize,
+					 aOptions.pName );
+
+	for( const sTRAIN_candidate &word : aWords )
+	{
+		train_write_word( pFile, word );
+	}
+
+	fprintf( pFile,
+					 ";\n\n"
+					 "// clang-format on\n\n"
+					 "const size_t %s_size = sizeof( %s );\n\n"
+					 "// EOF\n"
+					 "// /////////////////////////////////////////////////////////////////////////////\n",
+					 aOptions.pName,
+					 aOptions.pName );
+
+	const bool isWritten = ( ferror( pFile ) == 0 );
+
+	if( pFile != stdout )
+	{
+		fclose( pFile );
+	}
+
+	return isWritten;
+}
+
+static void train_usage( const char *aProgram )
+{
+	fprintf( stderr,
+					 "usage: %s [options] <sample files...>\n"
+					 "  -o <file>            output C file (default stdout)\n"
+					 "  --name <symbol>      dictionary symbol (default " TRAIN_DEFAULT_NAME ")\n"
+					 "  --frame-size <n>     the samples are split in frames of n bytes (default %d)\n"
+					 "  --sample-size <n>    bytes of frames used to select the words (default %d)\n"
+					 "  --max-words <n>      at most n words, up to %d (default %d)\n",
+					 aProgram,
+					 TRAIN_DEFAULT_FRAME_SIZE,
+					 TRAIN_DEFAULT_SAMPLE_SIZE,
+					 DICT_MAX_WORDS,
+					 DICT_MAX_WORDS );
+}
+
+static bool train_parse_size( const char *aText, size_t *aOutValue )
+{
+	char *pEnd					= nullptr;
+	const long long value = strtoll( aText, &pEnd, 0 );
+
+	if( ( pEnd == aText ) || ( *pEnd != '\0' ) || ( value <= 0 ) )
+	{
+		return false;
+	}
+
+	*aOutValue = (size_t)value;
+
+	return true;
+}
+
+static bool train_parse_options( int argc, char **argv, sTRAIN_options *aOutOptions )
+{
+	sTRAIN_options options = { {}, nullptr, TRAIN_DEFAULT_NAME, TRAIN_DEFAULT_FRAME_SIZE, TRAIN_DEFAULT_SAMPLE_SIZE, DICT_MAX_WORDS };
+
+	for( int i = 1; i < argc; i++ )
+	{
+		const bool hasValue = ( i + 1 ) < argc;
+
+		if( ( strcmp( argv[i], "-o" ) == 0 ) && hasValue )
+		{
+			options.pOutput = argv[++i];
+		}
+		else if( ( strcmp( argv[i], "--name" ) == 0 ) && hasValue )
+		{
+			options.pName = argv[++i];
+		}
+		else if( ( strcmp( argv[i], "--frame-size" ) == 0 ) && hasValue )
+		{
+			if( !train_parse_size( argv[++i], &options.frameSize ) )
+			{
+				return false;
+			}
+		}
+		else if( ( strcmp( argv[i], "--sample-size" ) == 0 ) && hasValue )
+		{
+			if( !train_parse_size( argv[++i], &options.sampleSize ) )
+			{
+				return false;
+			}
+		}
+		else if( ( strcmp( argv[i], "--max-words" ) == 0 ) && hasValue )
+		{
+			if( !train_parse_size( argv[++i], &options.maxWords ) || ( options.maxWords > DICT_MAX_WORDS ) )
+			{
+				return false;
+			}
+		}
+		else if( argv[i][0] == '-' )
+		{
+			return false;
+		}
+		else
+		{
+			options.inputs.push_back( argv[i] );
+		}
+	}
+
+	*aOutOptions = options;
+
+	return !options.inputs.empty();
+}
+
+int main( int argc, char **argv )
+{
+	using clock = std::chrono::steady_clock;
+
+	sTRAIN_options options;
+
+	if( !train_parse_options( argc, argv, &options ) )
+	{
+		train_usage( argv[0] );
+		return 1;
+	}
+
+	// Read all the samples once
+	const clock::time_point readStart = clock::now();
+
+	cTRAIN_sample sample( std::max( (size_t)1, options.sampleSize / options.frameSize ) );
+	std::vector<uint8_t> chunk( TRAIN_READ_CHUNK_SIZE );
+	uint64_t bytesRead = 0;
+
+	for( const char *pInput : options.inputs )
+	{
+		FILE *pFile = fopen( pInput, "rb" );
+
+		if( pFile == nullptr )
+		{
+			fprintf( stderr, "Can not open %s\n", pInput );
+			return 1;
+		}
+
+		std::vector<uint8_t> frame;
+		size_t readSize;
+
+		frame.reserve( options.frameSize );
+
+		while( ( readSize = fread( chunk.data(), 1, chunk.size(), pFile ) ) > 0 )
+		{
+			bytesRead += readSize;
+
+			for( size_t pos = 0; pos < readSize; )
+			{
+				const size_t take = std::min( options.frameSize - frame.size(), readSize - pos );
+
+				frame.insert( frame.end(), &chunk[pos], &chunk[pos] + take );
+				pos += take;
+
+				if( frame.size() == options.frameSize )
+				{
+					sample.offer( frame.data(), frame.size() );
+					frame.clear();
+				}
+			}
+		}
+
+		// The last frame of each file can be shorter
+		if( !frame.empty() )
+		{
+			sample.offer( frame.data(), frame.size() );
+		}
+
+		fclose( pFile );
+	}
+
+	const double readSeconds = std::chrono::duration<double>( clock::now() - readStart ).count();
+
+	fprintf( stderr,
+					 "Read %llu bytes in %.1f s (%.1f MB/s)\n",
+					 (unsigned long long)bytesRead,
+					 readSeconds,
+					 (double)bytesRead / ( readSeconds * 1e6 ) );
+
+	if( bytesRead == 0 )
+	{
+		fprintf( stderr, "No sample data\n" );
+		return 1;
+	}
+
+	// Select the words on the sample
+	const clock::time_point selectStart = clock::now();
+
+	const std::vector<sTRAIN_candidate> candidates = train_candidates( sample.frames(), TRAIN_CANDIDATES_PER_SIZE );
+	const std::vector<std::vector<uint8_t>> &frames = sample.frames();
+
+	size_t sampleSize = 0;
+
+	for( const std::vector<uint8_t> &frame : frames )
+	{
+		sampleSize += frame.size();
+	}
+
+	cTRAIN_selector selector( frames, candidates );
+
+	selector.run( options.maxWords );
+
+	std::vector<sTRAIN_candidate> words = selector.selected();
+
+	fprintf( stderr,
+					 "Selected %zu words from %zu candidates in %.1f s\n",
+					 words.size(),
+					 candidates.size(),
+					 std::chrono::duration<double>( clock::now() - selectStart ).count() );
+
+	if( words.empty() )
+	{
+		fprintf( stderr, "No word makes the samples smaller, no dictionary written\n" );
+		return 1;
+	}
+
+	// Check it as the library will see it
+	const std::string blob = train_dictionary_blob( words );
+	sDICT_ctx dict;
+
+	if( ( dzrcobs_dictionary_isvalid( blob.data(), blob.size() ) != DICT_IS_VALID ) ||
+			( dzrcobs_dictionary_init( &dict, blob.data(), blob.size() ) != DICT_RET_SUCCESS ) )
+	{
+		fprintf( stderr, "The dictionary is not valid\n" );
+		return 1;
+	}
+
+	const size_t plainSize	 = train_encoded_size( frames, DZRCOBS_PLAIN, nullptr );
+	const size_t encodedSize = train_encoded_size( frames, DZRCOBS_USING_DICT_1, &dict );
+
+	fprintf( stderr,
+					 "Sample of %zu bytes: %zu bytes encoded (model %zu), %zu with DZRCOBS_PLAIN\n",
+					 sampleSize,
+					 encodedSize,
+					 selector.cost(),
+					 plainSize );
+
+	if( encodedSize != selector.cost() )
+	{
+		fprintf( stderr, "Warning: the model does not match the encoder\n" );
+	}
+
+	// The dictionary encodings jump each 62 bytes, so on data without
+	// repetitions they can be larger than DZRCOBS_PLAIN
+	if( encodedSize >= plainSize )
+	{
+		fprintf( stderr, "The dictionary does not make the samples smaller than DZRCOBS_PLAIN, no dictionary written\n" );
+		return 1;
+	}
+
+	return train_write_source( options, words, bytesRead, sampleSize, plainSize, encodedSize ) ? 0 : 1;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
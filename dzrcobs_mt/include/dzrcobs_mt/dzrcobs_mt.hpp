@@ -0,0 +1,87 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_mt.hpp
+///	@brief Multi-threaded batch encode and decode declarations
+///
+///	@par  Plataform Target:	Any with C++17 threads
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZRCOBS_MT_HPP_
+#define _DZRCOBS_MT_HPP_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_decode.h>
+#include "dzrcobs_mt_pool.hpp"
+
+// Declarations
+// /////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Same as dzrcobs_encode_batch, with the messages spread over the
+ *        threads of aPool. The frames, and aOutOffsets, are in the same order
+ *        as the entries.
+ *        Groups of messages are encoded by the workers on their own buffers
+ *        and then copied, in parallel, to their place on aDstBuf. So it needs
+ *        extra memory of about the size of the encoded data.
+ *        On overflow it encodes all the frames that fit, that may be more than
+ *        dzrcobs_encode_batch as it checks for the worst case of a frame.
+ *
+ * @param aPool Threads to use
+ * @param aCtx Only its dictionaries (dzrcobs_encode_set_dictionary) are used, it is not changed
+ * @param aEncoding The desired encoding for all the frames
+ * @param aEntries Messages to encode
+ * @param aEntriesCount Number of messages
+ * @param aDstBuf Destiny buffer
+ * @param aDstBufSize Max buffer size
+ * @param aOutOffsets Array of aEntriesCount + 1 entries, see dzrcobs_encode_batch
+ * @param aOutFramesEncoded Number of frames encoded, complete on aDstBuf
+ * @return same as dzrcobs_encode_batch
+ */
+eDZRCOBS_ret dzrcobs_mt_encode_batch( cDZRCOBS_mt_pool &aPool,
+																			const sDZRCOBS_ctx *aCtx,
+																			eDZRCOBS_encoding aEncoding,
+																			const sDZRCOBS_batch_entry *aEntries,
+																			size_t aEntriesCount,
+																			uint8_t *aDstBuf,
+																			size_t aDstBufSize,
+																			size_t *aOutOffsets,
+																			size_t *aOutFramesEncoded );
+
+/**
+ * @brief Same as dzrcobs_decode_batch, with the frames spread over the threads
+ *        of aPool. The results are in the same order as the frames.
+ *        The frames buffer is split on delimiters, the decoded size of each
+ *        part is computed first (codes walk only) and then each part decodes
+ *        straight to its place on the arena, so no extra memory is used.
+ *        As the CRC is not checked by the walk, a frame that fails on it
+ *        leaves its size unused on the arena. When the arena is too small,
+ *        the frames that have no room on it get DZRCOBS_RET_ERR_OVERFLOW.
+ *
+ * @param aPool Threads to use
+ * @param aDecodeCtx Frames, arena and dictionaries, see dzrcobs_decode_batch
+ * @param aOutResults Array of results, one per frame
+ * @param aResultsSize Number of entries of aOutResults
+ * @param aOutResultsCount Number of results written
+ * @param aOutConsumed Bytes of the frames buffer used
+ * @return same as dzrcobs_decode_batch
+ */
+eDZRCOBS_ret dzrcobs_mt_decode_batch( cDZRCOBS_mt_pool &aPool,
+																			const sDZRCOBS_decodectx *aDecodeCtx,
+																			sDZRCOBS_batch_result *aOutResults,
+																			size_t aResultsSize,
+																			size_t *aOutResultsCount,
+																			size_t *aOutConsumed );
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
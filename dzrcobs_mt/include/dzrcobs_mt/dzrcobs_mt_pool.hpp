@@ -0,0 +1,102 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_mt_pool.hpp
+///	@brief Work stealing thread pool used by the multi-threaded batches
+///
+///	@par  Plataform Target:	Any with C++17 threads
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+#ifndef _DZRCOBS_MT_POOL_HPP_
+#define _DZRCOBS_MT_POOL_HPP_
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Data written by different threads is aligned to this, so it never shares a cache line
+#define DZRCOBS_MT_CACHE_LINE_SIZE ( 64 )
+
+/**
+ * @brief Fixed set of threads that run the tasks 0..N-1 of a job.
+ *        Each worker starts with a contiguous range of the tasks and, when it
+ *        runs out of them, steals from the end of the range of other workers.
+ *        The thread calling run() is the worker 0, so a pool of 1 thread
+ *        runs everything on the caller.
+ */
+class cDZRCOBS_mt_pool
+{
+public:
+	/// Task function, called with the task index and the index of the worker running it
+	using tTask = std::function<void( size_t aTask, size_t aWorker )>;
+
+	/**
+	 * @brief Starts the workers
+	 *
+	 * @param aThreadsCount Number of threads, the caller included. 0 uses
+	 *        std::thread::hardware_concurrency()
+	 */
+	explicit cDZRCOBS_mt_pool( size_t aThreadsCount = 0 );
+	~cDZRCOBS_mt_pool();
+
+	cDZRCOBS_mt_pool( const cDZRCOBS_mt_pool & )						= delete;
+	cDZRCOBS_mt_pool &operator=( const cDZRCOBS_mt_pool & ) = delete;
+
+	/// Number of workers, the caller thread included
+	size_t threads_count() const { return workers.size(); }
+
+	/**
+	 * @brief Runs aTask for all the task indexes 0..aTasksCount-1 and returns
+	 *        when all are done. The tasks must not throw. Not reentrant, a
+	 *        task cannot call run() on the same pool.
+	 *
+	 * @param aTasksCount Number of tasks
+	 * @param aTask Function to run
+	 */
+	void run( size_t aTasksCount, const tTask &aTask );
+
+private:
+	struct alignas( DZRCOBS_MT_CACHE_LINE_SIZE ) sWorker
+	{
+		std::mutex mutex;
+		size_t next; ///< Next task to run by this worker
+		size_t end;	 ///< One after the last task of this worker, thieves take from here
+	};
+
+	void thread_loop( size_t aWorker );
+	void work( size_t aWorker, const tTask &aTask );
+	bool pop( size_t aWorker, size_t *aOutTask );
+	bool steal( size_t aWorker, size_t *aOutTask );
+
+	std::unique_ptr<sWorker[]> workersState;
+	std::vector<std::thread> workers; ///< workers[0] is not started, it is the caller
+
+	std::mutex mutex;
+	std::condition_variable startCondition;
+	std::condition_variable doneCondition;
+	const tTask *pTask;
+	uint64_t generation; ///< Incremented on each job
+	size_t busyThreads;	 ///< Threads that did not finish the current job yet
+	bool isStopping;
+};
+
+#endif
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
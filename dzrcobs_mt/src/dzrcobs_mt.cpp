@@ -0,0 +1,400 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_mt.cpp
+///	@brief Multi-threaded batch encode and decode
+///
+///	@par  Plataform Target:	Any with C++17 threads
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzrcobs_mt/dzrcobs_mt.hpp>
+#include <cstring>
+#include <memory>
+#include <new>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Tasks per thread, more than one so there is something left to steal
+#define DZRCOBS_MT_TASKS_PER_THREAD ( 16 )
+
+// Smaller batches than this are not worth splitting
+#define DZRCOBS_MT_MIN_ENTRIES_PER_TASK ( 256 )
+#define DZRCOBS_MT_MIN_BYTES_PER_TASK ( 64 * 1024 )
+
+namespace
+{
+
+// A group of messages, encoded by a worker on its own buffer
+struct alignas( DZRCOBS_MT_CACHE_LINE_SIZE ) sEncodeGroup
+{
+	size_t firstEntry;
+	size_t entriesCount;
+
+	std::unique_ptr<uint8_t[]> buf;
+	std::unique_ptr<size_t[]> offsets; ///< Frame offsets on buf, entriesCount + 1
+	size_t framesEncoded;
+	eDZRCOBS_ret ret;
+
+	size_t dstOffset;		 ///< Where the group goes on the destiny buffer
+	size_t framesToCopy; ///< Frames of the group that fit on the destiny buffer
+};
+
+// A part of the frames buffer, split on a delimiter
+struct alignas( DZRCOBS_MT_CACHE_LINE_SIZE ) sDecodePart
+{
+	size_t begin;
+	size_t end;
+	size_t framesCount; ///< Non empty frames, each one takes a result
+	size_t decodedSize;
+
+	size_t firstResult;
+	size_t resultsSize;
+	size_t arenaOffset;
+	size_t arenaSize;
+
+	size_t resultsCount;
+	size_t consumed;
+	eDZRCOBS_ret ret;
+};
+
+size_t dzrcobs_mt_tasks_count( size_t aItems, size_t aMinItemsPerTask, size_t aThreadsCount )
+{
+	const size_t maxTasks = aThreadsCount * DZRCOBS_MT_TASKS_PER_THREAD;
+	const size_t tasks		= ( aItems + aMinItemsPerTask - 1 ) / aMinItemsPerTask;
+
+	return ( tasks < maxTasks ) ? tasks : maxTasks;
+}
+
+// First position after a delimiter, at or after aPos
+size_t dzrcobs_mt_next_frame_start( const uint8_t *aSrc, size_t aSrcLen, size_t aPos )
+{
+	if( aPos == 0 )
+	{
+		return 0;
+	}
+
+	const void *pDelimiter = std::memchr( aSrc + aPos - 1, 0x00, aSrcLen - ( aPos - 1 ) );
+
+	return ( pDelimiter == nullptr ) ? aSrcLen : (size_t)( static_cast<const uint8_t *>( pDelimiter ) - aSrc ) + 1;
+}
+
+} // namespace
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+eDZRCOBS_ret dzrcobs_mt_encode_batch( cDZRCOBS_mt_pool &aPool,
+																			const sDZRCOBS_ctx *aCtx,
+																			eDZRCOBS_encoding aEncoding,
+																			const sDZRCOBS_batch_entry *aEntries,
+																			size_t aEntriesCount,
+																			uint8_t *aDstBuf,
+																			size_t aDstBufSize,
+																			size_t *aOutOffsets,
+																			size_t *aOutFramesEncoded )
+{
+	if( ( !aCtx ) || ( ( !aEntries ) && ( aEntriesCount > 0 ) ) || ( !aDstBuf ) || ( !aOutOffsets ) ||
+			( !aOutFramesEncoded ) || ( aEncoding == DZRCOBS_RESERVED ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
+	if( ( aEncoding != DZRCOBS_PLAIN ) && ( aCtx->pDict[aEncoding - DZRCOBS_USING_DICT_1] == nullptr ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
+	const size_t groupsCount =
+	 dzrcobs_mt_tasks_count( aEntriesCount, DZRCOBS_MT_MIN_ENTRIES_PER_TASK, aPool.threads_count() );
+
+	if( groupsCount <= 1 )
+	{
+		sDZRCOBS_ctx ctx = *aCtx;
+
+		return dzrcobs_encode_batch(
+		 &ctx, aEncoding, aEntries, aEntriesCount, aDstBuf, aDstBufSize, aOutOffsets, aOutFramesEncoded );
+	}
+
+	std::unique_ptr<sEncodeGroup[]> groups( new sEncodeGroup[groupsCount] );
+
+	// Encode each group on its own buffer, sized for its worst case
+	aPool.run( groupsCount, [&]( size_t aTask, size_t ) {
+		sEncodeGroup &group = groups[aTask];
+
+		group.firstEntry		= ( aEntriesCount * aTask ) / groupsCount;
+		group.entriesCount	= ( ( aEntriesCount * ( aTask + 1 ) ) / groupsCount ) - group.firstEntry;
+		group.framesEncoded = 0;
+
+		const sDZRCOBS_batch_entry *pEntries = aEntries + group.firstEntry;
+
+		size_t bufSize = 0;
+
+		for( size_t i = 0; i < group.entriesCount; i++ )
+		{
+			bufSize += DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( pEntries[i].srcLen ) + DZRCOBS_FRAME_HEADER_SIZE + 1;
+		}
+
+		group.buf.reset( new( std::nothrow ) uint8_t[bufSize] );
+		group.offsets.reset( new( std::nothrow ) size_t[group.entriesCount + 1] );
+
+		if( ( !group.buf ) || ( !group.offsets ) )
+		{
+			group.ret = DZRCOBS_RET_ERR_OVERFLOW;
+			return;
+		}
+
+		// Each worker encodes with its own context, on its own stack
+		sDZRCOBS_ctx ctx = *aCtx;
+
+		group.ret = dzrcobs_encode_batch( &ctx,
+																			aEncoding,
+																			pEntries,
+																			group.entriesCount,
+																			group.buf.get(),
+																			bufSize,
+																			group.offsets.get(),
+																			&group.framesEncoded );
+	} );
+
+	// Place the groups, in order, up to the first one that fails or does not fit
+	eDZRCOBS_ret ret		 = DZRCOBS_RET_SUCCESS;
+	size_t dstOffset		 = 0;
+	size_t framesEncoded = 0;
+
+	for( size_t g = 0; g < groupsCount; g++ )
+	{
+		sEncodeGroup &group = groups[g];
+
+		group.dstOffset		 = dstOffset;
+		group.framesToCopy = 0;
+
+		if( ret != DZRCOBS_RET_SUCCESS )
+		{
+			continue;
+		}
+
+		size_t frames = group.framesEncoded;
+
+		while( ( frames > 0 ) && ( ( dstOffset + group.offsets[frames] ) > aDstBufSize ) )
+		{
+			frames--;
+		}
+
+		if( frames < group.framesEncoded )
+		{
+			ret = DZRCOBS_RET_ERR_OVERFLOW;
+		}
+		else
+		{
+			ret = group.ret;
+		}
+
+		group.framesToCopy = frames;
+		framesEncoded += frames;
+
+		if( frames > 0 )
+		{
+			dstOffset += group.offsets[frames];
+		}
+	}
+
+	aPool.run( groupsCount, [&]( size_t aTask, size_t ) {
+		sEncodeGroup &group = groups[aTask];
+
+		if( group.framesToCopy > 0 )
+		{
+			std::memcpy( aDstBuf + group.dstOffset, group.buf.get(), group.offsets[group.framesToCopy] );
+
+			// The end of the last frame is the start of the next group, it is written at the end
+			for( size_t i = 0; i < group.framesToCopy; i++ )
+			{
+				aOutOffsets[group.firstEntry + i] = group.dstOffset + group.offsets[i];
+			}
+		}
+
+		group.buf.reset();
+		group.offsets.reset();
+	} );
+
+	aOutOffsets[framesEncoded] = dstOffset;
+	*aOutFramesEncoded				 = framesEncoded;
+
+	return ret;
+}
+
+eDZRCOBS_ret dzrcobs_mt_decode_batch( cDZRCOBS_mt_pool &aPool,
+																			const sDZRCOBS_decodectx *aDecodeCtx,
+																			sDZRCOBS_batch_result *aOutResults,
+																			size_t aResultsSize,
+																			size_t *aOutResultsCount,
+																			size_t *aOutConsumed )
+{
+	if( ( !aDecodeCtx ) || ( ( !aDecodeCtx->srcBufEncoded ) && ( aDecodeCtx->srcBufEncodedLen > 0 ) ) ||
+			( !aDecodeCtx->dstBufDecoded ) || ( ( !aOutResults ) && ( aResultsSize > 0 ) ) || ( !aOutResultsCount ) ||
+			( !aOutConsumed ) )
+	{
+		return DZRCOBS_RET_ERR_BAD_ARG;
+	}
+
+	const uint8_t *pSrc = aDecodeCtx->srcBufEncoded;
+
+	// Only the complete frames are split, the bytes after the last delimiter are left
+	size_t completeLen = aDecodeCtx->srcBufEncodedLen;
+
+	while( ( completeLen > 0 ) && ( pSrc[completeLen - 1] != 0x00 ) )
+	{
+		completeLen--;
+	}
+
+	const size_t partsCount =
+	 dzrcobs_mt_tasks_count( completeLen, DZRCOBS_MT_MIN_BYTES_PER_TASK, aPool.threads_count() );
+
+	if( ( partsCount <= 1 ) || ( aResultsSize == 0 ) )
+	{
+		return dzrcobs_decode_batch( aDecodeCtx, aOutResults, aResultsSize, aOutResultsCount, aOutConsumed );
+	}
+
+	std::unique_ptr<sDecodePart[]> parts( new sDecodePart[partsCount] );
+
+	// Count the frames of each part and how much they decode to
+	aPool.run( partsCount, [&]( size_t aTask, size_t ) {
+		sDecodePart &part = parts[aTask];
+
+		part.begin			 = dzrcobs_mt_next_frame_start( pSrc, completeLen, ( completeLen * aTask ) / partsCount );
+		part.end				 = dzrcobs_mt_next_frame_start( pSrc, completeLen, ( completeLen * ( aTask + 1 ) ) / partsCount );
+		part.framesCount = 0;
+		part.decodedSize = 0;
+
+		sDZRCOBS_decodectx frameCtx = *aDecodeCtx;
+
+		size_t pos = part.begin;
+
+		while( pos < part.end )
+		{
+			const uint8_t *pFrame = pSrc + pos;
+			const size_t frameLen =
+			 (size_t)( static_cast<const uint8_t *>( std::memchr( pFrame, 0x00, part.end - pos ) ) - pFrame );
+
+			if( frameLen > 0 )
+			{
+				part.framesCount++;
+
+				frameCtx.srcBufEncoded		= pFrame;
+				frameCtx.srcBufEncodedLen = frameLen;
+
+				size_t decodedLen = 0;
+
+				// Frames that fail take no room on the arena
+				if( ( frameLen >= 3 ) && ( dzrcobs_decoded_size( &frameCtx, &decodedLen ) == DZRCOBS_RET_SUCCESS ) )
+				{
+					part.decodedSize += decodedLen;
+				}
+			}
+
+			pos += frameLen + 1;
+		}
+	} );
+
+	// Place the results and the decoded data of each part
+	const size_t arenaSize = aDecodeCtx->dstBufDecodedSize;
+
+	size_t resultsCount = 0;
+	size_t arenaOffset	= 0;
+	size_t consumed			= completeLen;
+
+	for( size_t p = 0; p < partsCount; p++ )
+	{
+		sDecodePart &part = parts[p];
+
+		part.firstResult = resultsCount;
+		part.resultsSize = 0;
+		part.arenaOffset = ( arenaOffset < arenaSize ) ? arenaOffset : arenaSize;
+		part.arenaSize	 = 0;
+
+		if( resultsCount < aResultsSize )
+		{
+			const size_t resultsLeft = aResultsSize - resultsCount;
+
+			part.resultsSize = ( part.framesCount < resultsLeft ) ? part.framesCount : resultsLeft;
+			part.arenaSize	 = arenaSize - part.arenaOffset;
+
+			if( part.decodedSize < part.arenaSize )
+			{
+				part.arenaSize = part.decodedSize;
+			}
+		}
+
+		resultsCount += part.framesCount;
+		arenaOffset += part.decodedSize;
+	}
+
+	aPool.run( partsCount, [&]( size_t aTask, size_t ) {
+		sDecodePart &part = parts[aTask];
+
+		part.resultsCount = 0;
+		part.consumed			= 0;
+		part.ret					= DZRCOBS_RET_SUCCESS;
+
+		if( part.resultsSize == 0 )
+		{
+			return;
+		}
+
+		sDZRCOBS_decodectx partCtx = *aDecodeCtx;
+
+		partCtx.srcBufEncoded			= pSrc + part.begin;
+		partCtx.srcBufEncodedLen	= part.end - part.begin;
+		partCtx.dstBufDecoded			= aDecodeCtx->dstBufDecoded + part.arenaOffset;
+		partCtx.dstBufDecodedSize = part.arenaSize;
+
+		sDZRCOBS_batch_result *pResults = aOutResults + part.firstResult;
+
+		part.ret = dzrcobs_decode_batch( &partCtx, pResults, part.resultsSize, &part.resultsCount, &part.consumed );
+
+		for( size_t i = 0; i < part.resultsCount; i++ )
+		{
+			pResults[i].offset += part.arenaOffset;
+		}
+	} );
+
+	eDZRCOBS_ret ret = DZRCOBS_RET_SUCCESS;
+
+	resultsCount = 0;
+
+	for( size_t p = 0; p < partsCount; p++ )
+	{
+		const sDecodePart &part = parts[p];
+
+		if( part.ret != DZRCOBS_RET_SUCCESS )
+		{
+			ret = part.ret;
+		}
+
+		resultsCount += part.resultsCount;
+
+		// The results array got full on this part, the batch stops there
+		if( ( part.resultsSize > 0 ) && ( part.firstResult + part.resultsSize == aResultsSize ) )
+		{
+			consumed = part.begin + part.consumed;
+			break;
+		}
+	}
+
+	*aOutResultsCount = resultsCount;
+	*aOutConsumed			= consumed;
+
+	return ret;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
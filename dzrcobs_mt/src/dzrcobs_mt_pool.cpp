@@ -0,0 +1,191 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file dzrcobs_mt_pool.cpp
+///	@brief Work stealing thread pool used by the multi-threaded batches
+///
+///	@par  Plataform Target:	Any with C++17 threads
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <dzrcobs_mt/dzrcobs_mt_pool.hpp>
+
+// Implementation
+// /////////////////////////////////////////////////////////////////////////////
+
+cDZRCOBS_mt_pool::cDZRCOBS_mt_pool( size_t aThreadsCount )
+		: pTask( nullptr )
+		, generation( 0 )
+		, busyThreads( 0 )
+		, isStopping( false )
+{
+	if( aThreadsCount == 0 )
+	{
+		aThreadsCount = std::thread::hardware_concurrency();
+
+		if( aThreadsCount == 0 )
+		{
+			aThreadsCount = 1;
+		}
+	}
+
+	workersState.reset( new sWorker[aThreadsCount] );
+
+	for( size_t i = 0; i < aThreadsCount; i++ )
+	{
+		workersState[i].next = 0;
+		workersState[i].end	 = 0;
+	}
+
+	workers.resize( aThreadsCount );
+
+	for( size_t i = 1; i < aThreadsCount; i++ )
+	{
+		workers[i] = std::thread( &cDZRCOBS_mt_pool::thread_loop, this, i );
+	}
+}
+
+cDZRCOBS_mt_pool::~cDZRCOBS_mt_pool()
+{
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		isStopping = true;
+	}
+
+	startCondition.notify_all();
+
+	for( size_t i = 1; i < workers.size(); i++ )
+	{
+		workers[i].join();
+	}
+}
+
+void cDZRCOBS_mt_pool::run( size_t aTasksCount, const tTask &aTask )
+{
+	if( aTasksCount == 0 )
+	{
+		return;
+	}
+
+	const size_t workersCount = workers.size();
+
+	// Contiguous ranges, so neighbour tasks (and their data) stay on the same worker
+	for( size_t i = 0; i < workersCount; i++ )
+	{
+		std::lock_guard<std::mutex> lock( workersState[i].mutex );
+		workersState[i].next = ( aTasksCount * i ) / workersCount;
+		workersState[i].end	 = ( aTasksCount * ( i + 1 ) ) / workersCount;
+	}
+
+	if( workersCount == 1 )
+	{
+		work( 0, aTask );
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		pTask				= &aTask;
+		busyThreads = workersCount - 1;
+		generation++;
+	}
+
+	startCondition.notify_all();
+
+	work( 0, aTask );
+
+	// Every thread sees each generation, as the next one only starts after this
+	std::unique_lock<std::mutex> lock( mutex );
+	doneCondition.wait( lock, [this] { return busyThreads == 0; } );
+	pTask = nullptr;
+}
+
+void cDZRCOBS_mt_pool::thread_loop( size_t aWorker )
+{
+	uint64_t seenGeneration = 0;
+
+	for( ;; )
+	{
+		const tTask *pCurTask = nullptr;
+
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+			startCondition.wait( lock, [&] { return isStopping || ( generation != seenGeneration ); } );
+
+			if( isStopping )
+			{
+				return;
+			}
+
+			seenGeneration = generation;
+			pCurTask			 = pTask;
+		}
+
+		work( aWorker, *pCurTask );
+
+		std::lock_guard<std::mutex> lock( mutex );
+
+		if( --busyThreads == 0 )
+		{
+			doneCondition.notify_one();
+		}
+	}
+}
+
+void cDZRCOBS_mt_pool::work( size_t aWorker, const tTask &aTask )
+{
+	size_t taskIndex = 0;
+
+	while( pop( aWorker, &taskIndex ) || steal( aWorker, &taskIndex ) )
+	{
+		aTask( taskIndex, aWorker );
+	}
+}
+
+bool cDZRCOBS_mt_pool::pop( size_t aWorker, size_t *aOutTask )
+{
+	sWorker &worker = workersState[aWorker];
+
+	std::lock_guard<std::mutex> lock( worker.mutex );
+
+	if( worker.next == worker.end )
+	{
+		return false;
+	}
+
+	*aOutTask = worker.next++;
+
+	return true;
+}
+
+bool cDZRCOBS_mt_pool::steal( size_t aWorker, size_t *aOutTask )
+{
+	const size_t workersCount = workers.size();
+
+	for( size_t i = 1; i < workersCount; i++ )
+	{
+		sWorker &victim = workersState[( aWorker + i ) % workersCount];
+
+		std::lock_guard<std::mutex> lock( victim.mutex );
+
+		if( victim.next != victim.end )
+		{
+			*aOutTask = --victim.end;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,9 @@
+#include <stdlib.h>
+#include <time.h>
+#include <CppUTest/CommandLineTestRunner.h>
+
+int main(int argc, char** argv)
+{
+	srand(time(NULL));
+  return RUN_ALL_TESTS(argc, argv);
+}
\ No newline at end of file
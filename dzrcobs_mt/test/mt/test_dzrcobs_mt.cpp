@@ -0,0 +1,427 @@
+// /////////////////////////////////////////////////////////////////////////////
+///	@file test_dzrcobs_mt.cpp
+///	@brief Tests for the multi-threaded batch encode and decode
+///
+///	@par  Plataform Target:	Tests
+/// @par  Tab Size: 2
+///
+/// @copyright (C) 2025 Mario Luzeiro All rights reserved.
+/// @author Mario Luzeiro <mluzeiro@ua.pt>
+///
+/// @par  License: Distributed under the 3-Clause BSD License. See accompanying
+/// file LICENSE or a copy at https://opensource.org/licenses/BSD-3-Clause
+/// SPDX-License-Identifier: BSD-3-Clause
+///
+// /////////////////////////////////////////////////////////////////////////////
+
+// Includes
+// /////////////////////////////////////////////////////////////////////////////
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/UtestMacros.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <dzrcobs/dzrcobs.h>
+#include <dzrcobs/dzrcobs_decode.h>
+#include <dzrcobs_mt/dzrcobs_mt.hpp>
+
+// Definitions
+// /////////////////////////////////////////////////////////////////////////////
+
+// Enough messages and bytes to be split on many tasks
+#define UTEST_MT_MESSAGES_COUNT ( 6000 )
+#define UTEST_MT_MAX_MESSAGE_SIZE ( 300 )
+
+static const size_t s_TEST_ThreadsCount[] = { 1, 2, 3, 8 };
+
+// Setup
+// /////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+// NOLINTBEGIN
+TEST_GROUP( DZRCOBS_MT ){
+	void setup()
+	{
+		CHECK_EQUAL( DICT_RET_SUCCESS,
+								 dzrcobs_dictionary_init( &dictCtx, G_DZRCOBS_DefaultDictionary, G_DZRCOBS_DefaultDictionary_size ) );
+
+		ctx.pDict[0] = nullptr;
+		ctx.pDict[1] = nullptr;
+		dzrcobs_encode_set_dictionary( &ctx, &dictCtx, DZRCOBS_USING_DICT_1 );
+
+		messages.assign( UTEST_MT_MESSAGES_COUNT, std::vector<uint8_t>() );
+		entries.resize( UTEST_MT_MESSAGES_COUNT );
+		maxBatchSize = 0;
+		decodedSize	 = 0;
+
+		for( size_t i = 0; i < UTEST_MT_MESSAGES_COUNT; i++ )
+		{
+			messages[i].resize( (size_t)rand() % UTEST_MT_MAX_MESSAGE_SIZE );
+
+			for( auto &byte : messages[i] )
+			{
+				byte = ( rand() % 3 ) ? (uint8_t)( 'a' + ( rand() % 26 ) ) : (uint8_t)rand();
+			}
+
+			entries[i].pSrc			 = messages[i].data();
+			entries[i].srcLen		 = messages[i].size();
+			entries[i].user6bits = (uint8_t)( ( i % 63 ) + 1 );
+
+			maxBatchSize += DZRCOBS_MAX_ENCODED_SIZE_DICTIONARY( messages[i].size() ) + DZRCOBS_FRAME_HEADER_SIZE + 1;
+			decodedSize += messages[i].size();
+		}
+	}
+
+	void teardown()
+	{
+	}
+
+	sDICT_ctx dictCtx;
+	sDZRCOBS_ctx ctx;
+	std::vector<std::vector<uint8_t>> messages;
+	std::vector<sDZRCOBS_batch_entry> entries;
+	size_t maxBatchSize;
+	size_t decodedSize;
+};
+// NOLINTEND
+// clang-format on
+
+// Tests
+// /////////////////////////////////////////////////////////////////////////////
+
+// NOLINTBEGIN
+TEST( DZRCOBS_MT, PoolRunsEachTaskOnce )
+// NOLINTEND
+{
+	for( size_t threadsCount : s_TEST_ThreadsCount )
+	{
+		cDZRCOBS_mt_pool pool( threadsCount );
+
+		CHECK_EQUAL( threadsCount, pool.threads_count() );
+
+		for( size_t tasksCount : { 0, 1, 7, 100, 1000 } )
+		{
+			std::vector<std::atomic<unsigned>> runs( tasksCount );
+			std::atomic<bool> isWorkerValid( true );
+
+			for( auto &run : runs )
+			{
+				run = 0;
+			}
+
+			pool.run( tasksCount, [&]( size_t aTask, size_t aWorker ) {
+				runs[aTask]++;
+
+				if( aWorker >= threadsCount )
+				{
+					isWorkerValid = false;
+				}
+			} );
+
+			CHECK_TRUE( isWorkerValid );
+
+			for( auto &run : runs )
+			{
+				CHECK_EQUAL( 1U, run.load() );
+			}
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_MT, EncodeBatchMatchesSingleThread )
+// NOLINTEND
+{
+	for( eDZRCOBS_encoding encoding : { DZRCOBS_PLAIN, DZRCOBS_USING_DICT_1 } )
+	{
+		std::vector<uint8_t> expected( maxBatchSize );
+		std::vector<size_t> expectedOffsets( UTEST_MT_MESSAGES_COUNT + 1 );
+		size_t expectedFrames = 0;
+
+		sDZRCOBS_ctx singleCtx = ctx;
+
+		CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+								 dzrcobs_encode_batch( &singleCtx,
+																			 encoding,
+																			 entries.data(),
+																			 entries.size(),
+																			 expected.data(),
+																			 expected.size(),
+																			 expectedOffsets.data(),
+																			 &expectedFrames ) );
+
+		for( size_t threadsCount : s_TEST_ThreadsCount )
+		{
+			cDZRCOBS_mt_pool pool( threadsCount );
+
+			std::vector<uint8_t> batch( maxBatchSize, 0xEE );
+			std::vector<size_t> offsets( UTEST_MT_MESSAGES_COUNT + 1 );
+			size_t framesEncoded = 0;
+
+			eDZRCOBS_ret ret = dzrcobs_mt_encode_batch(
+			 pool, &ctx, encoding, entries.data(), entries.size(), batch.data(), batch.size(), offsets.data(), &framesEncoded );
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS, ret );
+			CHECK_EQUAL( expectedFrames, framesEncoded );
+			CHECK_TRUE( expectedOffsets == offsets );
+			MEMCMP_EQUAL( expected.data(), batch.data(), offsets[UTEST_MT_MESSAGES_COUNT] );
+		}
+	}
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_MT, EncodeBatchOverflowAndBadEntry )
+// NOLINTEND
+{
+	std::vector<uint8_t> expected( maxBatchSize );
+	std::vector<size_t> expectedOffsets( UTEST_MT_MESSAGES_COUNT + 1 );
+	size_t expectedFrames = 0;
+
+	sDZRCOBS_ctx singleCtx = ctx;
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+							 dzrcobs_encode_batch( &singleCtx,
+																		 DZRCOBS_USING_DICT_1,
+																		 entries.data(),
+																		 entries.size(),
+																		 expected.data(),
+																		 expected.size(),
+																		 expectedOffsets.data(),
+																		 &expectedFrames ) );
+
+	cDZRCOBS_mt_pool pool( 4 );
+
+	// Half of the needed size, all the frames that fit are there
+	const size_t halfSize = expectedOffsets[UTEST_MT_MESSAGES_COUNT] / 2;
+
+	std::vector<uint8_t> batch( halfSize );
+	std::vector<size_t> offsets( UTEST_MT_MESSAGES_COUNT + 1 );
+	size_t framesEncoded = 0;
+
+	eDZRCOBS_ret ret = dzrcobs_mt_encode_batch( pool,
+																							&ctx,
+																							DZRCOBS_USING_DICT_1,
+																							entries.data(),
+																							entries.size(),
+																							batch.data(),
+																							batch.size(),
+																							offsets.data(),
+																							&framesEncoded );
+
+	CHECK_EQUAL( DZRCOBS_RET_ERR_OVERFLOW, ret );
+	CHECK_TRUE( offsets[framesEncoded] <= halfSize );
+	CHECK_TRUE( expectedOffsets[framesEncoded + 1] > halfSize );
+
+	for( size_t i = 0; i <= framesEncoded; i++ )
+	{
+		CHECK_EQUAL( expectedOffsets[i], offsets[i] );
+	}
+
+	MEMCMP_EQUAL( expected.data(), batch.data(), offsets[framesEncoded] );
+
+	// A bad entry stops the batch on it
+	const size_t badEntry = ( UTEST_MT_MESSAGES_COUNT * 2 ) / 3;
+
+	entries[badEntry].user6bits = 0;
+
+	batch.resize( maxBatchSize );
+
+	ret = dzrcobs_mt_encode_batch( pool,
+																 &ctx,
+																 DZRCOBS_USING_DICT_1,
+																 entries.data(),
+																 entries.size(),
+																 batch.data(),
+																 batch.size(),
+																 offsets.data(),
+																 &framesEncoded );
+
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG, ret );
+	CHECK_EQUAL( badEntry, framesEncoded );
+	CHECK_EQUAL( expectedOffsets[badEntry], offsets[badEntry] );
+	MEMCMP_EQUAL( expected.data(), batch.data(), offsets[badEntry] );
+
+	// Invalid arguments
+	sDZRCOBS_ctx noDictCtx;
+	noDictCtx.pDict[0] = nullptr;
+	noDictCtx.pDict[1] = nullptr;
+
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_mt_encode_batch( pool,
+																				&noDictCtx,
+																				DZRCOBS_USING_DICT_1,
+																				entries.data(),
+																				entries.size(),
+																				batch.data(),
+																				batch.size(),
+																				offsets.data(),
+																				&framesEncoded ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_mt_encode_batch( pool,
+																				nullptr,
+																				DZRCOBS_PLAIN,
+																				entries.data(),
+																				entries.size(),
+																				batch.data(),
+																				batch.size(),
+																				offsets.data(),
+																				&framesEncoded ) );
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_mt_encode_batch( pool,
+																				&ctx,
+																				DZRCOBS_RESERVED,
+																				entries.data(),
+																				entries.size(),
+																				batch.data(),
+																				batch.size(),
+																				offsets.data(),
+																				&framesEncoded ) );
+}
+
+// NOLINTBEGIN
+TEST( DZRCOBS_MT, DecodeBatchMatchesSingleThread )
+// NOLINTEND
+{
+	std::vector<uint8_t> batch( maxBatchSize );
+	std::vector<size_t> offsets( UTEST_MT_MESSAGES_COUNT + 1 );
+	size_t framesEncoded = 0;
+
+	sDZRCOBS_ctx singleCtx = ctx;
+
+	CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+							 dzrcobs_encode_batch( &singleCtx,
+																		 DZRCOBS_USING_DICT_1,
+																		 entries.data(),
+																		 entries.size(),
+																		 batch.data(),
+																		 batch.size(),
+																		 offsets.data(),
+																		 &framesEncoded ) );
+
+	// Stream: empty frames, a corrupted frame, and a frame not complete at the end
+	std::vector<uint8_t> stream = { 0x00, 0x00 };
+
+	stream.insert( stream.end(), batch.begin(), batch.begin() + (std::ptrdiff_t)offsets[UTEST_MT_MESSAGES_COUNT] );
+	stream.insert( stream.end(), { 0x00, 0x00 } );
+
+	const size_t corruptedFrame = UTEST_MT_MESSAGES_COUNT / 2;
+
+	uint8_t &corruptedByte = stream[2 + offsets[corruptedFrame]];
+	corruptedByte ^= ( corruptedByte == 0x20 ) ? 0x01 : 0x20; // not a delimiter
+
+	const size_t completeSize = stream.size();
+
+	stream.insert( stream.end(), batch.begin(), batch.begin() + (std::ptrdiff_t)( offsets[1] - 1 ) );
+
+	sDZRCOBS_decodectx decodeCtx;
+	decodeCtx.srcBufEncoded		 = stream.data();
+	decodeCtx.srcBufEncodedLen = stream.size();
+	decodeCtx.pDict[0]				 = &dictCtx;
+	decodeCtx.pDict[1]				 = nullptr;
+
+	// All the results, exactly the frames, and less than the frames
+	for( size_t resultsSize : { UTEST_MT_MESSAGES_COUNT + 10, UTEST_MT_MESSAGES_COUNT, UTEST_MT_MESSAGES_COUNT / 3 } )
+	{
+		std::vector<uint8_t> expectedArena( decodedSize );
+		std::vector<sDZRCOBS_batch_result> expectedResults( resultsSize );
+		size_t expectedCount		= 0;
+		size_t expectedConsumed = 0;
+
+		decodeCtx.dstBufDecoded			= expectedArena.data();
+		decodeCtx.dstBufDecodedSize = expectedArena.size();
+
+		CHECK_EQUAL(
+		 DZRCOBS_RET_SUCCESS,
+		 dzrcobs_decode_batch( &decodeCtx, expectedResults.data(), resultsSize, &expectedCount, &expectedConsumed ) );
+
+		if( resultsSize > UTEST_MT_MESSAGES_COUNT )
+		{
+			CHECK_EQUAL( completeSize, expectedConsumed );
+		}
+
+		for( size_t threadsCount : s_TEST_ThreadsCount )
+		{
+			cDZRCOBS_mt_pool pool( threadsCount );
+
+			std::vector<uint8_t> arena( decodedSize );
+			std::vector<sDZRCOBS_batch_result> results( resultsSize );
+			size_t resultsCount = 0;
+			size_t consumed			= 0;
+
+			decodeCtx.dstBufDecoded			= arena.data();
+			decodeCtx.dstBufDecodedSize = arena.size();
+
+			CHECK_EQUAL( DZRCOBS_RET_SUCCESS,
+									 dzrcobs_mt_decode_batch( pool, &decodeCtx, results.data(), resultsSize, &resultsCount, &consumed ) );
+
+			CHECK_EQUAL( expectedCount, resultsCount );
+			CHECK_EQUAL( expectedConsumed, consumed );
+
+			for( size_t i = 0; i < resultsCount; i++ )
+			{
+				CHECK_EQUAL( expectedResults[i].status, results[i].status );
+				CHECK_EQUAL( expectedResults[i].length, results[i].length );
+				CHECK_EQUAL( expectedResults[i].user6bits, results[i].user6bits );
+
+				// The corrupted frame leaves a gap on the arena, the frames before it are the same
+				if( i <= corruptedFrame )
+				{
+					CHECK_EQUAL( expectedResults[i].offset, results[i].offset );
+				}
+
+				if( results[i].length > 0 )
+				{
+					MEMCMP_EQUAL(
+					 expectedArena.data() + expectedResults[i].offset, arena.data() + results[i].offset, results[i].length );
+				}
+			}
+		}
+	}
+
+	// Arena too small, the frames that decode are still right
+	cDZRCOBS_mt_pool pool( 4 );
+
+	std::vector<uint8_t> arena( decodedSize / 2 );
+	std::vector<sDZRCOBS_batch_result> results( UTEST_MT_MESSAGES_COUNT );
+	size_t resultsCount = 0;
+	size_t consumed			= 0;
+
+	decodeCtx.dstBufDecoded			= arena.data();
+	decodeCtx.dstBufDecodedSize = arena.size();
+
+	CHECK_EQUAL(
+	 DZRCOBS_RET_SUCCESS,
+	 dzrcobs_mt_decode_batch( pool, &decodeCtx, results.data(), results.size(), &resultsCount, &consumed ) );
+	CHECK_EQUAL( UTEST_MT_MESSAGES_COUNT, resultsCount );
+
+	size_t overflowCount = 0;
+
+	for( size_t i = 0; i < resultsCount; i++ )
+	{
+		if( results[i].status == DZRCOBS_RET_ERR_OVERFLOW )
+		{
+			overflowCount++;
+		}
+		else if( results[i].status == DZRCOBS_RET_SUCCESS )
+		{
+			CHECK_EQUAL( messages[i].size(), results[i].length );
+			CHECK_TRUE( results[i].offset + results[i].length <= arena.size() );
+
+			if( results[i].length > 0 )
+			{
+				MEMCMP_EQUAL( messages[i].data(), arena.data() + results[i].offset, results[i].length );
+			}
+		}
+	}
+
+	CHECK_TRUE( overflowCount > 0 );
+
+	CHECK_EQUAL( DZRCOBS_RET_ERR_BAD_ARG,
+							 dzrcobs_mt_decode_batch( pool, nullptr, results.data(), results.size(), &resultsCount, &consumed ) );
+}
+
+// EOF
+// /////////////////////////////////////////////////////////////////////////////